@@ -0,0 +1,127 @@
+// Route quality of the anytime (ARA*) search against its time budget.
+//
+// For each generated map and budget, a fresh search gets one improve call
+// of that many milliseconds (0 = run to the optimum):
+//   ratio      - route length over the A* optimum (1 is optimal)
+//   bound      - the search's own suboptimality bound for that route
+//   epsilon    - heuristic weight of the round it stopped in
+// A second table follows one search through successive 1 ms calls, the way
+// the planner refines its route once per control cycle, with a row for each
+// cycle that shortened the route.
+//
+// Usage: anytime_bench [max_map_size] [obstacle_percent]
+
+#include "../src/anytime_search.h"
+#include "../src/grid_search.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Fill a grid with random obstacles, keeping the corners free
+static void generateMap(OccupancyGrid& grid, int obstaclePercent, uint64_t seed) {
+    BenchRandom random(seed);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (random.nextInt(100) < obstaclePercent) {
+                grid.markObstacle(x, y);
+            }
+        }
+    }
+    grid.clearObstacle(0, 0);
+    grid.clearObstacle(width - 1, height - 1);
+}
+
+// Run one budgeted search corner to corner and print its row
+static void runBudget(const OccupancyGrid& grid, double budgetMs, int optimum) {
+    AnytimeSearch search(grid, MOVES_ALL);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+
+    // Warm up so the per-cell state is already allocated
+    search.start(0, 0, width - 1, height - 1);
+    search.improve(0.0);
+
+    search.start(0, 0, width - 1, height - 1);
+    BenchTimer timer;
+    bool found = search.improve(budgetMs / 1e3);
+    double seconds = timer.elapsedSeconds();
+
+    char budget[16];
+    if (budgetMs > 0.0) {
+        std::snprintf(budget, sizeof(budget), "%.2f", budgetMs);
+    } else {
+        std::snprintf(budget, sizeof(budget), "%s", "optimal");
+    }
+    if (found) {
+        std::printf("%5dx%-5d %10s %10d %8.4f %8.3f %8.2f %12lld %10.3f\n", width, height, budget,
+                    search.getPathLength(), static_cast<double>(search.getPathLength()) / optimum,
+                    search.getSuboptimalityBound(), search.getEpsilon(), search.getExpansions(), seconds * 1e3);
+    } else {
+        std::printf("%5dx%-5d %10s %10s %8s %8s %8.2f %12lld %10.3f\n", width, height, budget, "-", "-", "-",
+                    search.getEpsilon(), search.getExpansions(), seconds * 1e3);
+    }
+}
+
+// Follow one search through successive short improve calls
+static void runRefinement(const OccupancyGrid& grid, double cycleMs, int optimum) {
+    AnytimeSearch search(grid, MOVES_ALL);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    search.start(0, 0, width - 1, height - 1);
+
+    std::printf("\n%dx%d refined in %.1f ms cycles (optimum %d)\n", width, height, cycleMs, optimum);
+    std::printf("%6s %10s %8s %8s %8s %12s\n", "cycle", "length", "ratio", "bound", "epsilon", "expansions");
+    int lastLength = -1;
+    for (int cycle = 1; cycle <= 100000 && !search.isComplete(); cycle++) {
+        // Only cycles that shortened the route get a row
+        if (search.improve(cycleMs / 1e3) && search.getPathLength() != lastLength) {
+            lastLength = search.getPathLength();
+            std::printf("%6d %10d %8.4f %8.3f %8.2f %12lld\n", cycle, lastLength,
+                        static_cast<double>(lastLength) / optimum, search.getSuboptimalityBound(),
+                        search.getEpsilon(), search.getExpansions());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 2048;
+    int obstaclePercent = (argc > 2) ? std::atoi(argv[2]) : 20;
+    const int sizes[] = {256, 512, 1024, 2048, 4096};
+    const double budgetsMs[] = {0.05, 0.2, 1.0, 5.0, 25.0, 0.0};
+
+    std::printf("%11s %10s %10s %8s %8s %8s %12s %10s\n", "map", "budget ms", "length", "ratio", "bound", "epsilon",
+                "expansions", "search ms");
+
+    int largest = 0;
+    for (int size : sizes) {
+        if (size > maxSize) {
+            break;
+        }
+        largest = size;
+
+        OccupancyGrid grid(size, size);
+        generateMap(grid, obstaclePercent, static_cast<uint64_t>(size));
+        GridSearch optimal(grid, MOVES_ALL, SEARCH_ASTAR);
+        if (!optimal.findPath(0, 0, size - 1, size - 1)) {
+            std::printf("%5dx%-5d no route\n", size, size);
+            continue;
+        }
+
+        for (double budgetMs : budgetsMs) {
+            runBudget(grid, budgetMs, optimal.getPathLength());
+        }
+    }
+
+    if (largest > 0) {
+        OccupancyGrid grid(largest, largest);
+        generateMap(grid, obstaclePercent, static_cast<uint64_t>(largest));
+        GridSearch optimal(grid, MOVES_ALL, SEARCH_ASTAR);
+        if (optimal.findPath(0, 0, largest - 1, largest - 1)) {
+            runRefinement(grid, 1.0, optimal.getPathLength());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Many start/destination queries against one shared, preprocessed map.
+//
+// The baseline answers each query the way a fresh RobotPathPlanner would:
+// copy the obstacles and search from scratch. The batch API shares one
+// SharedMap, rejects impossible pairs with the component labels and builds
+// one distance field per popular destination, then spreads the queries over
+// a thread pool. Every batch result is checked against the baseline.
+//
+// Usage: batch_query_bench [size] [queries] [destinations] [max_threads]
+
+#include "../src/batch_query.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Answer one query on a private copy of the map
+static int privateCopyQuery(const OccupancyGrid& source, const PathQuery& request) {
+    OccupancyGrid copy(source);
+    GridSearch search(copy, MOVES_NORTH_EAST, SEARCH_JUMP_POINT);
+    if (!search.findPath(request.startX, request.startY, request.destX, request.destY)) {
+        return -1;
+    }
+    return search.getPathLength();
+}
+
+// Count results that disagree with the baseline distances
+static int countMismatches(const std::vector<QueryResult>& results, const std::vector<int>& expected) {
+    int mismatches = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].distance != expected[i]) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 512;
+    int queryCount = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    int destinationCount = (argc > 3) ? std::atoi(argv[3]) : 20;
+    int maxThreads = (argc > 4) ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (size < 4 || queryCount < 1 || destinationCount < 1) {
+        std::fprintf(stderr, "usage: batch_query_bench [size] [queries] [destinations] [max_threads]\n");
+        return 1;
+    }
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    // 10% random obstacles
+    BenchRandom random(77);
+    OccupancyGrid grid(size, size);
+    for (long long i = 0; i < static_cast<long long>(size) * size / 10; i++) {
+        grid.markObstacle(random.nextInt(size), random.nextInt(size));
+    }
+
+    // Destinations in the upper right quarter, starts in the lower left (the drivetrain moves NORTH and EAST)
+    std::vector<GridCell> destinations;
+    for (int i = 0; i < destinationCount; i++) {
+        GridCell cell = {size / 2 + random.nextInt(size - size / 2), size / 2 + random.nextInt(size - size / 2)};
+        grid.clearObstacle(cell.x, cell.y);
+        destinations.push_back(cell);
+    }
+    std::vector<PathQuery> queries;
+    for (int i = 0; i < queryCount; i++) {
+        const GridCell& dest = destinations[random.nextInt(destinationCount)];
+        PathQuery request = {random.nextInt(size / 2), random.nextInt(size / 2), dest.x, dest.y};
+        queries.push_back(request);
+    }
+
+    std::printf("%d x %d map, %d queries to %d destinations\n\n", size, size, queryCount, destinationCount);
+
+    BenchTimer baselineTimer;
+    std::vector<int> expected;
+    for (const PathQuery& request : queries) {
+        expected.push_back(privateCopyQuery(grid, request));
+    }
+    double baselineMs = baselineTimer.elapsedSeconds() * 1e3;
+
+    BenchTimer prepareTimer;
+    SharedMap shared(grid, MOVES_NORTH_EAST);
+    double prepareMs = prepareTimer.elapsedSeconds() * 1e3;
+
+    std::printf("private copy + search:  %10.1f ms (1 thread)\n", baselineMs);
+    std::printf("shared map preprocess:  %10.1f ms (%d components, %.1f MB)\n\n", prepareMs,
+                shared.getComponentCount(), shared.getMemoryBytes() / 1048576.0);
+    std::printf("%-8s %-8s %12s %12s %8s %8s %8s %10s\n", "threads", "fields", "batch ms", "queries/s",
+                "speedup", "fields", "searches", "mismatch");
+
+    for (int useFields = 0; useFields <= 1; useFields++) {
+        double singleMs = 0.0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            ThreadPool pool(threads);
+            BatchQueryStats stats;
+            BenchTimer timer;
+            std::vector<QueryResult> results = runBatchQueries(shared, queries, pool, useFields ? 3 : queryCount + 1,
+                                                               &stats);
+            double batchMs = timer.elapsedSeconds() * 1e3;
+            if (threads == 1) {
+                singleMs = batchMs;
+            }
+
+            std::printf("%-8d %-8s %12.1f %12.0f %7.2fx %8d %8d %10d\n", threads, useFields ? "yes" : "no",
+                        batchMs, queryCount / (batchMs / 1e3), singleMs / batchMs, stats.fieldsBuilt,
+                        stats.searches, countMismatches(results, expected));
+            if (threads < maxThreads && threads * 2 > maxThreads) {
+                threads = maxThreads / 2;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdint>
+
+// Monotonic stopwatch used by the benchmarks
+class BenchTimer {
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    // Constructor (starts the timer)
+    BenchTimer() : start(std::chrono::steady_clock::now()) {}
+
+    // Restart the timer
+    void reset() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    // Get the elapsed time in seconds
+    double elapsedSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Get the elapsed time in nanoseconds
+    double elapsedNanoseconds() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Keep the optimizer from discarding a benchmark result
+template <typename T>
+inline void benchKeep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Small xorshift generator so benchmark inputs are reproducible
+class BenchRandom {
+private:
+    uint64_t state;
+
+public:
+    // Constructor
+    explicit BenchRandom(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    // Get the next raw 64-bit value
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Get a value in [0, bound)
+    int nextInt(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+};
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,117 @@
+// Checkpoint write latency and restore time on large maps.
+//
+// For each WIDTH x WIDTH map (5% obstacles) a planner writes checkpoints
+// with and without fsync, then a fresh planner restores the newest one:
+//   write (no sync)  - average of several writes, page cache only
+//   write (fsync)    - average of several writes flushed to disk
+//   restore          - readCheckpoint, checksums and planner state rebuild
+// A greedy mission is also run with a checkpoint every few moves to show
+// the overhead on planning. Files are written to the system temp directory
+// and removed afterwards.
+//
+// Usage: checkpoint_bench [max_width] [writes]
+
+#include "../src/checkpoint.h"
+#include "../src/logger.h"
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// Remove both slot files of a base path
+static void removeSlots(const std::string& basePath) {
+    std::remove(getCheckpointSlotPath(basePath, 0).c_str());
+    std::remove(getCheckpointSlotPath(basePath, 1).c_str());
+}
+
+// Time writes and a restore on one map size
+static void benchMapSize(int width, int writes, const std::string& basePath) {
+    removeSlots(basePath);
+    std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, width - 1, width - 1, width, width));
+    BenchRandom random(99);
+    long long cells = static_cast<long long>(width) * width;
+    for (long long i = 0; i < cells / 20; i++) {
+        planner->markObstacle(1 + random.nextInt(width - 2), 1 + random.nextInt(width - 2));
+    }
+    planner->initialize();
+
+    std::string error;
+    double seconds[2] = {0.0, 0.0};
+    long long bytes = 0;
+    for (int sync = 0; sync < 2; sync++) {
+        CheckpointWriter writer(basePath, sync == 1);
+        planner->setCheckpointWriter(&writer, 0);
+        for (int i = 0; i < writes; i++) {
+            if (!planner->writeCheckpoint(error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return;
+            }
+        }
+        seconds[sync] = writer.getTotalWriteSeconds() / writes;
+        bytes = writer.getLastWriteBytes();
+        planner->setCheckpointWriter(nullptr, 0);
+    }
+
+    std::unique_ptr<RobotPathPlanner> restored(new RobotPathPlanner(0, 0, width - 1, width - 1, width, width));
+    BenchTimer restoreTimer;
+    bool ok = restored->restoreCheckpoint(basePath, error);
+    double restoreSeconds = restoreTimer.elapsedSeconds();
+    if (!ok) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return;
+    }
+
+    std::printf("%8d %12.2f %16.3f %16.3f %12.3f\n", width, bytes / 1048576.0, seconds[0] * 1e3, seconds[1] * 1e3,
+                restoreSeconds * 1e3);
+    removeSlots(basePath);
+}
+
+// Run a greedy mission with a checkpoint every interval moves (0 for none); returns seconds
+static double runMission(int width, int interval, const std::string& basePath, long long& written) {
+    removeSlots(basePath);
+    RobotPathPlanner planner(0, 0, width - 1, width - 1, width, width);
+    BenchRandom random(7);
+    for (int i = 0; i < width * width / 50; i++) {
+        planner.markObstacle(1 + random.nextInt(width - 2), 1 + random.nextInt(width - 2));
+    }
+    CheckpointWriter writer(basePath, false);
+    if (interval > 0) {
+        planner.setCheckpointWriter(&writer, interval);
+    }
+
+    BenchTimer timer;
+    planner.initialize();
+    planner.executePlanningAlgorithm();
+    double seconds = timer.elapsedSeconds();
+    written = writer.getWriteCount();
+    removeSlots(basePath);
+    return seconds;
+}
+
+int main(int argc, char** argv) {
+    int maxWidth = (argc > 1) ? std::atoi(argv[1]) : 8192;
+    int writes = (argc > 2) ? std::atoi(argv[2]) : 10;
+    if (writes < 1) {
+        writes = 1;
+    }
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    std::string basePath = "/tmp/checkpoint_bench";
+
+    std::printf("%8s %12s %16s %16s %12s\n", "width", "MB", "write ms", "write+fsync ms", "restore ms");
+    for (int width = 1024; width <= maxWidth; width *= 2) {
+        benchMapSize(width, writes, basePath);
+    }
+
+    std::printf("\ngreedy mission on a 512 x 512 map\n");
+    std::printf("%12s %12s %12s\n", "interval", "checkpoints", "mission ms");
+    const int intervals[] = {0, 100, 10, 1};
+    for (int interval : intervals) {
+        long long written = 0;
+        double seconds = runMission(512, interval, basePath, written);
+        std::printf("%12d %12lld %12.2f\n", interval, written, seconds * 1e3);
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Build, update and query cost of ClearanceMap.
+//
+// Full builds are timed with 1, 2 and 4 pool threads on random maps, then
+// single obstacle insertions are timed incrementally and compared with a
+// full rebuild, and finally clearance queries against a naive scan of the
+// neighbourhood for the nearest obstacle.
+//
+// Usage: clearance_map_bench [max_map_size] [obstacle_percent]
+
+#include "../src/clearance_map.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Fill a grid with random obstacles
+static void generateMap(OccupancyGrid& grid, int obstaclePercent, uint64_t seed) {
+    BenchRandom random(seed);
+    for (int y = 0; y < grid.getHeight(); y++) {
+        for (int x = 0; x < grid.getWidth(); x++) {
+            if (random.nextInt(100) < obstaclePercent) {
+                grid.markObstacle(x, y);
+            }
+        }
+    }
+}
+
+// Nearest obstacle by scanning growing squares around the cell (what a planner does without the map)
+static int scanDistanceSquared(const OccupancyGrid& grid, int x, int y) {
+    int best = -1;
+    for (int radius = 0; ; radius++) {
+        for (int dy = -radius; dy <= radius; dy++) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                if (dx != -radius && dx != radius && dy != -radius && dy != radius) {
+                    continue;
+                }
+                if (grid.isObstacleDetected(x + dx, y + dy)) {
+                    int d = dx * dx + dy * dy;
+                    if (best < 0 || d < best) {
+                        best = d;
+                    }
+                }
+            }
+        }
+        // Nothing outside the square can beat a hit at this radius
+        if (best >= 0 && best <= (radius + 1) * (radius + 1)) {
+            return best;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    int obstaclePercent = (argc > 2) ? std::atoi(argv[2]) : 1;
+
+    ThreadPool pool2(2);
+    ThreadPool pool4(4);
+
+    std::printf("full build (ms)\n");
+    std::printf("%10s %12s %12s %12s\n", "map", "1 thread", "2 threads", "4 threads");
+    for (int size = 256; size <= maxSize; size *= 2) {
+        OccupancyGrid grid(size, size);
+        generateMap(grid, obstaclePercent, 7);
+        ClearanceMap clearance(grid);
+
+        BenchTimer timer;
+        clearance.rebuild();
+        double single = timer.elapsedSeconds() * 1e3;
+        timer.reset();
+        clearance.rebuild(&pool2);
+        double two = timer.elapsedSeconds() * 1e3;
+        timer.reset();
+        clearance.rebuild(&pool4);
+        double four = timer.elapsedSeconds() * 1e3;
+
+        std::printf("%10d %12.2f %12.2f %12.2f\n", size, single, two, four);
+    }
+
+    std::printf("\nmarkObstacle update (us)\n");
+    std::printf("%10s %14s %14s %14s\n", "map", "incremental", "cells/update", "full rebuild");
+    for (int size = 256; size <= maxSize; size *= 2) {
+        OccupancyGrid grid(size, size);
+        generateMap(grid, obstaclePercent, 11);
+        ClearanceMap clearance(grid);
+
+        BenchRandom random(5);
+        const int updates = 1000;
+        long long cells = 0;
+        BenchTimer timer;
+        for (int i = 0; i < updates; i++) {
+            int x = random.nextInt(size);
+            int y = random.nextInt(size);
+            grid.markObstacle(x, y);
+            cells += clearance.notifyObstacleAdded(x, y);
+        }
+        double incremental = timer.elapsedNanoseconds() / 1e3 / updates;
+
+        timer.reset();
+        clearance.rebuild();
+        double rebuild = timer.elapsedNanoseconds() / 1e3;
+
+        std::printf("%10d %14.2f %14.1f %14.1f\n", size, incremental,
+                    static_cast<double>(cells) / updates, rebuild);
+    }
+
+    std::printf("\nclearance query (ns)\n");
+    std::printf("%10s %14s %14s\n", "map", "map lookup", "square scan");
+    for (int size = 256; size <= maxSize; size *= 2) {
+        OccupancyGrid grid(size, size);
+        generateMap(grid, obstaclePercent, 13);
+        ClearanceMap clearance(grid);
+
+        const int queries = 100000;
+        BenchRandom random(3);
+        long long sum = 0;
+        BenchTimer timer;
+        for (int i = 0; i < queries; i++) {
+            sum += clearance.getDistanceSquared(random.nextInt(size), random.nextInt(size));
+        }
+        double lookup = timer.elapsedNanoseconds() / queries;
+
+        BenchRandom scanRandom(3);
+        long long scanSum = 0;
+        timer.reset();
+        for (int i = 0; i < queries; i++) {
+            scanSum += scanDistanceSquared(grid, scanRandom.nextInt(size), scanRandom.nextInt(size));
+        }
+        double scan = timer.elapsedNanoseconds() / queries;
+
+        benchKeep(sum);
+        std::printf("%10d %14.2f %14.2f%s\n", size, lookup, scan, (sum == scanSum) ? "" : "  (mismatch)");
+    }
+
+    return 0;
+}
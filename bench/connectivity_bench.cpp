@@ -0,0 +1,71 @@
+// Connectivity index: full labelling against incremental wall updates.
+//
+// For each map size the table shows the time of a full union-find build,
+// the average cost of folding in one new obstacle (including the split
+// checks), the time of a reachability query, and the time a greedy mission
+// towards a walled-off destination takes to fail without any step limit
+// (mostly the first labelling).
+//
+// Usage: connectivity_bench [max_size]
+
+#include "../src/connectivity_index.h"
+#include "../src/logger.h"
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Time one greedy mission towards a walled-off destination
+static double timeUnreachableMission(int size) {
+    RobotPathPlanner planner(0, 0, size - 1, size - 1, size, size);
+    planner.markObstacle(size - 2, size - 1);
+    planner.markObstacle(size - 1, size - 2);
+    planner.initialize();
+
+    BenchTimer timer;
+    benchKeep(planner.executePlanningAlgorithm());
+    return timer.elapsedSeconds() * 1e3;
+}
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 2048;
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    std::printf("%8s %12s %14s %12s %14s\n", "size", "build ms", "update us", "query ns", "fail-fast ms");
+    for (int size = 256; size <= maxSize; size *= 2) {
+        BenchRandom random(static_cast<uint64_t>(size));
+        OccupancyGrid grid(size, size);
+        for (long long i = 0; i < static_cast<long long>(size) * size / 10; i++) {
+            grid.markObstacle(random.nextInt(size), random.nextInt(size));
+        }
+
+        BenchTimer buildTimer;
+        ConnectivityIndex index(grid);
+        double buildMs = buildTimer.elapsedSeconds() * 1e3;
+
+        // New walls arrive one at a time, as sensor observations would
+        const int updates = 2000;
+        BenchTimer updateTimer;
+        for (int i = 0; i < updates; i++) {
+            int x = random.nextInt(size);
+            int y = random.nextInt(size);
+            grid.markObstacle(x, y);
+            index.notifyObstacleAdded(x, y);
+        }
+        double updateUs = updateTimer.elapsedSeconds() * 1e6 / updates;
+
+        const int queries = 1000000;
+        int connected = 0;
+        BenchTimer queryTimer;
+        for (int i = 0; i < queries; i++) {
+            connected += index.isConnected(random.nextInt(size), random.nextInt(size), size - 1, size - 1) ? 1 : 0;
+        }
+        double queryNs = queryTimer.elapsedNanoseconds() / queries;
+        benchKeep(connected);
+
+        double failFastMs = timeUnreachableMission(size);
+        std::printf("%8d %12.2f %14.3f %12.1f %14.3f\n", size, buildMs, updateUs, queryNs, failFastMs);
+    }
+
+    return 0;
+}
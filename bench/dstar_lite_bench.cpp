@@ -0,0 +1,104 @@
+// Work done by D* Lite repairs against replanning from scratch with A*.
+//
+// The robot drives corner to corner; every few steps an obstacle appears on
+// the cell it is about to enter. Each repair reports how many nodes it
+// expanded and updated, which should follow the size of the change rather
+// than the map area.
+//
+// Usage: dstar_lite_bench [max_map_size] [obstacle_percent]
+
+#include "../src/dstar_lite.h"
+#include "../src/grid_search.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 2048;
+    int obstaclePercent = (argc > 2) ? std::atoi(argv[2]) : 10;
+    const int sizes[] = {128, 256, 512, 1024, 2048, 4096};
+    const int discoveryInterval = 8;
+
+    std::printf("%11s %10s %12s %12s %12s %12s %12s %12s\n",
+                "map", "repairs", "init exp", "repair exp", "repair upd",
+                "astar exp", "repair us", "astar us");
+
+    for (int size : sizes) {
+        if (size > maxSize) {
+            break;
+        }
+
+        // Random field with free corners
+        OccupancyGrid grid(size, size);
+        BenchRandom random(static_cast<uint64_t>(size) * 7919);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                if (random.nextInt(100) < obstaclePercent) {
+                    grid.markObstacle(x, y);
+                }
+            }
+        }
+        grid.clearObstacle(0, 0);
+        grid.clearObstacle(size - 1, size - 1);
+
+        DStarLite dstar(grid, MOVES_ALL);
+        GridSearch astar(grid, MOVES_ALL, SEARCH_ASTAR);
+        if (!dstar.initialize(0, 0, size - 1, size - 1)) {
+            std::printf("%5dx%-5d unreachable\n", size, size);
+            continue;
+        }
+        long long initialExpanded = dstar.getLastRepairStats().expanded;
+
+        int x = 0;
+        int y = 0;
+        int steps = 0;
+        int repairs = 0;
+        long long repairExpanded = 0;
+        long long repairUpdated = 0;
+        long long astarExpanded = 0;
+        double repairSeconds = 0.0;
+        double astarSeconds = 0.0;
+
+        while (x != size - 1 || y != size - 1) {
+            int nextX = x;
+            int nextY = y;
+            if (!dstar.getNextStep(nextX, nextY)) {
+                break;
+            }
+
+            // Periodically discover an obstacle on the next cell
+            steps++;
+            bool isGoal = (nextX == size - 1 && nextY == size - 1);
+            if (steps % discoveryInterval == 0 && !isGoal) {
+                grid.markObstacle(nextX, nextY);
+                dstar.notifyCellChanged(nextX, nextY);
+
+                BenchTimer repairTimer;
+                dstar.repair();
+                repairSeconds += repairTimer.elapsedSeconds();
+                repairExpanded += dstar.getLastRepairStats().expanded;
+                repairUpdated += dstar.getLastRepairStats().updated;
+
+                BenchTimer astarTimer;
+                astar.findPath(x, y, size - 1, size - 1);
+                astarSeconds += astarTimer.elapsedSeconds();
+                astarExpanded += astar.getExpansions();
+
+                repairs++;
+                continue;
+            }
+
+            x = nextX;
+            y = nextY;
+            dstar.moveStart(x, y);
+        }
+
+        double count = repairs > 0 ? static_cast<double>(repairs) : 1.0;
+        std::printf("%5dx%-5d %10d %12lld %12.1f %12.1f %12.1f %12.2f %12.2f\n",
+                    size, size, repairs, initialExpanded,
+                    repairExpanded / count, repairUpdated / count, astarExpanded / count,
+                    repairSeconds * 1e6 / count, astarSeconds * 1e6 / count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+// FixedPathList<Capacity> against the pointer-based DoublyLinkedList.
+//
+// Runs the planning-loop insert/compact workload on both containers at a
+// few capacities, then the whole greedy planner on the demo map with each
+// path list. A constexpr run of the same workload is checked at compile time.
+//
+// Usage: fixed_path_list_bench [operations]
+
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Planning-loop workload; returns the final list size
+template <typename PathList>
+static constexpr int runSteps(PathList& list, long long operations) {
+    int x = 0;
+    int y = 0;
+
+    list.insert(x, y, START_LOCATION);
+    for (long long i = 0; i < operations; i++) {
+        bool turning = (i % 7) == 6;
+        if (turning) {
+            y++;
+        } else {
+            x++;
+        }
+
+        typename PathList::NodeHandle previous = list.findLatestNecessaryNode();
+        list.insert(x, y, turning ? TURNING_NODE : REGULAR);
+
+        // Turning trigger
+        if (turning && previous != list.getTail()) {
+            list.removeRegularNodesBetweenNecessary(list.getTail(), previous);
+        }
+
+        // Capacity trigger; start over once only necessary nodes are left
+        if (list.isFull()) {
+            list.removeRegularNodes();
+            if (list.isFull()) {
+                list.clear();
+                list.insert(x, y, START_LOCATION);
+            }
+        }
+    }
+    return list.getSize();
+}
+
+// The fixed list is usable in constant expressions
+constexpr int constexprSteps() {
+    FixedPathList<10> list;
+    return runSteps(list, 100);
+}
+static_assert(constexprSteps() > 0, "FixedPathList workload must run at compile time");
+
+// Time the workload and return nanoseconds per insert
+template <typename PathList>
+static double timeSteps(PathList& list, long long operations) {
+    BenchTimer timer;
+    benchKeep(runSteps(list, operations));
+    return timer.elapsedNanoseconds() / static_cast<double>(operations);
+}
+
+// Time one planner type over repeated greedy runs of the demo map
+template <typename Planner>
+static double timePlanner(int runs) {
+    BenchTimer timer;
+    for (int i = 0; i < runs; i++) {
+        Planner planner(0, 0, 18, 18, 20, 20);
+        planner.markObstacle(5, 5);
+        planner.markObstacle(10, 10);
+        planner.markObstacle(15, 5);
+        planner.markObstacle(10, 15);
+        planner.initialize();
+        planner.executePlanningAlgorithm();
+        benchKeep(planner.getPath().getSize());
+    }
+    return timer.elapsedNanoseconds() / 1000.0 / runs;
+}
+
+// Compare both containers at one capacity
+template <int Capacity>
+static void compareAt(long long operations) {
+    DoublyLinkedList pointerList(Capacity);
+    double pointerNs = timeSteps(pointerList, operations);
+
+    FixedPathList<Capacity> fixedList;
+    double fixedNs = timeSteps(fixedList, operations);
+
+    std::printf("%10d %14.2f %14.2f %14zu\n", Capacity, pointerNs, fixedNs, sizeof(fixedList));
+}
+
+int main(int argc, char** argv) {
+    long long operations = (argc > 1) ? std::atoll(argv[1]) : 5000000;
+
+    std::printf("%10s %14s %14s %14s\n", "capacity", "pointer ns/op", "fixed ns/op", "fixed bytes");
+    compareAt<10>(operations);
+    compareAt<64>(operations);
+    compareAt<1024>(operations);
+
+    // Whole planner with output disabled
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    const int runs = 20000;
+    double pointerUs = timePlanner<RobotPathPlanner>(runs);
+    double fixedUs = timePlanner<FixedRobotPathPlanner>(runs);
+    std::printf("\ngreedy planner, demo map: pointer %.2f us/run, fixed %.2f us/run\n",
+                pointerUs, fixedUs);
+
+    return 0;
+}
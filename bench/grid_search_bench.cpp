@@ -0,0 +1,67 @@
+// Expansions/sec and time-to-plan of A* and Jump Point Search on generated
+// maps from 100x100 up to 4096x4096.
+//
+// Usage: grid_search_bench [max_map_size] [obstacle_percent]
+
+#include "../src/grid_search.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Fill a grid with random obstacles, keeping the corners free
+static void generateMap(OccupancyGrid& grid, int obstaclePercent, uint64_t seed) {
+    BenchRandom random(seed);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (random.nextInt(100) < obstaclePercent) {
+                grid.markObstacle(x, y);
+            }
+        }
+    }
+    grid.clearObstacle(0, 0);
+    grid.clearObstacle(width - 1, height - 1);
+}
+
+// Plan corner to corner and print one result row
+static void runSearch(const char* name, const OccupancyGrid& grid, SearchMode mode) {
+    GridSearch search(grid, MOVES_ALL, mode);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+
+    // Warm up so the per-cell state is already allocated
+    search.findPath(0, 0, width - 1, height - 1);
+
+    BenchTimer timer;
+    bool found = search.findPath(0, 0, width - 1, height - 1);
+    double seconds = timer.elapsedSeconds();
+
+    std::printf("%5dx%-5d %-6s %6s %10d %12lld %12.3f %14.2f\n",
+                width, height, name, found ? "yes" : "no", search.getPathLength(),
+                search.getExpansions(), seconds * 1e3,
+                static_cast<double>(search.getExpansions()) / seconds / 1e6);
+}
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    int obstaclePercent = (argc > 2) ? std::atoi(argv[2]) : 20;
+    const int sizes[] = {100, 256, 512, 1024, 2048, 4096};
+
+    std::printf("%11s %-6s %6s %10s %12s %12s %14s\n",
+                "map", "search", "found", "length", "expansions", "plan ms", "Mexp/s");
+
+    for (int size : sizes) {
+        if (size > maxSize) {
+            break;
+        }
+
+        OccupancyGrid grid(size, size);
+        generateMap(grid, obstaclePercent, static_cast<uint64_t>(size));
+
+        runSearch("astar", grid, SEARCH_ASTAR);
+        runSearch("jps", grid, SEARCH_JUMP_POINT);
+    }
+
+    return 0;
+}
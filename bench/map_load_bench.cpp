@@ -0,0 +1,102 @@
+// Planner startup time on a large field.
+//
+// Builds a random WIDTH x WIDTH field (4096 by default, 20% obstacles) and
+// times how long it takes to get a planner ready to plan on it:
+//   markObstacle    - a planner created empty, obstacles marked cell by cell
+//   ascii parse     - readAsciiMap on the ASCII-art form, then a grid copy
+//   mmap            - MappedMapFile::open + planner over the mapped payload
+//   mmap + checksum - the same with the payload checksum verified
+// The files are written to the system temp directory and removed afterwards.
+//
+// Usage: map_load_bench [width]
+
+#include "../src/map_file.h"
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Print one result row
+static void report(const char* name, double seconds) {
+    std::printf("%-18s %12.3f ms\n", name, seconds * 1e3);
+}
+
+int main(int argc, char** argv) {
+    int width = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    if (width < 2) {
+        width = 2;
+    }
+
+    // Random field with the start and destination corners left free
+    BenchRandom random(2024);
+    OccupancyGrid field(width, width);
+    std::vector<GridCell> cells;
+    for (int y = 0; y < width; y++) {
+        for (int x = 0; x < width; x++) {
+            if (random.nextInt(100) < 20 && !(x == 0 && y == 0) && !(x == width - 1 && y == width - 1)) {
+                field.markObstacle(x, y);
+                cells.push_back(GridCell{x, y});
+            }
+        }
+    }
+    GridCell start = {0, 0};
+    GridCell dest = {width - 1, width - 1};
+
+    std::string binaryPath = "/tmp/map_load_bench.map";
+    std::string error;
+    if (!writeMapFile(binaryPath, field, start, dest, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    std::ostringstream text;
+    writeAsciiMap(text, field, start, dest);
+    std::string ascii = text.str();
+
+    std::printf("%d x %d field, %zu obstacles, %lld payload bytes\n\n", width, width, cells.size(),
+                field.getStorageBytes());
+
+    // Per-cell marking: what a caller without a map file has to do
+    {
+        BenchTimer timer;
+        std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, width - 1, width - 1, width, width));
+        for (const GridCell& cell : cells) {
+            planner->markObstacle(cell.x, cell.y);
+        }
+        report("markObstacle", timer.elapsedSeconds());
+        benchKeep(planner);
+    }
+
+    // ASCII parse into a grid, then copied into planner storage
+    {
+        BenchTimer timer;
+        std::istringstream in(ascii);
+        std::unique_ptr<OccupancyGrid> grid;
+        GridCell parsedStart;
+        GridCell parsedDest;
+        readAsciiMap(in, grid, parsedStart, parsedDest, error);
+        OccupancyGrid copy(*grid);
+        report("ascii parse", timer.elapsedSeconds());
+        benchKeep(copy);
+    }
+
+    // Mapped file used directly as the obstacle grid
+    for (int verify = 0; verify <= 1; verify++) {
+        BenchTimer timer;
+        MappedMapFile file;
+        if (!file.open(binaryPath, error, verify != 0)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(file));
+        report(verify ? "mmap + checksum" : "mmap", timer.elapsedSeconds());
+        benchKeep(planner);
+    }
+
+    std::remove(binaryPath.c_str());
+    return 0;
+}
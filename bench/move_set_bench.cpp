@@ -0,0 +1,97 @@
+// Success rate and route length of the planners by drivetrain move set.
+//
+// Generated scenarios put the destination up and right of the start; here
+// half of them are mirrored on each axis so destinations lie in every
+// direction. Each planner runs with NORTH/EAST moves only, all four axis
+// moves, and all four plus diagonals, on the simulated robot.
+//
+// Usage: move_set_bench [scenarios] [seed]
+
+#include "../src/batch_simulation.h"
+#include "../src/logger.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+// Swap start and destination coordinates on random axes
+static void mirrorScenarios(std::vector<Scenario>& scenarios, unsigned long long seed) {
+    BenchRandom random(seed);
+    for (Scenario& scenario : scenarios) {
+        if (random.nextInt(2) == 1) {
+            std::swap(scenario.startX, scenario.destX);
+        }
+        if (random.nextInt(2) == 1) {
+            std::swap(scenario.startY, scenario.destY);
+        }
+
+        // Mirrored endpoints may land on obstacles; clear them
+        std::vector<GridCell> kept;
+        for (const GridCell& cell : scenario.obstacles) {
+            bool onEndpoint = (cell.x == scenario.startX && cell.y == scenario.startY) ||
+                              (cell.x == scenario.destX && cell.y == scenario.destY);
+            if (!onEndpoint) {
+                kept.push_back(cell);
+            }
+        }
+        scenario.obstacles.swap(kept);
+    }
+}
+
+// Run one configuration and print its row
+static void runRow(const char* planner, const char* moves, const std::vector<Scenario>& scenarios,
+                   const BatchOptions& options, ThreadPool& pool) {
+    BenchTimer timer;
+    std::vector<ScenarioResult> results = runScenarios(scenarios, options, pool);
+    double wallMs = timer.elapsedSeconds() * 1e3;
+    BatchSummary summary = summarizeResults(results);
+
+    double count = (summary.succeeded > 0) ? summary.succeeded : 1;
+    double driven = 0.0;
+    double turns = 0.0;
+    double mission = 0.0;
+    for (const ScenarioResult& result : results) {
+        if (result.status == SCENARIO_SUCCESS) {
+            driven += result.stats.moves;
+            turns += result.stats.turns;
+            mission += result.missionSeconds;
+        }
+    }
+    std::printf("%-8s %-6s %8d/%-4d %10.1f %10.1f %12.1f %10.1f\n", planner, moves, summary.succeeded,
+                summary.scenarios, driven / count, turns / count, mission / count, wallMs);
+}
+
+int main(int argc, char** argv) {
+    int scenarioCount = (argc > 1) ? std::atoi(argv[1]) : 200;
+    unsigned long long seed = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 7;
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    ThreadPool pool;
+
+    const PlannerMode modes[] = {GREEDY_PLANNER, ASTAR_PLANNER, INCREMENTAL_PLANNER};
+    const char* modeNames[] = {"greedy", "astar", "dstar"};
+    const int moveSets[] = {MOVES_NORTH_EAST, MOVES_ALL, MOVES_ALL_DIAGONAL};
+    const char* moveSetNames[] = {"ne", "all", "all8"};
+
+    const int sizes[] = {20, 64};
+    for (int size : sizes) {
+        // About 10% of the cells are obstacles
+        std::vector<Scenario> scenarios = generateScenarios(scenarioCount, seed, size, size, size * size / 10);
+        mirrorScenarios(scenarios, seed);
+        std::printf("%d x %d maps, %d scenarios (averages over successful runs)\n", size, size, scenarioCount);
+        std::printf("%-8s %-6s %13s %10s %10s %12s %10s\n", "planner", "moves", "success", "driven", "turns",
+                    "mission s", "wall ms");
+
+        for (int mode = 0; mode < 3; mode++) {
+            for (int set = 0; set < 3; set++) {
+                BatchOptions options = getDefaultBatchOptions();
+                options.simulate = true;
+                options.mode = modes[mode];
+                options.allowedMoves = moveSets[set];
+                runRow(modeNames[mode], moveSetNames[set], scenarios, options, pool);
+            }
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Insert/compact throughput of DoublyLinkedList with different node allocators.
+//
+// The workload mimics the planning loop: a stream of REGULAR steps with a
+// periodic TURNING_NODE, the turning trigger compacting between necessary
+// nodes and the capacity trigger compacting when the list fills up.
+//
+// Usage: node_allocator_bench [operations]
+
+#include "../src/doubly_linked_list.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Run the planning-loop workload and return nanoseconds per insert
+static double runWorkload(DoublyLinkedList& list, long long operations) {
+    BenchTimer timer;
+    int x = 0;
+    int y = 0;
+
+    list.insert(x, y, START_LOCATION);
+    for (long long i = 0; i < operations; i++) {
+        bool turning = (i % 7) == 6;
+        if (turning) {
+            y++;
+        } else {
+            x++;
+        }
+
+        Node* previous = list.findLatestNecessaryNode();
+        list.insert(x, y, turning ? TURNING_NODE : REGULAR);
+
+        // Turning trigger
+        if (turning && previous != list.getTail()) {
+            list.removeRegularNodesBetweenNecessary(list.getTail(), previous);
+        }
+
+        // Capacity trigger; start over once only necessary nodes are left
+        if (list.isFull()) {
+            list.removeRegularNodes();
+            if (list.isFull()) {
+                list.clear();
+                list.insert(x, y, START_LOCATION);
+            }
+        }
+    }
+
+    double nanoseconds = timer.elapsedNanoseconds();
+    benchKeep(list.getSize());
+    return nanoseconds / static_cast<double>(operations);
+}
+
+int main(int argc, char** argv) {
+    long long operations = (argc > 1) ? std::atoll(argv[1]) : 5000000;
+    const int capacities[] = {10, 100, 1000};
+
+    std::printf("%10s %14s %14s %14s\n", "capacity", "heap ns/op", "pool ns/op", "arena ns/op");
+
+    for (int capacity : capacities) {
+        HeapNodeAllocator heap;
+        DoublyLinkedList heapList(capacity, &heap);
+        double heapTime = runWorkload(heapList, operations);
+
+        DoublyLinkedList poolList(capacity);
+        double poolTime = runWorkload(poolList, operations);
+
+        NodeArena arena;
+        DoublyLinkedList arenaList(capacity, &arena);
+        double arenaTime = runWorkload(arenaList, operations);
+
+        std::printf("%10d %14.2f %14.2f %14.2f\n", capacity, heapTime, poolTime, arenaTime);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Lookup throughput of the bit-packed OccupancyGrid against the original
+// bool** layout (one heap row per map column).
+//
+// Usage: occupancy_grid_bench [max_map_size] [lookups]
+
+#include "../src/occupancy_grid.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Original obstacle layout used by RobotPathPlanner
+class BoolRowsGrid {
+private:
+    int width;
+    int height;
+    bool** cells;
+
+public:
+    // Constructor
+    BoolRowsGrid(int grid_width, int grid_height) : width(grid_width), height(grid_height) {
+        cells = new bool*[width];
+        for (int i = 0; i < width; i++) {
+            cells[i] = new bool[height];
+            for (int j = 0; j < height; j++) {
+                cells[i][j] = false;
+            }
+        }
+    }
+
+    // Destructor
+    ~BoolRowsGrid() {
+        for (int i = 0; i < width; i++) {
+            delete[] cells[i];
+        }
+        delete[] cells;
+    }
+
+    // Check if an obstacle is detected
+    bool isObstacleDetected(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return true;
+        }
+        return cells[x][y];
+    }
+
+    // Mark an obstacle at the specified position
+    void markObstacle(int x, int y) {
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+            cells[x][y] = true;
+        }
+    }
+};
+
+// Time random lookups against a grid and return lookups per second
+template <typename Grid>
+static double measureLookups(const Grid& grid, const std::vector<int>& xs, const std::vector<int>& ys) {
+    BenchTimer timer;
+    long long hits = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        hits += grid.isObstacleDetected(xs[i], ys[i]) ? 1 : 0;
+    }
+    double seconds = timer.elapsedSeconds();
+    benchKeep(hits);
+    return static_cast<double>(xs.size()) / seconds;
+}
+
+int main(int argc, char** argv) {
+    int maxSize = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    int lookups = (argc > 2) ? std::atoi(argv[2]) : 20000000;
+
+    std::printf("%10s %14s %14s %14s %14s %8s\n",
+                "map", "bool** MB", "grid MB", "bool** Mlk/s", "grid Mlk/s", "speedup");
+
+    for (int size = 100; size <= maxSize; size *= 10) {
+        BoolRowsGrid rows(size, size);
+        OccupancyGrid grid(size, size);
+
+        // Scatter roughly 10% obstacles identically into both layouts
+        BenchRandom random(static_cast<uint64_t>(size));
+        long long obstacleCount = static_cast<long long>(size) * size / 10;
+        for (long long i = 0; i < obstacleCount; i++) {
+            int x = random.nextInt(size);
+            int y = random.nextInt(size);
+            rows.markObstacle(x, y);
+            grid.markObstacle(x, y);
+        }
+
+        // Random probe positions shared by both layouts
+        std::vector<int> xs(lookups);
+        std::vector<int> ys(lookups);
+        for (int i = 0; i < lookups; i++) {
+            xs[i] = random.nextInt(size);
+            ys[i] = random.nextInt(size);
+        }
+
+        double rowsRate = measureLookups(rows, xs, ys);
+        double gridRate = measureLookups(grid, xs, ys);
+        double rowsMegabytes = static_cast<double>(size) * size / (1024.0 * 1024.0);
+        double gridMegabytes = static_cast<double>(grid.getStorageBytes()) / (1024.0 * 1024.0);
+
+        std::printf("%5dx%-5d %14.2f %14.2f %14.1f %14.1f %7.2fx\n",
+                    size, size, rowsMegabytes, gridMegabytes,
+                    rowsRate / 1e6, gridRate / 1e6, gridRate / rowsRate);
+    }
+
+    return 0;
+}
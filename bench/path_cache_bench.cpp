@@ -0,0 +1,113 @@
+// Repeated missions on one field with and without the path cache.
+//
+// Missions pick one of a fixed set of start/destination pairs at random,
+// the way a practice session replays the same few runs. Every few missions
+// one new obstacle appears on the field, which changes the map hash and
+// turns the cached routes for the old field into dead entries. The table
+// shows the planning time per mission and the cache counters for a range
+// of cache sizes.
+//
+// Usage: path_cache_bench [size] [missions] [pairs] [missions_per_change]
+
+#include "../src/batch_query.h"
+#include "../src/logger.h"
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Run every mission with the given cache (nullptr for none); returns microseconds per mission
+static double runMissions(int size, const std::vector<GridCell>& field, const std::vector<GridCell>& changes,
+                          const std::vector<PathQuery>& missions, int missions_per_change, PathCache* cache) {
+    double plannerSeconds = 0.0;
+    size_t knownChanges = 0;
+
+    for (size_t i = 0; i < missions.size(); i++) {
+        if (missions_per_change > 0 && i > 0 && i % missions_per_change == 0 && knownChanges < changes.size()) {
+            knownChanges++;
+        }
+
+        const PathQuery& mission = missions[i];
+        RobotPathPlanner planner(mission.startX, mission.startY, mission.destX, mission.destY, size, size);
+        for (const GridCell& cell : field) {
+            planner.markObstacle(cell.x, cell.y);
+        }
+        for (size_t j = 0; j < knownChanges; j++) {
+            planner.markObstacle(changes[j].x, changes[j].y);
+        }
+        planner.setPlannerMode(JUMP_POINT_PLANNER);
+        planner.setPathCache(cache);
+
+        BenchTimer timer;
+        planner.initialize();
+        planner.executePlanningAlgorithm();
+        plannerSeconds += timer.elapsedSeconds();
+        benchKeep(planner.getStats().moves);
+    }
+
+    return plannerSeconds * 1e6 / static_cast<double>(missions.size());
+}
+
+int main(int argc, char** argv) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 256;
+    int missionCount = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    int pairCount = (argc > 3) ? std::atoi(argv[3]) : 64;
+    int missionsPerChange = (argc > 4) ? std::atoi(argv[4]) : 200;
+    if (size < 8 || missionCount < 1 || pairCount < 1) {
+        std::fprintf(stderr, "usage: path_cache_bench [size] [missions] [pairs] [missions_per_change]\n");
+        return 1;
+    }
+
+    // 5% obstacles, kept off the lower left and upper right corners used as endpoints
+    BenchRandom random(99);
+    std::vector<GridCell> field;
+    for (int i = 0; i < size * size / 20; i++) {
+        GridCell cell = {random.nextInt(size), random.nextInt(size)};
+        if ((cell.x < size / 4 && cell.y < size / 4) || (cell.x >= size * 3 / 4 && cell.y >= size * 3 / 4)) {
+            continue;
+        }
+        field.push_back(cell);
+    }
+    std::vector<GridCell> changes;
+    for (int i = 0; i < missionCount; i++) {
+        GridCell cell = {size / 4 + random.nextInt(size / 2), size / 4 + random.nextInt(size / 2)};
+        changes.push_back(cell);
+    }
+
+    std::vector<PathQuery> pairs;
+    for (int i = 0; i < pairCount; i++) {
+        PathQuery pair = {random.nextInt(size / 4), random.nextInt(size / 4), size * 3 / 4 + random.nextInt(size / 4),
+                          size * 3 / 4 + random.nextInt(size / 4)};
+        pairs.push_back(pair);
+    }
+    std::vector<PathQuery> missions;
+    for (int i = 0; i < missionCount; i++) {
+        missions.push_back(pairs[random.nextInt(pairCount)]);
+    }
+
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    std::printf("%d x %d field, %d missions over %d start/destination pairs, map change every %d missions\n\n",
+                size, size, missionCount, pairCount, missionsPerChange);
+    std::printf("%10s %14s %10s %10s %10s %10s\n", "entries", "us/mission", "hit rate", "hits", "misses",
+                "evictions");
+
+    double uncached = runMissions(size, field, changes, missions, missionsPerChange, nullptr);
+    std::printf("%10s %14.1f %10s %10s %10s %10s\n", "none", uncached, "-", "-", "-", "-");
+
+    const int entryCounts[] = {pairCount / 4, pairCount / 2, pairCount, pairCount * 4};
+    for (int entries : entryCounts) {
+        if (entries < 1) {
+            continue;
+        }
+        PathCache cache(entries);
+        double cached = runMissions(size, field, changes, missions, missionsPerChange, &cache);
+        PathCacheStats stats = cache.getStats();
+        std::printf("%10d %14.1f %9.1f%% %10lld %10lld %10lld\n", entries, cached,
+                    100.0 * static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses),
+                    stats.hits, stats.misses, stats.evictions);
+    }
+
+    return 0;
+}
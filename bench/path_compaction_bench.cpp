@@ -0,0 +1,151 @@
+// Necessary-node lookup and compaction cost at large path capacities.
+//
+// Compares the tracked findLatestNecessaryNode with the original backward
+// scan from the tail, and the planner's insert + trigger sequence with the
+// tracked lookup against the same sequence with the scan.
+//
+// Usage: path_compaction_bench [max_capacity]
+
+#include "../src/doubly_linked_list.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Original lookup: scan backwards from the tail
+static Node* scanLatestNecessaryNode(const DoublyLinkedList& list) {
+    Node* current = list.getTail();
+    while (current != nullptr) {
+        if (current->type != REGULAR) {
+            return current;
+        }
+        current = current->prev;
+    }
+    return list.getHead();
+}
+
+// Time lookups with a trailing run of regular nodes behind the last necessary node
+static void benchLookup(int runLength) {
+    DoublyLinkedList list(runLength + 2);
+    list.insert(0, 0, START_LOCATION);
+    for (int i = 1; i <= runLength; i++) {
+        list.insert(i, 0, REGULAR);
+    }
+
+    const int queries = 1000;
+    BenchTimer scanTimer;
+    for (int i = 0; i < queries; i++) {
+        benchKeep(scanLatestNecessaryNode(list));
+    }
+    double scanNs = scanTimer.elapsedNanoseconds() / queries;
+
+    BenchTimer trackedTimer;
+    for (int i = 0; i < queries; i++) {
+        benchKeep(list.findLatestNecessaryNode());
+    }
+    double trackedNs = trackedTimer.elapsedNanoseconds() / queries;
+
+    std::printf("%12d %16.1f %16.1f\n", runLength, scanNs, trackedNs);
+}
+
+// Planning-loop stream: straight runs of random length separated by turns
+struct StepStream {
+    BenchRandom random;
+    int remaining;
+    int maxRun;
+    int x;
+
+    StepStream(int max_run) : random(12345), remaining(0), maxRun(max_run), x(0) {}
+
+    // Get the type of the next step
+    NodeType next() {
+        x++;
+        if (remaining == 0) {
+            remaining = 1 + random.nextInt(maxRun);
+            return TURNING_NODE;
+        }
+        remaining--;
+        return REGULAR;
+    }
+};
+
+// Insert, backward scan and trigger calls (original planner flow)
+static double runScanned(int capacity, long long steps) {
+    DoublyLinkedList list(capacity);
+    StepStream stream(capacity / 2);
+    list.insert(0, 0, START_LOCATION);
+
+    BenchTimer timer;
+    for (long long i = 0; i < steps; i++) {
+        NodeType type = stream.next();
+        list.insert(stream.x, 0, type);
+        if (type != REGULAR) {
+            Node* previous = scanLatestNecessaryNode(list);
+            if (previous == list.getTail() && previous->prev != nullptr) {
+                // Skip past the node just inserted to the one before it
+                Node* node = previous->prev;
+                while (node->prev != nullptr && node->type == REGULAR) {
+                    node = node->prev;
+                }
+                previous = node;
+            }
+            list.removeRegularNodesBetweenNecessary(list.getTail(), previous);
+        }
+        if (list.isFull()) {
+            list.removeRegularNodes();
+            if (list.isFull()) {
+                list.clear();
+                list.insert(stream.x, 0, START_LOCATION);
+            }
+        }
+    }
+    return timer.elapsedNanoseconds() / static_cast<double>(steps);
+}
+
+// Tracked lookup before the insert, then the trigger calls (current planner flow)
+//
+// Every node after the tracked necessary node is regular, so each trigger
+// walks only the nodes it removes.
+static double runTracked(int capacity, long long steps) {
+    DoublyLinkedList list(capacity);
+    StepStream stream(capacity / 2);
+    list.insert(0, 0, START_LOCATION);
+
+    BenchTimer timer;
+    for (long long i = 0; i < steps; i++) {
+        NodeType type = stream.next();
+        Node* previous = list.findLatestNecessaryNode();
+        list.insert(stream.x, 0, type);
+        if (type != REGULAR && previous != list.getTail()) {
+            list.removeRegularNodesBetweenNecessary(list.getTail(), previous);
+        }
+        if (list.isFull()) {
+            list.removeRegularNodes();
+            if (list.isFull()) {
+                list.clear();
+                list.insert(stream.x, 0, START_LOCATION);
+            }
+        }
+    }
+    return timer.elapsedNanoseconds() / static_cast<double>(steps);
+}
+
+int main(int argc, char** argv) {
+    int maxCapacity = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    std::printf("findLatestNecessaryNode\n");
+    std::printf("%12s %16s %16s\n", "trailing run", "scan ns/query", "tracked ns/query");
+    for (int run = 1000; run <= maxCapacity; run *= 10) {
+        benchLookup(run);
+    }
+
+    std::printf("\nplanning loop (insert + triggers)\n");
+    std::printf("%12s %16s %16s\n", "capacity", "scanned ns/step", "tracked ns/step");
+    for (int capacity = 100000; capacity <= maxCapacity; capacity *= 10) {
+        long long steps = static_cast<long long>(capacity) * 20;
+        double scanned = runScanned(capacity, steps);
+        double tracked = runTracked(capacity, steps);
+        std::printf("%12d %16.2f %16.2f\n", capacity, scanned, tracked);
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Sequential against pipelined plan/execute on a field with hidden obstacles.
+//
+// The robot drives a simulated drivetrain that sleeps realTimeScale wall
+// seconds per simulated second, so planning and motion compete for time
+// the way they do on the robot. A sensor thread reveals hidden obstacles
+// at a steady rate through an ObstacleSensorQueue, forcing replans along
+// the way. For each configuration the table shows the end-to-end wall time
+// of the mission, the simulated motion time, the time the drivetrain sat
+// waiting for a route and the number of replans.
+//
+// Usage: pipeline_bench [size] [hidden_obstacles] [real_time_scale]
+
+#include "../src/logger.h"
+#include "../src/obstacle_sensor_queue.h"
+#include "../src/robot_path_planner.h"
+#include "../src/simulated_hardware.h"
+#include "bench_util.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// One configuration of the comparison
+struct PipelineCase {
+    const char* name;
+    PlannerMode mode;
+    ExecutionMode execution;
+};
+
+// Reveal the hidden cells one at a time, spaced evenly over the expected mission
+static void runSensor(ObstacleSensorQueue& queue, const std::vector<GridCell>& hidden, double interval_seconds,
+                      const std::atomic<bool>& stop) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t next = 0;
+    while (next < hidden.size() && !stop.load(std::memory_order_relaxed)) {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= interval_seconds * static_cast<double>(next + 1)) {
+            queue.publish(hidden[next].x, hidden[next].y);
+            next++;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 256;
+    int hiddenCount = (argc > 2) ? std::atoi(argv[2]) : 100;
+    double scale = (argc > 3) ? std::atof(argv[3]) : 0.001;
+    if (size < 8) {
+        size = 8;
+    }
+
+    // Known obstacles (5%) and hidden ones, away from the start and destination
+    BenchRandom random(31);
+    std::vector<GridCell> known;
+    std::vector<GridCell> hidden;
+    for (int i = 0; i < size * size / 20 + hiddenCount; i++) {
+        GridCell cell = {random.nextInt(size), random.nextInt(size)};
+        if ((cell.x < 2 && cell.y < 2) || (cell.x > size - 3 && cell.y > size - 3)) {
+            continue;
+        }
+        if (static_cast<int>(hidden.size()) < hiddenCount) {
+            hidden.push_back(cell);
+        } else {
+            known.push_back(cell);
+        }
+    }
+
+    // Spread the reveals over roughly the time of a straight staircase drive
+    SimulationConfig config = getDefaultSimulationConfig();
+    config.realTimeScale = scale;
+    double expectedSeconds = 2.0 * size * 0.6 * scale;
+    double interval = expectedSeconds / (hiddenCount + 1);
+
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    const PipelineCase cases[] = {
+        {"dstar sequential", INCREMENTAL_PLANNER, EXECUTION_SEQUENTIAL},
+        {"dstar pipelined", INCREMENTAL_PLANNER, EXECUTION_PIPELINED},
+        {"astar pipelined", ASTAR_PLANNER, EXECUTION_PIPELINED},
+        {"jps pipelined", JUMP_POINT_PLANNER, EXECUTION_PIPELINED},
+    };
+
+    std::printf("%d x %d field, %zu known and %zu hidden obstacles, real-time scale %g\n\n", size, size,
+                known.size(), hidden.size(), scale);
+    std::printf("%-18s %10s %10s %10s %8s %8s %8s\n", "case", "wall ms", "motion s", "idle ms", "replans",
+                "stale", "reached");
+
+    for (const PipelineCase& test : cases) {
+        std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, size - 1, size - 1, size, size));
+        for (const GridCell& cell : known) {
+            planner->markObstacle(cell.x, cell.y);
+        }
+
+        SimulatedHardware hardware(config);
+        ObstacleSensorQueue queue;
+        planner->setHardware(&hardware);
+        planner->setSensorQueue(&queue);
+        planner->setPlannerMode(test.mode);
+        planner->setExecutionMode(test.execution);
+        planner->setStepLimit(8 * size);
+        planner->initialize();
+        double motionStart = hardware.getTime();
+
+        std::atomic<bool> stop(false);
+        std::thread sensor(runSensor, std::ref(queue), std::cref(hidden), interval, std::cref(stop));
+
+        BenchTimer timer;
+        planner->executePlanningAlgorithm();
+        double wallMs = timer.elapsedSeconds() * 1e3;
+
+        stop.store(true);
+        sensor.join();
+
+        const PlannerStats& stats = planner->getStats();
+        std::printf("%-18s %10.1f %10.1f %10.3f %8d %8d %8s\n", test.name, wallMs, hardware.getTime() - motionStart,
+                    stats.idleSeconds * 1e3, stats.replans, stats.discardedLegs,
+                    planner->isDestinationReached() ? "yes" : "no");
+    }
+
+    return 0;
+}
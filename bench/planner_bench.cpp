@@ -0,0 +1,390 @@
+// Microbenchmark suite for the path list and planner hot paths.
+//
+// Every case reports ns/op, heap allocations per op (counted by replacing
+// the global operator new) and the process peak RSS after the case. Results
+// can be saved as a JSON baseline and compared against a later run.
+//
+// Usage: planner_bench [--filter TEXT] [--min-time SECONDS]
+//                      [--save FILE] [--compare FILE]
+
+#include "../src/batch_simulation.h"
+#include "../src/logger.h"
+#include "bench_util.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+// Heap allocations made by the whole process
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+// Get the peak resident set size of the process in kilobytes
+static long getPeakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Timed region of a benchmark; setup work between stop and start is not counted
+class BenchRegion {
+private:
+    BenchTimer timer;
+    double nanoseconds;
+    long long allocationsAtStart;
+    long long allocations;
+
+public:
+    // Constructor
+    BenchRegion() : nanoseconds(0.0), allocationsAtStart(0), allocations(0) {}
+
+    // Start timing
+    void start() {
+        allocationsAtStart = allocationCount.load(std::memory_order_relaxed);
+        timer.reset();
+    }
+
+    // Stop timing and add the elapsed time and allocations
+    void stop() {
+        nanoseconds += timer.elapsedNanoseconds();
+        allocations += allocationCount.load(std::memory_order_relaxed) - allocationsAtStart;
+    }
+
+    // Get the total timed nanoseconds
+    double getNanoseconds() const {
+        return nanoseconds;
+    }
+
+    // Get the allocations made inside the timed regions
+    long long getAllocations() const {
+        return allocations;
+    }
+};
+
+// Result of one benchmark case
+struct BenchResult {
+    std::string name;
+    int param;
+    double nsPerOp;
+    double allocsPerOp;
+    long peakRssKb;
+};
+
+// Benchmark body: runs about `rounds` rounds and returns the number of timed operations
+typedef long long (*BenchBody)(BenchRegion& region, int param, long long rounds);
+
+// Fill a list with a START node followed by REGULAR nodes up to count
+static void fillRegular(DoublyLinkedList& list, int count) {
+    list.insert(0, 0, START_LOCATION);
+    for (int i = 1; i < count; i++) {
+        list.insert(i, 0, REGULAR);
+    }
+}
+
+// insert: fill the list to capacity, then clear it (untimed)
+static long long benchInsert(BenchRegion& region, int capacity, long long rounds) {
+    DoublyLinkedList list(capacity);
+    long long ops = 0;
+    for (long long round = 0; round < rounds; round++) {
+        region.start();
+        for (int i = 0; i < capacity; i++) {
+            list.insert(i, 0, (i % 8) == 0 ? TURNING_NODE : REGULAR);
+        }
+        region.stop();
+        ops += capacity;
+        list.clear();
+    }
+    return ops;
+}
+
+// remove(index): empty a full list by always removing the middle node
+static long long benchRemoveIndex(BenchRegion& region, int capacity, long long rounds) {
+    DoublyLinkedList list(capacity);
+    long long ops = 0;
+    for (long long round = 0; round < rounds; round++) {
+        fillRegular(list, capacity);
+        region.start();
+        while (!list.isEmpty()) {
+            list.remove(list.getSize() / 2);
+        }
+        region.stop();
+        ops += capacity;
+    }
+    return ops;
+}
+
+// removeRegularNodes: drop a full run of regular nodes behind the start node
+static long long benchRemoveRegularNodes(BenchRegion& region, int capacity, long long rounds) {
+    DoublyLinkedList list(capacity);
+    for (long long round = 0; round < rounds; round++) {
+        fillRegular(list, capacity);
+        region.start();
+        benchKeep(list.removeRegularNodes());
+        region.stop();
+        list.clear();
+    }
+    return rounds;
+}
+
+// removeRegularNodesBetweenNecessary: drop the run between START and a closing TURNING_NODE
+static long long benchRemoveBetweenNecessary(BenchRegion& region, int capacity, long long rounds) {
+    DoublyLinkedList list(capacity);
+    for (long long round = 0; round < rounds; round++) {
+        fillRegular(list, capacity - 1);
+        Node* previous = list.findLatestNecessaryNode();
+        list.insert(capacity, 0, TURNING_NODE);
+        region.start();
+        benchKeep(list.removeRegularNodesBetweenNecessary(list.getTail(), previous));
+        region.stop();
+        list.clear();
+    }
+    return rounds;
+}
+
+// findLatestNecessaryNode: query a full list whose tail run is all regular
+static long long benchFindLatestNecessary(BenchRegion& region, int capacity, long long rounds) {
+    DoublyLinkedList list(capacity);
+    fillRegular(list, capacity);
+    const int queries = 1000;
+    region.start();
+    for (long long round = 0; round < rounds; round++) {
+        for (int i = 0; i < queries; i++) {
+            benchKeep(list.findLatestNecessaryNode());
+        }
+    }
+    region.stop();
+    return rounds * queries;
+}
+
+// isObstacleDetected: random probes of a size x size grid with 20% obstacles
+static long long benchIsObstacleDetected(BenchRegion& region, int size, long long rounds) {
+    OccupancyGrid grid(size, size);
+    BenchRandom random(42);
+    for (int i = 0; i < size * size / 5; i++) {
+        grid.markObstacle(random.nextInt(size), random.nextInt(size));
+    }
+
+    const int probes = 4096;
+    std::vector<GridCell> cells(probes);
+    for (GridCell& cell : cells) {
+        cell.x = random.nextInt(size);
+        cell.y = random.nextInt(size);
+    }
+
+    int hits = 0;
+    region.start();
+    for (long long round = 0; round < rounds; round++) {
+        for (const GridCell& cell : cells) {
+            hits += grid.isObstacleDetected(cell.x, cell.y) ? 1 : 0;
+        }
+    }
+    region.stop();
+    benchKeep(hits);
+    return rounds * probes;
+}
+
+// executePlanningAlgorithm: one full run per generated size x size map
+template <PlannerMode Mode>
+static long long benchPlanning(BenchRegion& region, int size, long long rounds) {
+    std::vector<Scenario> scenarios = generateScenarios(64, 7, size, size, size * size / 20);
+    for (long long round = 0; round < rounds; round++) {
+        const Scenario& scenario = scenarios[round % scenarios.size()];
+        RobotPathPlanner planner(scenario.startX, scenario.startY, scenario.destX, scenario.destY,
+                                 scenario.width, scenario.height);
+        planner.setPlannerMode(Mode);
+        planner.setStepLimit(4 * (size + size));
+        for (const GridCell& cell : scenario.obstacles) {
+            planner.markObstacle(cell.x, cell.y);
+        }
+        planner.initialize();
+
+        region.start();
+        planner.executePlanningAlgorithm();
+        region.stop();
+    }
+    return rounds;
+}
+
+// One named case and the parameters it runs with
+struct BenchCase {
+    const char* name;
+    BenchBody body;
+    std::vector<int> params;
+};
+
+// Run a case with growing round counts until it has been timed for min_seconds
+static BenchResult runCase(const char* name, BenchBody body, int param, double min_seconds) {
+    long long rounds = 1;
+    while (true) {
+        BenchRegion region;
+        long long ops = body(region, param, rounds);
+        double seconds = region.getNanoseconds() / 1e9;
+        if (seconds >= min_seconds || rounds >= (1LL << 40)) {
+            BenchResult result;
+            result.name = name;
+            result.param = param;
+            result.nsPerOp = region.getNanoseconds() / static_cast<double>(ops);
+            result.allocsPerOp = static_cast<double>(region.getAllocations()) / static_cast<double>(ops);
+            result.peakRssKb = getPeakRssKb();
+            return result;
+        }
+
+        // Aim a little past the target on the next attempt
+        long long next = (seconds > 0.0) ? static_cast<long long>(rounds * min_seconds * 1.2 / seconds) : rounds * 10;
+        rounds = (next > rounds * 10) ? rounds * 10 : ((next > rounds) ? next : rounds * 2);
+    }
+}
+
+// Write results as a JSON baseline (one case per line)
+static bool saveBaseline(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "{\"cases\": [\n";
+    char line[256];
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        std::snprintf(line, sizeof(line),
+                      "  {\"name\": \"%s\", \"param\": %d, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, "
+                      "\"peak_rss_kb\": %ld}%s\n",
+                      result.name.c_str(), result.param, result.nsPerOp, result.allocsPerOp,
+                      result.peakRssKb, (i + 1 < results.size()) ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+    return true;
+}
+
+// Read the ns/op of each case from a baseline written by saveBaseline
+static bool loadBaseline(const std::string& path, std::map<std::string, double>& nsPerOp) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    std::string line;
+    char name[128];
+    int param = 0;
+    double ns = 0.0;
+    while (std::getline(in, line)) {
+        if (std::sscanf(line.c_str(), " {\"name\": \"%127[^\"]\", \"param\": %d, \"ns_per_op\": %lf",
+                        name, &param, &ns) == 3) {
+            nsPerOp[std::string(name) + "/" + std::to_string(param)] = ns;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string savePath;
+    std::string comparePath;
+    double minSeconds = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]);
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: planner_bench [--filter TEXT] [--min-time SECONDS] "
+                                 "[--save FILE] [--compare FILE]\n");
+            return 1;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!comparePath.empty() && !loadBaseline(comparePath, baseline)) {
+        std::fprintf(stderr, "cannot read baseline '%s'\n", comparePath.c_str());
+        return 1;
+    }
+
+    // Planner output would dominate the planning cases
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    const std::vector<int> capacities = {10, 100, 1000, 10000};
+    const std::vector<int> mapSizes = {20, 100, 500};
+    const BenchCase cases[] = {
+        {"insert", benchInsert, capacities},
+        {"remove_index", benchRemoveIndex, capacities},
+        {"remove_regular_nodes", benchRemoveRegularNodes, capacities},
+        {"remove_between_necessary", benchRemoveBetweenNecessary, capacities},
+        {"find_latest_necessary", benchFindLatestNecessary, capacities},
+        {"is_obstacle_detected", benchIsObstacleDetected, mapSizes},
+        {"plan_greedy", benchPlanning<GREEDY_PLANNER>, mapSizes},
+        {"plan_astar", benchPlanning<ASTAR_PLANNER>, mapSizes},
+        {"plan_dstar", benchPlanning<INCREMENTAL_PLANNER>, mapSizes},
+    };
+
+    std::printf("%-26s %8s %14s %12s %12s%s\n", "case", "param", "ns/op", "allocs/op", "peak RSS kB",
+                baseline.empty() ? "" : "   vs baseline");
+
+    std::vector<BenchResult> results;
+    for (const BenchCase& benchCase : cases) {
+        if (!filter.empty() && std::strstr(benchCase.name, filter.c_str()) == nullptr) {
+            continue;
+        }
+        for (int param : benchCase.params) {
+            BenchResult result = runCase(benchCase.name, benchCase.body, param, minSeconds);
+            results.push_back(result);
+
+            std::printf("%-26s %8d %14.2f %12.4f %12ld", result.name.c_str(), result.param,
+                        result.nsPerOp, result.allocsPerOp, result.peakRssKb);
+            std::map<std::string, double>::const_iterator old =
+                baseline.find(result.name + "/" + std::to_string(result.param));
+            if (old != baseline.end() && old->second > 0.0) {
+                std::printf("   %+7.1f%%", 100.0 * (result.nsPerOp - old->second) / old->second);
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+    }
+
+    if (!savePath.empty() && !saveBaseline(savePath, results)) {
+        std::fprintf(stderr, "cannot write baseline '%s'\n", savePath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
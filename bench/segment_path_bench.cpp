@@ -0,0 +1,71 @@
+// Memory per path and append throughput of SegmentPath against the
+// per-cell DoublyLinkedList.
+//
+// Usage: segment_path_bench [steps]
+
+#include "../src/segment_path.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    long long steps = (argc > 1) ? std::atoll(argv[1]) : 1000000;
+    const int averageRuns[] = {1, 4, 16, 64, 256};
+
+    std::printf("%10s %12s %14s %14s %14s %14s\n",
+                "avg run", "segments", "list bytes", "segment bytes", "list ns/app", "seg ns/app");
+
+    for (int averageRun : averageRuns) {
+        // Generate a NORTH/EAST staircase with random straight runs
+        BenchRandom random(static_cast<uint64_t>(averageRun));
+        DoublyLinkedList list(static_cast<int>(steps) + 1);
+        SegmentPath segments;
+
+        int x = 0;
+        int y = 0;
+        Direction heading = NORTH;
+        int remaining = 0;
+
+        double listNs = 0.0;
+        double segmentNs = 0.0;
+        BenchTimer timer;
+
+        list.insert(x, y, START_LOCATION);
+        segments.append(x, y, START_LOCATION, heading);
+
+        for (long long i = 0; i < steps; i++) {
+            NodeType type = REGULAR;
+            if (remaining == 0) {
+                heading = (heading == NORTH) ? EAST : NORTH;
+                remaining = 1 + random.nextInt(2 * averageRun);
+                type = TURNING_NODE;
+            } else {
+                if (heading == NORTH) {
+                    y++;
+                } else {
+                    x++;
+                }
+                remaining--;
+            }
+
+            timer.reset();
+            list.insert(x, y, type);
+            listNs += timer.elapsedNanoseconds();
+
+            timer.reset();
+            segments.append(x, y, type, heading);
+            segmentNs += timer.elapsedNanoseconds();
+        }
+
+        // Round trip check so the comparison is like for like
+        DoublyLinkedList roundTrip(list.getSize());
+        bool lossless = segments.toList(roundTrip) && roundTrip.getSize() == list.getSize();
+
+        long long listBytes = static_cast<long long>(list.getSize()) * static_cast<long long>(sizeof(Node));
+        std::printf("%10d %12d %14lld %14lld %14.2f %14.2f%s\n",
+                    averageRun, segments.getSegmentCount(), listBytes, segments.getMemoryBytes(),
+                    listNs / steps, segmentNs / steps, lossless ? "" : "  (round trip mismatch)");
+    }
+
+    return 0;
+}
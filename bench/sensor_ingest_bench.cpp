@@ -0,0 +1,128 @@
+// Planning time with a sensor thread publishing obstacles at different rates.
+//
+// The planner drives from (0, 0) to (size-1, size-1) on a field twice as
+// wide; a producer thread publishes random obstacles east of the
+// destination column (seen by the sensor, never on the route) through an
+// ObstacleSensorQueue at a fixed rate, or as fast as it can ("max"). The
+// planning time should stay close to the rate-0 baseline: publishing never
+// blocks and the planner only drains a bounded batch per step.
+//
+// Usage: sensor_ingest_bench [size] [greedy|astar|jps|dstar]
+
+#include "../src/logger.h"
+#include "../src/obstacle_sensor_queue.h"
+#include "../src/robot_path_planner.h"
+#include "bench_util.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Result of one planning run
+struct IngestResult {
+    double planMs;
+    long long ingested;
+    long long published;
+    long long dropped;
+};
+
+// Publish observations at rate per second (-1 for unpaced) until stopped
+static void runSensor(ObstacleSensorQueue& queue, int size, long long rate, const std::atomic<bool>& stop) {
+    BenchRandom random(99);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    long long sent = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        if (rate > 0) {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (sent >= static_cast<long long>(seconds * rate)) {
+                std::this_thread::yield();
+                continue;
+            }
+        }
+        queue.publish(size + 1 + random.nextInt(size - 1), random.nextInt(size));
+        sent++;
+    }
+}
+
+// Plan once with a sensor publishing at the given rate (0 for no sensor thread)
+static IngestResult runOnce(int size, PlannerMode mode, long long rate) {
+    std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, size - 1, size - 1, 2 * size, size));
+    ObstacleSensorQueue queue;
+    planner->setPlannerMode(mode);
+    planner->setSensorQueue(&queue);
+    planner->initialize();
+
+    std::atomic<bool> stop(false);
+    std::thread sensor;
+    if (rate != 0) {
+        sensor = std::thread(runSensor, std::ref(queue), size, rate, std::cref(stop));
+    }
+
+    BenchTimer timer;
+    planner->executePlanningAlgorithm();
+    double planMs = timer.elapsedSeconds() * 1e3;
+
+    stop.store(true);
+    if (sensor.joinable()) {
+        sensor.join();
+    }
+
+    IngestResult result;
+    result.planMs = planMs;
+    result.ingested = planner->getInstrumentation().counters[COUNTER_SENSOR_OBSERVATIONS];
+    result.published = queue.getPublishedCount();
+    result.dropped = queue.getDroppedCount();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 256;
+    std::string modeName = (argc > 2) ? argv[2] : "dstar";
+    PlannerMode mode = INCREMENTAL_PLANNER;
+    if (modeName == "greedy") {
+        mode = GREEDY_PLANNER;
+    } else if (modeName == "astar") {
+        mode = ASTAR_PLANNER;
+    } else if (modeName == "jps") {
+        mode = JUMP_POINT_PLANNER;
+    }
+    if (size < 4) {
+        size = 4;
+    }
+
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    const long long rates[] = {0, 10000, 100000, 1000000, -1};
+    const int runs = 5;
+
+    std::printf("%d x %d route, %s planner, %d runs per rate, %u hardware threads\n\n", size, size,
+                modeName.c_str(), runs, std::thread::hardware_concurrency());
+    std::printf("%10s %12s %12s %12s %12s\n", "obs/s", "plan ms", "ingested", "published", "dropped");
+
+    // Warm up the allocator and caches before the baseline
+    runOnce(size, mode, 0);
+
+    for (long long rate : rates) {
+        IngestResult total = {0.0, 0, 0, 0};
+        for (int run = 0; run < runs; run++) {
+            IngestResult result = runOnce(size, mode, rate);
+            total.planMs += result.planMs;
+            total.ingested += result.ingested;
+            total.published += result.published;
+            total.dropped += result.dropped;
+        }
+
+        char rateText[32];
+        if (rate < 0) {
+            std::snprintf(rateText, sizeof(rateText), "max");
+        } else {
+            std::snprintf(rateText, sizeof(rateText), "%lld", rate);
+        }
+        std::printf("%10s %12.3f %12lld %12lld %12lld\n", rateText, total.planMs / runs, total.ingested / runs,
+                    total.published / runs, total.dropped / runs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Dense versus sparse obstacle storage on large, mostly empty fields.
+//
+// For each WIDTH x WIDTH field with a fixed number of obstacles:
+//   build    - planner construction plus marking every obstacle
+//   MB       - memory held by the obstacle storage afterwards
+// Rectangle queries ("is this box free") are then timed on both maps, and a
+// greedy mission is driven across the field with each backend; the sparse
+// planner only fills a dense grid if its cheap reachability check fails.
+// Dense rows are skipped above dense_limit, where the grid alone would
+// dominate memory.
+//
+// Usage: sparse_map_bench [max_width] [obstacles] [dense_limit]
+
+#include "../src/logger.h"
+#include "../src/occupancy_grid.h"
+#include "../src/robot_path_planner.h"
+#include "../src/sparse_obstacle_map.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Obstacles scattered as short walls, away from the field's border rows
+static std::vector<GridCell> makeObstacles(int width, int count, unsigned long long seed) {
+    BenchRandom random(seed);
+    std::vector<GridCell> cells;
+    while (static_cast<int>(cells.size()) < count) {
+        int x = 2 + random.nextInt(width - 4);
+        int y = 2 + random.nextInt(width - 4);
+        int length = 1 + random.nextInt(8);
+        bool horizontal = random.nextInt(2) == 0;
+        for (int i = 0; i < length && static_cast<int>(cells.size()) < count; i++) {
+            int cellX = horizontal ? x + i : x;
+            int cellY = horizontal ? y : y + i;
+            if (cellX < width - 2 && cellY < width - 2) {
+                cells.push_back(GridCell{cellX, cellY});
+            }
+        }
+    }
+    return cells;
+}
+
+// Build a planner with every obstacle marked and print its row
+static void benchBuild(int width, MapBackend backend, const std::vector<GridCell>& cells) {
+    BenchTimer timer;
+    std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, width - 1, width - 1, width, width, backend));
+    for (const GridCell& cell : cells) {
+        planner->markObstacle(cell.x, cell.y);
+    }
+    double seconds = timer.elapsedSeconds();
+    std::printf("%8d %-8s %12.3f %12.3f %12lld\n", width, backend == MAP_SPARSE ? "sparse" : "dense", seconds * 1e3,
+                planner->getMapStorageBytes() / 1048576.0, planner->getObstacleMap().countObstacles());
+}
+
+// Time rectangle queries of one size on a map; returns nanoseconds per query
+static double benchQueries(const ObstacleMap& map, int side, int queries, int& freeCount) {
+    BenchRandom random(11);
+    int width = map.getWidth();
+    freeCount = 0;
+    BenchTimer timer;
+    for (int i = 0; i < queries; i++) {
+        int x = random.nextInt(width - side);
+        int y = random.nextInt(width - side);
+        freeCount += map.isRectangleFree(x, y, x + side - 1, y + side - 1) ? 1 : 0;
+    }
+    return timer.elapsedNanoseconds() / queries;
+}
+
+// Drive a greedy mission from corner to corner and print its row
+static void benchMission(int width, MapBackend backend, const std::vector<GridCell>& cells) {
+    BenchTimer timer;
+    RobotPathPlanner planner(0, 0, width - 1, width - 1, width, width, backend);
+    for (const GridCell& cell : cells) {
+        planner.markObstacle(cell.x, cell.y);
+    }
+    planner.setStepLimit(4 * width);
+    planner.initialize();
+    PlanStatus status = planner.executePlanningAlgorithm();
+    double seconds = timer.elapsedSeconds();
+    std::printf("%8d %-8s %12s %10d %12.2f %12.3f\n", width, backend == MAP_SPARSE ? "sparse" : "dense",
+                getPlanStatusName(status), planner.getStats().moves, seconds * 1e3,
+                planner.getMapStorageBytes() / 1048576.0);
+}
+
+int main(int argc, char** argv) {
+    int maxWidth = (argc > 1) ? std::atoi(argv[1]) : 65536;
+    int obstacleCount = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    int denseLimit = (argc > 3) ? std::atoi(argv[3]) : 16384;
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    std::printf("%d obstacles per field\n", obstacleCount);
+    std::printf("%8s %-8s %12s %12s %12s\n", "width", "backend", "build ms", "MB", "obstacles");
+    for (int width = 1024; width <= maxWidth; width *= 4) {
+        std::vector<GridCell> cells = makeObstacles(width, obstacleCount, 5);
+        if (width <= denseLimit) {
+            benchBuild(width, MAP_DENSE, cells);
+        }
+        benchBuild(width, MAP_SPARSE, cells);
+    }
+
+    // Both maps hold the same obstacles, so their answers must agree
+    int queryWidth = (maxWidth < denseLimit) ? maxWidth : denseLimit;
+    std::vector<GridCell> cells = makeObstacles(queryWidth, obstacleCount, 5);
+    OccupancyGrid dense(queryWidth, queryWidth);
+    SparseObstacleMap sparse(queryWidth, queryWidth);
+    for (const GridCell& cell : cells) {
+        dense.markObstacle(cell.x, cell.y);
+        sparse.markObstacle(cell.x, cell.y);
+    }
+    std::printf("\nrectangle queries on a %d x %d field\n", queryWidth, queryWidth);
+    std::printf("%8s %12s %12s %10s\n", "side", "dense ns", "sparse ns", "free");
+    const int sides[] = {16, 64, 256, 1024};
+    for (int side : sides) {
+        if (side >= queryWidth) {
+            continue;
+        }
+        int denseFree = 0;
+        int sparseFree = 0;
+        double denseNs = benchQueries(dense, side, 20000, denseFree);
+        double sparseNs = benchQueries(sparse, side, 20000, sparseFree);
+        if (denseFree != sparseFree) {
+            std::fprintf(stderr, "maps disagree at side %d: %d vs %d free\n", side, denseFree, sparseFree);
+            return 1;
+        }
+        std::printf("%8d %12.1f %12.1f %10d\n", side, denseNs, sparseNs, sparseFree);
+    }
+
+    // Greedy missions check reachability every step; dense builds the full labels
+    std::printf("\ngreedy mission corner to corner\n");
+    std::printf("%8s %-8s %12s %10s %12s %12s\n", "width", "backend", "status", "moves", "mission ms", "MB");
+    for (int width = 1024; width <= maxWidth; width *= 4) {
+        std::vector<GridCell> fieldCells = makeObstacles(width, obstacleCount, 5);
+        if (width <= denseLimit / 4) {
+            benchMission(width, MAP_DENSE, fieldCells);
+        }
+        benchMission(width, MAP_SPARSE, fieldCells);
+    }
+
+    return 0;
+}
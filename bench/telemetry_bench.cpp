@@ -0,0 +1,88 @@
+// Planning-loop cost of recording a run: step-level text logging against
+// the binary telemetry stream.
+//
+// Runs the greedy planner across a random field several times with
+//   silent     - logging off, no telemetry
+//   text log   - step-level text logging written to /dev/null
+//   telemetry  - logging off, events written to a temporary file
+// and reports the wall time per run and per recorded event.
+//
+// Usage: telemetry_bench [size] [runs]
+
+#include "../src/logger.h"
+#include "../src/robot_path_planner.h"
+#include "../src/telemetry.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Output configuration of one benchmark case
+enum RecordMode {
+    RECORD_NONE,
+    RECORD_TEXT,
+    RECORD_TELEMETRY
+};
+
+// Run the planner once on a fresh field; returns the number of telemetry events
+static long long runOnce(int size, RecordMode mode, TelemetryWriter* telemetry) {
+    std::unique_ptr<RobotPathPlanner> planner(new RobotPathPlanner(0, 0, size - 1, size - 1, size, size));
+    BenchRandom random(7);
+    for (int i = 0; i < size * size / 50; i++) {
+        int x = random.nextInt(size);
+        int y = random.nextInt(size);
+        if ((x != 0 || y != 0) && (x != size - 1 || y != size - 1)) {
+            planner->markObstacle(x, y);
+        }
+    }
+    if (mode == RECORD_TELEMETRY) {
+        planner->setTelemetry(telemetry);
+    }
+    planner->setStepLimit(8 * size);
+
+    planner->initialize();
+    planner->executePlanningAlgorithm();
+    return (mode == RECORD_TELEMETRY) ? telemetry->getRecordedCount() : 0;
+}
+
+int main(int argc, char** argv) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 400;
+    int runs = (argc > 2) ? std::atoi(argv[2]) : 20;
+    const char* names[] = {"silent", "text log", "telemetry"};
+    std::string telemetryPath = "/tmp/telemetry_bench.rpt";
+
+    std::ofstream devNull("/dev/null");
+    Logger::instance().setOutput(devNull);
+
+    std::printf("%d x %d field, %d runs\n\n", size, size, runs);
+    std::printf("%-10s %12s %12s %10s\n", "mode", "us/run", "events/run", "dropped");
+
+    for (int mode = RECORD_NONE; mode <= RECORD_TELEMETRY; mode++) {
+        Logger::instance().setLevel(mode == RECORD_TEXT ? LOG_LEVEL_STEP : LOG_LEVEL_OFF);
+
+        TelemetryWriter telemetry;
+        std::string error;
+        if (mode == RECORD_TELEMETRY && !telemetry.open(telemetryPath, kRobotPathCapacity, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+
+        BenchTimer timer;
+        long long events = 0;
+        for (int run = 0; run < runs; run++) {
+            events = runOnce(size, static_cast<RecordMode>(mode), &telemetry);
+        }
+        Logger::instance().flush();
+        double micros = timer.elapsedNanoseconds() / 1e3 / runs;
+
+        telemetry.close();
+        std::printf("%-10s %12.1f %12.0f %10lld\n", names[mode], micros,
+                    static_cast<double>(events) / runs, telemetry.getDroppedCount());
+    }
+
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    std::remove(telemetryPath.c_str());
+    return 0;
+}
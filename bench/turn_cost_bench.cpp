@@ -0,0 +1,65 @@
+// Turn counts and simulated mission time of the turn-aware planner.
+//
+// Runs generated scenarios on the simulated robot with the greedy walker,
+// the shortest-path A* planner and the turn-aware planner with its default
+// cost model. Mission times come from the simulator, not from the planner's
+// own prediction.
+//
+// Usage: turn_cost_bench [scenarios] [seed]
+
+#include "../src/batch_simulation.h"
+#include "../src/logger.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Run one configuration and print its row
+static void runRow(const char* label, const std::vector<Scenario>& scenarios, const BatchOptions& options,
+                   ThreadPool& pool) {
+    BenchTimer timer;
+    std::vector<ScenarioResult> results = runScenarios(scenarios, options, pool);
+    double wallMs = timer.elapsedSeconds() * 1e3;
+    BatchSummary summary = summarizeResults(results);
+
+    double count = (summary.succeeded > 0) ? summary.succeeded : 1;
+    double moves = 0.0;
+    double turns = 0.0;
+    double mission = 0.0;
+    for (const ScenarioResult& result : results) {
+        if (result.status == SCENARIO_SUCCESS) {
+            moves += result.stats.moves;
+            turns += result.stats.turns;
+            mission += result.missionSeconds;
+        }
+    }
+    std::printf("%-10s %8d/%-4d %10.1f %10.1f %12.1f %10.1f\n", label, summary.succeeded, summary.scenarios,
+                moves / count, turns / count, mission / count, wallMs);
+}
+
+int main(int argc, char** argv) {
+    int scenarioCount = (argc > 1) ? std::atoi(argv[1]) : 100;
+    unsigned long long seed = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 7;
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    ThreadPool pool;
+
+    const int sizes[] = {20, 64, 128};
+    for (int size : sizes) {
+        // About 5% of the cells are obstacles
+        std::vector<Scenario> scenarios = generateScenarios(scenarioCount, seed, size, size, size * size / 20);
+        std::printf("%d x %d maps, %d scenarios (averages over successful runs)\n", size, size, scenarioCount);
+        std::printf("%-10s %13s %10s %10s %12s %10s\n", "planner", "success", "moves", "turns", "mission s",
+                    "wall ms");
+
+        BatchOptions options = getDefaultBatchOptions();
+        options.simulate = true;
+        options.mode = GREEDY_PLANNER;
+        runRow("greedy", scenarios, options, pool);
+        options.mode = ASTAR_PLANNER;
+        runRow("astar", scenarios, options, pool);
+        options.mode = TURN_AWARE_PLANNER;
+        runRow("turns", scenarios, options, pool);
+        std::printf("\n");
+    }
+
+    return 0;
+}
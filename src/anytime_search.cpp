@@ -0,0 +1,352 @@
+#include "anytime_search.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// Weights are kept in thousandths so keys stay integers
+static const int kEpsilonScale = 1000;
+
+// Expansions between deadline checks
+static const long long kDeadlineCheckInterval = 64;
+
+// Get the sign of a value
+static int signOf(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// Constructor (weights are clamped to at least 1)
+AnytimeSearch::AnytimeSearch(const OccupancyGrid& map, int allowed_moves, double initial_epsilon,
+                             double epsilon_step) :
+    grid(map), allowedMoves(allowed_moves),
+    initialEpsilon(std::max(kEpsilonScale, static_cast<int>(std::lround(initial_epsilon * kEpsilonScale)))),
+    epsilonStep(std::max(1, static_cast<int>(std::lround(epsilon_step * kEpsilonScale)))),
+    epsilon(initialEpsilon), searchStamp(0), roundStamp(0), startX(0), startY(0), goalX(0), goalY(0),
+    started(false), keysStale(false), roundDone(false), bound(std::numeric_limits<double>::infinity()),
+    expansions(0), rounds(0) {}
+
+// Set the allowed moves (the next improve needs a new start)
+void AnytimeSearch::setAllowedMoves(int allowed_moves) {
+    allowedMoves = allowed_moves;
+    started = false;
+}
+
+// Heuristic distance from (x, y) to the robot
+int AnytimeSearch::heuristic(int x, int y) const {
+    // Manhattan distance is exact on an empty 4-connected grid
+    return std::abs(startX - x) + std::abs(startY - y);
+}
+
+// Priority of a cell with the current epsilon and start
+int64_t AnytimeSearch::keyOf(int cell) const {
+    // Order by g + epsilon * h, breaking ties towards the robot
+    int h = heuristic(cell % grid.getWidth(), cell / grid.getWidth());
+    int64_t f = static_cast<int64_t>(g[cell]) * kEpsilonScale + static_cast<int64_t>(epsilon) * h;
+    return (f << 20) | static_cast<int64_t>(std::min(h, (1 << 20) - 1));
+}
+
+// Recompute every open key
+void AnytimeSearch::rekeyOpenSet() {
+    scratch.clear();
+    for (int i = 0; i < openSet.getSize(); i++) {
+        scratch.push_back(openSet.cellAt(i));
+    }
+    openSet.clear();
+    for (int cell : scratch) {
+        openSet.push(cell, keyOf(cell));
+    }
+}
+
+// Start a search from scratch for a route from start to destination
+bool AnytimeSearch::start(int start_x, int start_y, int dest_x, int dest_y) {
+    started = false;
+    waypoints.clear();
+    bound = std::numeric_limits<double>::infinity();
+    expansions = 0;
+    rounds = 0;
+
+    // Both endpoints must be free cells on the map
+    if (grid.isObstacleDetected(start_x, start_y) || grid.isObstacleDetected(dest_x, dest_y)) {
+        return false;
+    }
+    startX = start_x;
+    startY = start_y;
+    goalX = dest_x;
+    goalY = dest_y;
+
+    // Size the per-cell state on first use or when the map changes size
+    size_t cellCount = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+    if (stamp.size() != cellCount) {
+        g.assign(cellCount, 0);
+        stamp.assign(cellCount, 0);
+        closed.assign(cellCount, 0);
+        queued.assign(cellCount, 0);
+        searchStamp = 0;
+        roundStamp = 0;
+    }
+
+    // New stamps invalidate the previous search and close no cell, without clearing
+    searchStamp++;
+    roundStamp++;
+    if (searchStamp == 0 || roundStamp == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        std::fill(closed.begin(), closed.end(), 0);
+        std::fill(queued.begin(), queued.end(), 0);
+        searchStamp = 1;
+        roundStamp = 1;
+    }
+    openSet.reset(static_cast<int>(cellCount));
+    inconsistent.clear();
+
+    // The search grows from the destination towards the robot
+    epsilon = initialEpsilon;
+    int root = indexOf(goalX, goalY);
+    stamp[root] = searchStamp;
+    g[root] = 0;
+    openSet.push(root, keyOf(root));
+    started = true;
+    keysStale = false;
+    roundDone = false;
+    return true;
+}
+
+// Drop the search state so the next search starts from scratch
+void AnytimeSearch::reset() {
+    started = false;
+}
+
+// Check if a search is under way
+bool AnytimeSearch::isStarted() const {
+    return started;
+}
+
+// Update the robot position after it moved along the route
+//
+// Costs to the destination do not depend on where the robot is, so only
+// the open keys and the round's stopping test change.
+void AnytimeSearch::moveStart(int x, int y) {
+    if (!started || (x == startX && y == startY)) {
+        return;
+    }
+    startX = x;
+    startY = y;
+    keysStale = true;
+    roundDone = false;
+}
+
+// Expand cells until the robot's route is within epsilon or the deadline passes; false on timeout
+bool AnytimeSearch::improveRound(bool hasDeadline, std::chrono::steady_clock::time_point deadline) {
+    int robot = indexOf(startX, startY);
+    while (!openSet.isEmpty()) {
+        // The round ends once no open cell can lead to a shorter weighted route
+        int robotCost = getCost(robot);
+        if (robotCost >= 0 && (static_cast<int64_t>(robotCost) * kEpsilonScale << 20) <= openSet.topKey()) {
+            break;
+        }
+        if (hasDeadline && expansions % kDeadlineCheckInterval == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+
+        int cell = openSet.pop();
+        closed[cell] = roundStamp;
+        expansions++;
+        int x = cell % grid.getWidth();
+        int y = cell / grid.getWidth();
+        int next = g[cell] + 1;
+
+        // Reach the cells the robot could step into this one from
+        for (int i = 0; i < kAxisMoveCount; i++) {
+            if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+                continue;
+            }
+            int px = x - kAxisMoves[i].dx;
+            int py = y - kAxisMoves[i].dy;
+            if (grid.isObstacleDetected(px, py)) {
+                continue;
+            }
+            int predecessor = indexOf(px, py);
+            int cost = getCost(predecessor);
+            if (cost >= 0 && cost <= next) {
+                continue;
+            }
+            stamp[predecessor] = searchStamp;
+            g[predecessor] = next;
+
+            // A cell already expanded this round waits for the next one
+            if (closed[predecessor] != roundStamp) {
+                openSet.push(predecessor, keyOf(predecessor));
+            } else if (queued[predecessor] != roundStamp) {
+                queued[predecessor] = roundStamp;
+                inconsistent.push_back(predecessor);
+            }
+        }
+    }
+    return true;
+}
+
+// Recompute the bound and the waypoints of the best route
+void AnytimeSearch::publishRoute() {
+    waypoints.clear();
+    int length = getPathLength();
+    if (length < 0) {
+        bound = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    // No route can be shorter than the best g + h among the cells still to expand
+    int64_t lowerBound = std::numeric_limits<int64_t>::max();
+    for (int i = 0; i < openSet.getSize(); i++) {
+        int cell = openSet.cellAt(i);
+        lowerBound = std::min(lowerBound, static_cast<int64_t>(g[cell]) +
+                                              heuristic(cell % grid.getWidth(), cell / grid.getWidth()));
+    }
+    for (int cell : inconsistent) {
+        lowerBound = std::min(lowerBound, static_cast<int64_t>(g[cell]) +
+                                              heuristic(cell % grid.getWidth(), cell / grid.getWidth()));
+    }
+    bound = 1.0;
+    if (length > 0 && lowerBound < length) {
+        bound = static_cast<double>(length) / static_cast<double>(std::max<int64_t>(lowerBound, 1));
+    }
+    if (roundDone) {
+        bound = std::min(bound, static_cast<double>(epsilon) / kEpsilonScale);
+    }
+
+    // Follow the falling costs to the destination
+    std::vector<GridCell> route(1, GridCell{startX, startY});
+    int cost = length;
+    while (cost > 0) {
+        GridCell cell = route.back();
+        GridCell next = cell;
+        for (int i = 0; i < kAxisMoveCount; i++) {
+            int nx = cell.x + kAxisMoves[i].dx;
+            int ny = cell.y + kAxisMoves[i].dy;
+            if ((allowedMoves & kAxisMoves[i].flag) == 0 || grid.isObstacleDetected(nx, ny)) {
+                continue;
+            }
+            int neighbourCost = getCost(indexOf(nx, ny));
+            if (neighbourCost >= 0 && neighbourCost < cost) {
+                cost = neighbourCost;
+                next.x = nx;
+                next.y = ny;
+            }
+        }
+        if (next.x == cell.x && next.y == cell.y) {
+            break;
+        }
+        route.push_back(next);
+    }
+
+    // Keep the start, every cell where the heading changes and the destination
+    int last = static_cast<int>(route.size()) - 1;
+    for (int i = 0; i <= last; i++) {
+        if (i == 0 || i == last) {
+            waypoints.push_back(route[i]);
+            continue;
+        }
+        int inX = signOf(route[i].x - route[i - 1].x);
+        int inY = signOf(route[i].y - route[i - 1].y);
+        int outX = signOf(route[i + 1].x - route[i].x);
+        int outY = signOf(route[i + 1].y - route[i].y);
+        if (inX != outX || inY != outY) {
+            waypoints.push_back(route[i]);
+        }
+    }
+}
+
+// Search until the route is optimal or seconds have passed (0 for no deadline); returns true if a route is known
+bool AnytimeSearch::improve(double seconds) {
+    if (!started) {
+        return false;
+    }
+    bool hasDeadline = seconds > 0.0;
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+    while (!isComplete()) {
+        if (roundDone) {
+            // Next round: lower the weight and reopen the cells improved after their expansion
+            epsilon = std::max(kEpsilonScale, epsilon - epsilonStep);
+            roundStamp++;
+            if (roundStamp == 0) {
+                std::fill(closed.begin(), closed.end(), 0);
+                std::fill(queued.begin(), queued.end(), 0);
+                roundStamp = 1;
+            }
+            for (int cell : inconsistent) {
+                openSet.push(cell, 0);
+            }
+            inconsistent.clear();
+            keysStale = true;
+            roundDone = false;
+        }
+        if (keysStale) {
+            rekeyOpenSet();
+            keysStale = false;
+        }
+
+        if (!improveRound(hasDeadline, deadline)) {
+            break;
+        }
+        roundDone = true;
+        rounds++;
+        if (hasDeadline && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    publishRoute();
+    return getPathLength() >= 0;
+}
+
+// Check if there is nothing left to improve (the route is optimal or none exists)
+bool AnytimeSearch::isComplete() const {
+    return started && roundDone && (epsilon == kEpsilonScale || (openSet.isEmpty() && inconsistent.empty()));
+}
+
+// Get the best next cell for the robot (false if no route is known)
+bool AnytimeSearch::getNextStep(int& nextX, int& nextY) const {
+    if (waypoints.size() < 2) {
+        return false;
+    }
+    nextX = startX + signOf(waypoints[1].x - startX);
+    nextY = startY + signOf(waypoints[1].y - startY);
+    return true;
+}
+
+// Get the length of the best route from the robot (-1 if none is known)
+int AnytimeSearch::getPathLength() const {
+    return started ? getCost(indexOf(startX, startY)) : -1;
+}
+
+// Get the bound on the best route's length over the shortest one (1 when optimal, infinite if none is known)
+double AnytimeSearch::getSuboptimalityBound() const {
+    return bound;
+}
+
+// Get the heuristic weight of the current round
+double AnytimeSearch::getEpsilon() const {
+    return static_cast<double>(epsilon) / kEpsilonScale;
+}
+
+// Get the waypoints of the best route (start, turning cells, destination)
+const std::vector<GridCell>& AnytimeSearch::getWaypoints() const {
+    return waypoints;
+}
+
+// Write the best route into a list as START_LOCATION/TURNING_NODE waypoints
+bool AnytimeSearch::buildPath(DoublyLinkedList& out) const {
+    return buildWaypointList(waypoints, out);
+}
+
+// Get the number of cells expanded since start
+long long AnytimeSearch::getExpansions() const {
+    return expansions;
+}
+
+// Get the number of rounds finished since start
+int AnytimeSearch::getRounds() const {
+    return rounds;
+}
@@ -0,0 +1,131 @@
+#ifndef ANYTIME_SEARCH_H
+#define ANYTIME_SEARCH_H
+
+#include "doubly_linked_list.h"
+#include "grid_search.h"
+#include "indexed_min_heap.h"
+#include "occupancy_grid.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Time-budgeted shortest-path search (ARA*)
+//
+// Runs a series of weighted A* rounds whose heuristic weight epsilon
+// shrinks towards 1, reusing the work of earlier rounds. Each improve call
+// searches until its deadline and then returns, so the best route found
+// so far is always available and later calls keep refining it. The
+// search runs backwards from the destination: every reached cell holds
+// the length of a real route to the destination, so the robot can move
+// along the route (moveStart) without losing the search. The reported
+// suboptimality bound is the route length over a lower bound taken from
+// the cells still waiting to be expanded.
+class AnytimeSearch {
+private:
+    const OccupancyGrid& grid;      // Map being searched
+    int allowedMoves;               // MoveSet flags usable by the robot
+    int initialEpsilon;             // Heuristic weights in thousandths
+    int epsilonStep;
+    int epsilon;                    // Weight of the current round
+
+    // Per-cell search state, valid only where stamp matches searchStamp
+    std::vector<int> g;             // Route length to the destination
+    std::vector<uint32_t> stamp;    // Search in which the cell was reached
+    std::vector<uint32_t> closed;   // Round in which the cell was last expanded
+    std::vector<uint32_t> queued;   // Round in which the cell was last put on the inconsistent list
+    uint32_t searchStamp;           // Current search number
+    uint32_t roundStamp;            // Current round number (never reset, so closed needs no clearing)
+
+    IndexedMinHeap<int64_t> openSet;    // Cells keyed by g + epsilon * h, then h
+    std::vector<int> inconsistent;      // Cells improved after their expansion this round
+    std::vector<int> scratch;           // Cells being rekeyed
+    std::vector<GridCell> waypoints;    // Start, turning cells and destination of the best route
+
+    int startX;                     // Robot position (the search target)
+    int startY;
+    int goalX;                      // Destination (the search root)
+    int goalY;
+    bool started;
+    bool keysStale;                 // Open keys were computed for another epsilon or start
+    bool roundDone;                 // The current round has finished
+    double bound;                   // Suboptimality bound of the best route
+    long long expansions;           // Cells expanded since start
+    int rounds;                     // Rounds finished since start
+
+    // Get the cell index of (x, y)
+    int indexOf(int x, int y) const {
+        return y * grid.getWidth() + x;
+    }
+
+    // Get the route length of a cell (-1 if not reached)
+    int getCost(int cell) const {
+        return (stamp[cell] == searchStamp) ? g[cell] : -1;
+    }
+
+    // Heuristic distance from (x, y) to the robot
+    int heuristic(int x, int y) const;
+
+    // Priority of a cell with the current epsilon and start
+    int64_t keyOf(int cell) const;
+
+    // Recompute every open key
+    void rekeyOpenSet();
+
+    // Expand cells until the robot's route is within epsilon or the deadline passes; false on timeout
+    bool improveRound(bool hasDeadline, std::chrono::steady_clock::time_point deadline);
+
+    // Recompute the bound and the waypoints of the best route
+    void publishRoute();
+
+public:
+    // Constructor (weights are clamped to at least 1)
+    AnytimeSearch(const OccupancyGrid& map, int allowed_moves = MOVES_ALL, double initial_epsilon = 2.0,
+                  double epsilon_step = 0.2);
+
+    // Set the allowed moves (the next improve needs a new start)
+    void setAllowedMoves(int allowed_moves);
+
+    // Start a search from scratch for a route from start to destination
+    bool start(int start_x, int start_y, int dest_x, int dest_y);
+
+    // Drop the search state so the next search starts from scratch
+    void reset();
+
+    // Check if a search is under way
+    bool isStarted() const;
+
+    // Update the robot position after it moved along the route
+    void moveStart(int x, int y);
+
+    // Search until the route is optimal or seconds have passed (0 for no deadline); returns true if a route is known
+    bool improve(double seconds);
+
+    // Check if there is nothing left to improve (the route is optimal or none exists)
+    bool isComplete() const;
+
+    // Get the best next cell for the robot (false if no route is known)
+    bool getNextStep(int& nextX, int& nextY) const;
+
+    // Get the length of the best route from the robot (-1 if none is known)
+    int getPathLength() const;
+
+    // Get the bound on the best route's length over the shortest one (1 when optimal, infinite if none is known)
+    double getSuboptimalityBound() const;
+
+    // Get the heuristic weight of the current round
+    double getEpsilon() const;
+
+    // Get the waypoints of the best route (start, turning cells, destination)
+    const std::vector<GridCell>& getWaypoints() const;
+
+    // Write the best route into a list as START_LOCATION/TURNING_NODE waypoints
+    bool buildPath(DoublyLinkedList& out) const;
+
+    // Get the number of cells expanded since start
+    long long getExpansions() const;
+
+    // Get the number of rounds finished since start
+    int getRounds() const;
+};
+
+#endif // ANYTIME_SEARCH_H
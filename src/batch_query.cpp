@@ -0,0 +1,116 @@
+#include "batch_query.h"
+#include <algorithm>
+#include <unordered_map>
+
+// Queries handed to one task (large enough to amortize creating a context)
+static const size_t kQueriesPerTask = 64;
+
+// Constructor
+MapQueryContext::MapQueryContext(const SharedMap& shared_map, SearchMode search_mode) :
+    map(shared_map), search(shared_map.getGrid(), shared_map.getAllowedMoves(), search_mode) {}
+
+// Answer a query, looking it up in field when one is given for its destination
+QueryResult MapQueryContext::query(const PathQuery& request, const DistanceField* field) {
+    QueryResult result = {QUERY_INVALID, QUERY_FROM_LABELS, -1};
+    const OccupancyGrid& grid = map.getGrid();
+    if (grid.isObstacleDetected(request.startX, request.startY) ||
+        grid.isObstacleDetected(request.destX, request.destY)) {
+        return result;
+    }
+
+    // Different components (or a move the drivetrain lacks) rule out any route
+    if (!map.mayConnect(request.startX, request.startY, request.destX, request.destY)) {
+        result.status = QUERY_UNREACHABLE;
+        return result;
+    }
+
+    if (field != nullptr && field->getDestX() == request.destX && field->getDestY() == request.destY) {
+        result.source = QUERY_FROM_FIELD;
+        result.distance = field->getDistance(request.startX, request.startY);
+    } else {
+        result.source = QUERY_FROM_SEARCH;
+        if (search.findPath(request.startX, request.startY, request.destX, request.destY)) {
+            result.distance = search.getPathLength();
+        }
+    }
+    result.status = (result.distance >= 0) ? QUERY_REACHABLE : QUERY_UNREACHABLE;
+    return result;
+}
+
+// Answer every query on the pool; results are stored in query order
+std::vector<QueryResult> runBatchQueries(const SharedMap& map, const std::vector<PathQuery>& queries,
+                                         ThreadPool& pool, int field_min_queries, BatchQueryStats* stats) {
+    std::vector<QueryResult> results(queries.size());
+    const OccupancyGrid& grid = map.getGrid();
+
+    // Count the queries per destination cell
+    std::unordered_map<long long, int> destinationCounts;
+    for (const PathQuery& request : queries) {
+        if (grid.isInBounds(request.destX, request.destY)) {
+            destinationCounts[static_cast<long long>(request.destY) * grid.getWidth() + request.destX]++;
+        }
+    }
+
+    // Popular destinations get a field slot, in order of first appearance so the layout is deterministic
+    std::unordered_map<long long, int> fieldSlots;
+    std::vector<GridCell> fieldDestinations;
+    for (const PathQuery& request : queries) {
+        if (!grid.isInBounds(request.destX, request.destY)) {
+            continue;
+        }
+        long long cell = static_cast<long long>(request.destY) * grid.getWidth() + request.destX;
+        if (destinationCounts[cell] >= field_min_queries && fieldSlots.find(cell) == fieldSlots.end()) {
+            fieldSlots[cell] = static_cast<int>(fieldDestinations.size());
+            GridCell destination = {request.destX, request.destY};
+            fieldDestinations.push_back(destination);
+        }
+    }
+
+    // Build the fields in parallel; each task owns its slot
+    std::vector<DistanceField> fields(fieldDestinations.size());
+    for (size_t i = 0; i < fieldDestinations.size(); i++) {
+        pool.submit([&map, &fields, &fieldDestinations, i] {
+            map.buildDistanceField(fieldDestinations[i].x, fieldDestinations[i].y, fields[i]);
+        });
+    }
+    pool.wait();
+
+    // Answer the queries in chunks, one context per chunk
+    std::vector<const DistanceField*> queryFields(queries.size(), nullptr);
+    for (size_t i = 0; i < queries.size(); i++) {
+        const PathQuery& request = queries[i];
+        if (grid.isInBounds(request.destX, request.destY)) {
+            std::unordered_map<long long, int>::const_iterator slot =
+                fieldSlots.find(static_cast<long long>(request.destY) * grid.getWidth() + request.destX);
+            if (slot != fieldSlots.end()) {
+                queryFields[i] = &fields[slot->second];
+            }
+        }
+    }
+    for (size_t first = 0; first < queries.size(); first += kQueriesPerTask) {
+        size_t last = std::min(queries.size(), first + kQueriesPerTask);
+        pool.submit([&map, &queries, &queryFields, &results, first, last] {
+            MapQueryContext context(map);
+            for (size_t i = first; i < last; i++) {
+                results[i] = context.query(queries[i], queryFields[i]);
+            }
+        });
+    }
+    pool.wait();
+
+    if (stats != nullptr) {
+        BatchQueryStats totals = {static_cast<int>(queries.size()), static_cast<int>(fields.size()), 0, 0, 0};
+        for (const QueryResult& result : results) {
+            if (result.source == QUERY_FROM_FIELD) {
+                totals.fieldAnswers++;
+            } else if (result.source == QUERY_FROM_SEARCH) {
+                totals.searches++;
+            } else {
+                totals.rejected++;
+            }
+        }
+        *stats = totals;
+    }
+
+    return results;
+}
@@ -0,0 +1,73 @@
+#ifndef BATCH_QUERY_H
+#define BATCH_QUERY_H
+
+#include "grid_search.h"
+#include "shared_map.h"
+#include "thread_pool.h"
+#include <vector>
+
+// One "how far from start to destination" question
+struct PathQuery {
+    int startX;
+    int startY;
+    int destX;
+    int destY;
+};
+
+// Outcome of a query
+enum QueryStatus {
+    QUERY_REACHABLE,    // A route exists; distance holds its length
+    QUERY_UNREACHABLE,  // Both endpoints are free but no route connects them
+    QUERY_INVALID       // An endpoint is blocked or outside the map
+};
+
+// How a query was answered
+enum QuerySource {
+    QUERY_FROM_LABELS,  // Rejected by the component labels without a search
+    QUERY_FROM_FIELD,   // Looked up in a destination distance field
+    QUERY_FROM_SEARCH   // Answered by a grid search
+};
+
+// Answer to one query
+struct QueryResult {
+    QueryStatus status;
+    QuerySource source;
+    int distance;       // Steps on the shortest route (-1 unless reachable)
+};
+
+// Work done by a batch
+struct BatchQueryStats {
+    int queries;
+    int fieldsBuilt;        // Destination distance fields computed
+    int fieldAnswers;       // Queries answered from a distance field
+    int searches;           // Queries answered by a grid search
+    int rejected;           // Queries settled by the endpoint checks and labels
+};
+
+// Per-thread query state over a shared map
+//
+// The map is only read; the search scratch arrays belong to the context,
+// so every thread answering queries needs its own context.
+class MapQueryContext {
+private:
+    const SharedMap& map;       // Shared obstacles and labels
+    GridSearch search;          // Scratch state for searches
+
+public:
+    // Constructor
+    explicit MapQueryContext(const SharedMap& shared_map, SearchMode search_mode = SEARCH_JUMP_POINT);
+
+    // Answer a query, looking it up in field when one is given for its destination
+    QueryResult query(const PathQuery& request, const DistanceField* field = nullptr);
+};
+
+// Answer every query on the pool; results are stored in query order
+//
+// Destinations shared by at least field_min_queries queries get a distance
+// field, built once and then read by all of their queries. The rest are
+// answered by searches. Results do not depend on the thread count.
+std::vector<QueryResult> runBatchQueries(const SharedMap& map, const std::vector<PathQuery>& queries,
+                                         ThreadPool& pool, int field_min_queries = 3,
+                                         BatchQueryStats* stats = nullptr);
+
+#endif // BATCH_QUERY_H
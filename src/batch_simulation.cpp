@@ -0,0 +1,281 @@
+#include "batch_simulation.h"
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+// Get batch options with the planner defaults (greedy, no simulation)
+BatchOptions getDefaultBatchOptions() {
+    BatchOptions options;
+    options.mode = GREEDY_PLANNER;
+    options.stepLimit = 0;
+    options.timeLimit = 0.0;
+    options.simulate = false;
+    options.simulation = getDefaultSimulationConfig();
+    options.driveRpm = 10.0;
+    options.pathCache = nullptr;
+    options.turnCost = getDefaultTurnCostModel();
+    options.allowedMoves = MOVES_NORTH_EAST;
+    options.mapBackend = MAP_DENSE;
+    return options;
+}
+
+// Get the printable name of a scenario status
+const char* getScenarioStatusName(ScenarioStatus status) {
+    switch (status) {
+        case SCENARIO_SUCCESS:
+            return "success";
+        case SCENARIO_TIMEOUT:
+            return "timeout";
+        case SCENARIO_FAILED:
+            return "failed";
+    }
+    return "unknown";
+}
+
+// Parse a scenario file; returns false and sets error on the first bad line
+bool parseScenarios(std::istream& in, std::vector<Scenario>& scenarios, std::string& error) {
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+
+        // Skip blank lines and comments
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        Scenario scenario;
+        if (!(fields >> scenario.startX >> scenario.startY >> scenario.destX >> scenario.destY
+                     >> scenario.width >> scenario.height)) {
+            error = "line " + std::to_string(lineNumber) + ": expected start, destination and map size";
+            return false;
+        }
+        if (scenario.width <= 0 || scenario.height <= 0) {
+            error = "line " + std::to_string(lineNumber) + ": map size must be positive";
+            return false;
+        }
+
+        // Remaining fields are obstacles written as x,y
+        std::string token;
+        while (fields >> token) {
+            GridCell cell;
+            char comma = 0;
+            std::istringstream pair(token);
+            if (!(pair >> cell.x >> comma >> cell.y) || comma != ',') {
+                error = "line " + std::to_string(lineNumber) + ": bad obstacle '" + token + "'";
+                return false;
+            }
+            scenario.obstacles.push_back(cell);
+        }
+
+        scenarios.push_back(scenario);
+    }
+
+    return true;
+}
+
+// Write scenarios in the format read by parseScenarios
+void writeScenarios(std::ostream& out, const std::vector<Scenario>& scenarios) {
+    out << "# startX startY destX destY width height [obstacleX,obstacleY ...]\n";
+    for (const Scenario& scenario : scenarios) {
+        out << scenario.startX << ' ' << scenario.startY << ' ' << scenario.destX << ' ' << scenario.destY
+            << ' ' << scenario.width << ' ' << scenario.height;
+        for (const GridCell& cell : scenario.obstacles) {
+            out << ' ' << cell.x << ',' << cell.y;
+        }
+        out << '\n';
+    }
+}
+
+// Next value of a splitmix64 sequence (same on every platform, unlike <random> distributions)
+static unsigned long long nextRandom(unsigned long long& state) {
+    state += 0x9E3779B97F4A7C15ull;
+    unsigned long long z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Generate random scenarios from a seed
+std::vector<Scenario> generateScenarios(int count, unsigned long long seed, int width, int height,
+                                        int obstacle_count) {
+    std::vector<Scenario> scenarios;
+    unsigned long long state = seed;
+
+    for (int i = 0; i < count; i++) {
+        // The default drivetrain only moves NORTH and EAST, so the destination lies up and right
+        Scenario scenario;
+        scenario.width = width;
+        scenario.height = height;
+        scenario.startX = static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(width / 2));
+        scenario.startY = static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(height / 2));
+        scenario.destX = width / 2 + static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(width - width / 2));
+        scenario.destY = height / 2 + static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(height - height / 2));
+
+        for (int j = 0; j < obstacle_count; j++) {
+            GridCell cell;
+            cell.x = static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(width));
+            cell.y = static_cast<int>(nextRandom(state) % static_cast<unsigned long long>(height));
+            bool onEndpoint = (cell.x == scenario.startX && cell.y == scenario.startY) ||
+                              (cell.x == scenario.destX && cell.y == scenario.destY);
+            if (!onEndpoint) {
+                scenario.obstacles.push_back(cell);
+            }
+        }
+
+        scenarios.push_back(scenario);
+    }
+
+    return scenarios;
+}
+
+// Run one scenario to completion or to the step limit
+ScenarioResult runScenario(const Scenario& scenario, const BatchOptions& options) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    FixedRobotPathPlanner planner(scenario.startX, scenario.startY, scenario.destX, scenario.destY,
+                                  scenario.width, scenario.height, options.mapBackend);
+    planner.setPlannerMode(options.mode);
+    planner.setPathCache(options.pathCache);
+    planner.setTurnCostModel(options.turnCost);
+    planner.setAllowedMoves(options.allowedMoves);
+    planner.setStepLimit(options.stepLimit > 0 ? options.stepLimit : 4 * (scenario.width + scenario.height));
+    planner.setTimeLimit(options.timeLimit);
+    for (const GridCell& cell : scenario.obstacles) {
+        planner.markObstacle(cell.x, cell.y);
+    }
+
+    // The simulator runs on a virtual clock, so the mission time is deterministic
+    SimulatedHardware hardware(options.simulation);
+    if (options.simulate) {
+        planner.setHardware(&hardware);
+        planner.setDriveVelocity(options.driveRpm);
+    }
+
+    planner.initialize();
+    PlanStatus status = planner.executePlanningAlgorithm();
+
+    ScenarioResult result;
+    result.stats = planner.getStats();
+    if (status == PLAN_SUCCESS) {
+        result.status = SCENARIO_SUCCESS;
+    } else if (status == PLAN_STEP_LIMIT || status == PLAN_TIME_LIMIT) {
+        result.status = SCENARIO_TIMEOUT;
+    } else {
+        result.status = SCENARIO_FAILED;
+    }
+    result.finalPathSize = planner.getPath().getSize();
+    result.segmentCount = planner.getSegmentPath().getSegmentCount();
+    result.missionSeconds = hardware.getTime();
+    result.wallMicros = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+// Run all scenarios on the pool; results are stored in scenario order
+std::vector<ScenarioResult> runScenarios(const std::vector<Scenario>& scenarios, const BatchOptions& options,
+                                         ThreadPool& pool) {
+    std::vector<ScenarioResult> results(scenarios.size());
+
+    // Each task owns one result slot, so the output does not depend on scheduling
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        pool.submit([&scenarios, &results, &options, i] {
+            results[i] = runScenario(scenarios[i], options);
+        });
+    }
+    pool.wait();
+
+    return results;
+}
+
+// Add up the results of a batch
+BatchSummary summarizeResults(const std::vector<ScenarioResult>& results) {
+    BatchSummary summary = {0, 0, 0, 0, 0, 0, 0, 0.0};
+    for (const ScenarioResult& result : results) {
+        summary.scenarios++;
+        if (result.status == SCENARIO_SUCCESS) {
+            summary.succeeded++;
+        } else if (result.status == SCENARIO_TIMEOUT) {
+            summary.timedOut++;
+        } else {
+            summary.failed++;
+        }
+        summary.moves += result.stats.moves;
+        summary.turns += result.stats.turns;
+        summary.compactions += result.stats.compactions;
+        summary.missionSeconds += result.missionSeconds;
+    }
+    return summary;
+}
+
+// Write results as CSV (mission and wall time only when requested)
+void writeResultsCsv(std::ostream& out, const std::vector<ScenarioResult>& results, bool include_mission,
+                     bool include_timing) {
+    out << "scenario,status,path_length,turns,compactions,removed_nodes,final_path_size,segments";
+    if (include_mission) {
+        out << ",mission_s";
+    }
+    if (include_timing) {
+        out << ",wall_us";
+    }
+    out << '\n';
+
+    char number[32];
+    for (size_t i = 0; i < results.size(); i++) {
+        const ScenarioResult& result = results[i];
+        out << i << ',' << getScenarioStatusName(result.status) << ',' << result.stats.moves << ','
+            << result.stats.turns << ',' << result.stats.compactions << ',' << result.stats.removedNodes
+            << ',' << result.finalPathSize << ',' << result.segmentCount;
+        if (include_mission) {
+            std::snprintf(number, sizeof(number), "%.3f", result.missionSeconds);
+            out << ',' << number;
+        }
+        if (include_timing) {
+            std::snprintf(number, sizeof(number), "%.2f", result.wallMicros);
+            out << ',' << number;
+        }
+        out << '\n';
+    }
+}
+
+// Write results and their summary as JSON (mission and wall time only when requested)
+void writeResultsJson(std::ostream& out, const std::vector<ScenarioResult>& results, bool include_mission,
+                      bool include_timing) {
+    BatchSummary summary = summarizeResults(results);
+    char number[32];
+    out << "{\n  \"summary\": {\"scenarios\": " << summary.scenarios
+        << ", \"success\": " << summary.succeeded << ", \"timeout\": " << summary.timedOut
+        << ", \"failed\": " << summary.failed << ", \"moves\": " << summary.moves
+        << ", \"turns\": " << summary.turns << ", \"compactions\": " << summary.compactions;
+    if (include_mission) {
+        std::snprintf(number, sizeof(number), "%.3f", summary.missionSeconds);
+        out << ", \"mission_s\": " << number;
+    }
+    out << "},\n";
+    out << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const ScenarioResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"scenario\": " << i << ", \"status\": \"" << getScenarioStatusName(result.status)
+            << "\", \"path_length\": " << result.stats.moves << ", \"turns\": " << result.stats.turns
+            << ", \"compactions\": " << result.stats.compactions
+            << ", \"removed_nodes\": " << result.stats.removedNodes
+            << ", \"final_path_size\": " << result.finalPathSize << ", \"segments\": " << result.segmentCount;
+        if (include_mission) {
+            std::snprintf(number, sizeof(number), "%.3f", result.missionSeconds);
+            out << ", \"mission_s\": " << number;
+        }
+        if (include_timing) {
+            std::snprintf(number, sizeof(number), "%.2f", result.wallMicros);
+            out << ", \"wall_us\": " << number;
+        }
+        out << '}';
+    }
+
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,104 @@
+#ifndef BATCH_SIMULATION_H
+#define BATCH_SIMULATION_H
+
+#include "path_cache.h"
+#include "robot_path_planner.h"
+#include "simulated_hardware.h"
+#include "thread_pool.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One start/destination/obstacle scenario
+struct Scenario {
+    int startX;
+    int startY;
+    int destX;
+    int destY;
+    int width;
+    int height;
+    std::vector<GridCell> obstacles;
+};
+
+// Settings shared by every run of a batch
+struct BatchOptions {
+    PlannerMode mode;               // Planner used for every scenario
+    int stepLimit;                  // Moves before a timeout (0 picks 4 * (width + height))
+    double timeLimit;               // Wall seconds before a timeout (0 for none; not deterministic)
+    bool simulate;                  // Drive SimulatedHardware and record the mission time
+    SimulationConfig simulation;    // Robot model used when simulating
+    double driveRpm;                // Drivetrain velocity when simulating
+    PathCache* pathCache;           // Routes shared by all runs (nullptr for none)
+    TurnCostModel turnCost;         // Costs weighed by the turn-aware planner
+    int allowedMoves;               // MoveSet flags of the drivetrain
+    MapBackend mapBackend;          // Obstacle storage of each planner
+};
+
+// Get batch options with the planner defaults (greedy, no simulation)
+BatchOptions getDefaultBatchOptions();
+
+// Outcome of one scenario
+enum ScenarioStatus {
+    SCENARIO_SUCCESS,   // Destination reached
+    SCENARIO_TIMEOUT,   // Step or time limit reached first
+    SCENARIO_FAILED     // Destination unreachable or outside the map
+};
+
+// Result of one scenario run
+struct ScenarioResult {
+    ScenarioStatus status;
+    PlannerStats stats;     // Moves, turns and compactions
+    int finalPathSize;      // Nodes left in the compacted path
+    int segmentCount;       // Straight runs in the driven route
+    double missionSeconds;  // Simulated mission time (0 without simulation)
+    double wallMicros;      // Wall time of the run (not deterministic)
+};
+
+// Totals over a batch
+struct BatchSummary {
+    int scenarios;
+    int succeeded;
+    int timedOut;
+    int failed;
+    long long moves;
+    long long turns;
+    long long compactions;
+    double missionSeconds;
+};
+
+// Get the printable name of a scenario status
+const char* getScenarioStatusName(ScenarioStatus status);
+
+// Parse a scenario file; returns false and sets error on the first bad line
+//
+// One scenario per line: "startX startY destX destY width height [x,y ...]".
+// Blank lines and lines starting with '#' are skipped.
+bool parseScenarios(std::istream& in, std::vector<Scenario>& scenarios, std::string& error);
+
+// Write scenarios in the format read by parseScenarios
+void writeScenarios(std::ostream& out, const std::vector<Scenario>& scenarios);
+
+// Generate random scenarios from a seed
+std::vector<Scenario> generateScenarios(int count, unsigned long long seed, int width, int height,
+                                        int obstacle_count);
+
+// Run one scenario to completion or to the step limit
+ScenarioResult runScenario(const Scenario& scenario, const BatchOptions& options);
+
+// Run all scenarios on the pool; results are stored in scenario order
+std::vector<ScenarioResult> runScenarios(const std::vector<Scenario>& scenarios, const BatchOptions& options,
+                                         ThreadPool& pool);
+
+// Add up the results of a batch
+BatchSummary summarizeResults(const std::vector<ScenarioResult>& results);
+
+// Write results as CSV (mission and wall time only when requested)
+void writeResultsCsv(std::ostream& out, const std::vector<ScenarioResult>& results, bool include_mission,
+                     bool include_timing);
+
+// Write results and their summary as JSON (mission and wall time only when requested)
+void writeResultsJson(std::ostream& out, const std::vector<ScenarioResult>& results, bool include_mission,
+                      bool include_timing);
+
+#endif // BATCH_SIMULATION_H
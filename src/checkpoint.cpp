@@ -0,0 +1,272 @@
+#include "checkpoint.h"
+#include "map_file.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+// Check that the host stores integers the way the file does
+bool isLittleEndianHost() {
+    const uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Get the number of 64-bit words the grid payload of a checkpoint holds
+uint64_t getPayloadWords(const CheckpointHeader& header) {
+    return static_cast<uint64_t>(OccupancyGrid::wordsForWidth(header.width)) * static_cast<uint64_t>(header.height);
+}
+
+// Get the number of bytes after the header of a checkpoint
+uint64_t getBodyBytes(const CheckpointHeader& header) {
+    return sizeof(CheckpointState) + static_cast<uint64_t>(header.pathNodes) * sizeof(CheckpointNode) +
+           getPayloadWords(header) * sizeof(uint64_t);
+}
+
+// Compute the checksum of every header word before headerChecksum
+uint64_t computeHeaderChecksum(const CheckpointHeader& header) {
+    uint64_t words[sizeof(CheckpointHeader) / sizeof(uint64_t)];
+    std::memcpy(words, &header, sizeof(header));
+    return computeMapChecksum(words, offsetof(CheckpointHeader, headerChecksum) / sizeof(uint64_t));
+}
+
+// Read and check the header of a slot file, including the file size it implies
+bool readSlotHeader(const std::string& path, CheckpointHeader& header, std::string& error) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        error = "no checkpoint at '" + path + "'";
+        return false;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        error = "'" + path + "' is too short for a checkpoint header";
+        return false;
+    }
+
+    const char* problem = nullptr;
+    if (std::memcmp(header.magic, kCheckpointMagic, sizeof(header.magic)) != 0) {
+        problem = "not a checkpoint file";
+    } else if (header.version != kCheckpointVersion) {
+        problem = "unsupported checkpoint version";
+    } else if (computeHeaderChecksum(header) != header.headerChecksum) {
+        problem = "header checksum mismatch";
+    } else if (header.width <= 0 || header.height <= 0) {
+        problem = "bad grid dimensions";
+    } else if (static_cast<uint64_t>(info.st_size) != sizeof(CheckpointHeader) + getBodyBytes(header)) {
+        problem = "file size does not match the header";
+    }
+    if (problem != nullptr) {
+        error = "'" + path + "': " + problem;
+        return false;
+    }
+    return true;
+}
+
+// Read a whole slot file and verify both checksums
+bool readSlot(const std::string& path, CheckpointData& data, std::string& error) {
+    if (!readSlotHeader(path, data.header, error)) {
+        return false;
+    }
+    const CheckpointHeader& header = data.header;
+
+    // The state and path records are whole words, so they share one checksum pass
+    size_t recordWords = (sizeof(CheckpointState) + header.pathNodes * sizeof(CheckpointNode)) / sizeof(uint64_t);
+    std::vector<uint64_t> records(recordWords);
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(sizeof(CheckpointHeader));
+    in.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(recordWords * sizeof(uint64_t)));
+    if (!in || computeMapChecksum(records.data(), records.size()) != header.recordChecksum) {
+        error = "'" + path + "': state checksum mismatch";
+        return false;
+    }
+
+    size_t wordCount = static_cast<size_t>(getPayloadWords(header));
+    data.words.resize(wordCount);
+    in.read(reinterpret_cast<char*>(data.words.data()), static_cast<std::streamsize>(wordCount * sizeof(uint64_t)));
+    if (!in || computeMapChecksum(data.words.data(), wordCount) != header.payloadChecksum) {
+        error = "'" + path + "': grid checksum mismatch";
+        return false;
+    }
+
+    std::memcpy(&data.state, records.data(), sizeof(CheckpointState));
+    data.path.resize(header.pathNodes);
+    if (header.pathNodes > 0) {
+        std::memcpy(data.path.data(), reinterpret_cast<const char*>(records.data()) + sizeof(CheckpointState),
+                    header.pathNodes * sizeof(CheckpointNode));
+    }
+    return true;
+}
+
+// Write a whole buffer to a file descriptor
+bool writeAll(int fd, const void* data, size_t bytes) {
+    const char* next = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, next, bytes);
+        if (written <= 0) {
+            return false;
+        }
+        next += written;
+        bytes -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Flush the directory holding a path so a rename into it survives power loss
+void syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+}
+
+// Get the file name of a checkpoint slot (0 for BASE.a, 1 for BASE.b)
+std::string getCheckpointSlotPath(const std::string& base_path, int slot) {
+    return base_path + (slot == 0 ? ".a" : ".b");
+}
+
+// Read the newest valid checkpoint of a base path
+bool readCheckpoint(const std::string& base_path, CheckpointData& data, std::string& error) {
+    if (!isLittleEndianHost()) {
+        error = "checkpoints are little-endian; this host is not";
+        return false;
+    }
+
+    // Try the slots newest first; only the payload of the one used is read in full
+    CheckpointHeader headers[2];
+    bool present[2];
+    std::string problems[2];
+    for (int slot = 0; slot < 2; slot++) {
+        present[slot] = readSlotHeader(getCheckpointSlotPath(base_path, slot), headers[slot], problems[slot]);
+    }
+    int first = (present[1] && (!present[0] || headers[1].sequence > headers[0].sequence)) ? 1 : 0;
+
+    for (int i = 0; i < 2; i++) {
+        int slot = (i == 0) ? first : 1 - first;
+        if (present[slot] && readSlot(getCheckpointSlotPath(base_path, slot), data, problems[slot])) {
+            return true;
+        }
+    }
+    error = problems[first] + "; " + problems[1 - first];
+    return false;
+}
+
+// Constructor (reads the headers of existing slots to continue their sequence)
+CheckpointWriter::CheckpointWriter(const std::string& base_path, bool sync_to_disk) :
+    basePath(base_path), syncToDisk(sync_to_disk), sequence(0), nextSlot(0), writeCount(0),
+    lastWriteSeconds(0.0), totalWriteSeconds(0.0), lastWriteBytes(0) {
+
+    // Replace the older slot first; a slot without a usable header counts as oldest
+    uint64_t slotSequence[2] = {0, 0};
+    for (int slot = 0; slot < 2; slot++) {
+        CheckpointHeader header;
+        std::string ignored;
+        if (readSlotHeader(getCheckpointSlotPath(basePath, slot), header, ignored)) {
+            slotSequence[slot] = header.sequence;
+        }
+    }
+    sequence = std::max(slotSequence[0], slotSequence[1]);
+    nextSlot = (slotSequence[1] < slotSequence[0]) ? 1 : 0;
+}
+
+// Write a checkpoint into the older slot
+bool CheckpointWriter::write(const CheckpointState& state, const std::vector<CheckpointNode>& path,
+                             const OccupancyGrid& grid, int destX, int destY, std::string& error) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!isLittleEndianHost()) {
+        error = "checkpoints are little-endian; this host is not";
+        return false;
+    }
+
+    // Stage the records as words so the checksum can run over them directly
+    size_t recordBytes = sizeof(CheckpointState) + path.size() * sizeof(CheckpointNode);
+    records.resize(recordBytes / sizeof(uint64_t));
+    std::memcpy(records.data(), &state, sizeof(CheckpointState));
+    if (!path.empty()) {
+        std::memcpy(reinterpret_cast<char*>(records.data()) + sizeof(CheckpointState), path.data(),
+                    path.size() * sizeof(CheckpointNode));
+    }
+    size_t wordCount = static_cast<size_t>(grid.getWordsPerRow()) * grid.getHeight();
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kCheckpointMagic, sizeof(header.magic));
+    header.version = kCheckpointVersion;
+    header.sequence = sequence + 1;
+    header.width = grid.getWidth();
+    header.height = grid.getHeight();
+    header.destX = destX;
+    header.destY = destY;
+    header.pathNodes = static_cast<uint32_t>(path.size());
+    header.recordChecksum = computeMapChecksum(records.data(), records.size());
+    header.payloadChecksum = computeMapChecksum(grid.getWords(), wordCount);
+    header.headerChecksum = computeHeaderChecksum(header);
+
+    // Finish a temporary file, then rename it over the slot in one step
+    std::string slotPath = getCheckpointSlotPath(basePath, nextSlot);
+    std::string temporaryPath = slotPath + ".tmp";
+    int fd = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error = "cannot create '" + temporaryPath + "'";
+        return false;
+    }
+    bool ok = writeAll(fd, &header, sizeof(header)) && writeAll(fd, records.data(), recordBytes) &&
+              writeAll(fd, grid.getWords(), wordCount * sizeof(uint64_t)) && (!syncToDisk || fsync(fd) == 0);
+    ok = (::close(fd) == 0) && ok;
+    if (!ok || std::rename(temporaryPath.c_str(), slotPath.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        error = "cannot write '" + slotPath + "'";
+        return false;
+    }
+    if (syncToDisk) {
+        syncParentDirectory(slotPath);
+    }
+
+    sequence = header.sequence;
+    nextSlot = 1 - nextSlot;
+    writeCount++;
+    lastWriteBytes = static_cast<long long>(sizeof(CheckpointHeader) + recordBytes + wordCount * sizeof(uint64_t));
+    lastWriteSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    totalWriteSeconds += lastWriteSeconds;
+    return true;
+}
+
+// Get the base path of the slot files
+const std::string& CheckpointWriter::getBasePath() const {
+    return basePath;
+}
+
+// Get the sequence number of the last checkpoint written or found on disk
+uint64_t CheckpointWriter::getSequence() const {
+    return sequence;
+}
+
+// Get the number of checkpoints written
+long long CheckpointWriter::getWriteCount() const {
+    return writeCount;
+}
+
+// Get the wall time of the last write in seconds
+double CheckpointWriter::getLastWriteSeconds() const {
+    return lastWriteSeconds;
+}
+
+// Get the wall time of all writes in seconds
+double CheckpointWriter::getTotalWriteSeconds() const {
+    return totalWriteSeconds;
+}
+
+// Get the size of the last checkpoint in bytes
+long long CheckpointWriter::getLastWriteBytes() const {
+    return lastWriteBytes;
+}
@@ -0,0 +1,135 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "occupancy_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Planner checkpoint file format, version 2
+//
+// A 64-byte header, the fixed state record, one record per node of the
+// compacted path, then the obstacle grid in the layout OccupancyGrid uses
+// in memory (the same payload as a binary map file). All fields are
+// little-endian. The header, the state and path records, and the grid each
+// carry their own checksum, so a torn write of any of them is caught.
+// Version 2 added the header checksum in place of the redundant header
+// size and words-per-row fields (the grid width implies the latter).
+//
+// Checkpoints are double-buffered: writes alternate between two slot files,
+// BASE.a and BASE.b, each replaced atomically by renaming a finished
+// temporary file over it. The slot with the highest sequence number whose
+// checksums hold is the current checkpoint, so a crash at any point leaves
+// at least the previous checkpoint readable.
+const char kCheckpointMagic[8] = {'R', 'P', 'C', 'H', 'E', 'C', 'K', 'P'};
+const uint32_t kCheckpointVersion = 2;
+
+// Checkpoint file header (64 bytes)
+struct CheckpointHeader {
+    char magic[8];              // kCheckpointMagic
+    uint32_t version;           // kCheckpointVersion
+    uint32_t pathNodes;         // Path records after the state record
+    uint64_t sequence;          // Write number; the newest valid slot wins
+    int32_t width;              // Grid size
+    int32_t height;
+    int32_t destX;              // Destination the state belongs to
+    int32_t destY;
+    uint64_t recordChecksum;    // computeMapChecksum of the state and path records
+    uint64_t payloadChecksum;   // computeMapChecksum of the grid payload
+    uint64_t headerChecksum;    // computeMapChecksum of the 56 bytes before this field
+};
+
+static_assert(sizeof(CheckpointHeader) == 64, "CheckpointHeader must stay 64 bytes");
+static_assert(offsetof(CheckpointHeader, headerChecksum) == 56, "The header checksum must be the last word");
+
+// Robot position, heading and counters (48 bytes)
+struct CheckpointState {
+    int32_t currentX;
+    int32_t currentY;
+    int32_t heading;            // Direction in degrees
+    int32_t moves;              // PlannerStats counters
+    int32_t turns;
+    int32_t compactions;
+    int32_t removedNodes;
+    int32_t replans;
+    int32_t discardedLegs;
+    uint32_t flags;             // Reserved, 0
+    uint64_t mapVersion;        // Map changes made by markObstacle
+};
+
+static_assert(sizeof(CheckpointState) == 48, "CheckpointState must stay 48 bytes");
+
+// One node of the compacted path (16 bytes)
+struct CheckpointNode {
+    int32_t x;
+    int32_t y;
+    int32_t type;               // NodeType
+    int32_t reserved;           // 0
+};
+
+static_assert(sizeof(CheckpointNode) == 16, "CheckpointNode must stay 16 bytes");
+
+// Contents of a checkpoint read back from disk
+struct CheckpointData {
+    CheckpointHeader header;
+    CheckpointState state;
+    std::vector<CheckpointNode> path;
+    std::vector<uint64_t> words;    // Grid payload, wordsPerRow * height words
+};
+
+// Get the file name of a checkpoint slot (0 for BASE.a, 1 for BASE.b)
+std::string getCheckpointSlotPath(const std::string& base_path, int slot);
+
+// Read the newest valid checkpoint of a base path
+//
+// Returns false with the reason in error if neither slot holds one.
+bool readCheckpoint(const std::string& base_path, CheckpointData& data, std::string& error);
+
+// Writer of double-buffered checkpoints
+//
+// The sequence continues from whatever slots already exist, so a planner
+// restarted after a reboot never writes a checkpoint older than the one it
+// resumed from. The state and path records are staged in a reused buffer;
+// the grid is written straight from its storage.
+class CheckpointWriter {
+private:
+    std::string basePath;
+    bool syncToDisk;                // fsync each file before it replaces its slot
+    uint64_t sequence;              // Sequence of the last checkpoint written or found
+    int nextSlot;                   // Slot the next write replaces (the older one)
+    std::vector<uint64_t> records;  // Staging for the state and path records
+
+    long long writeCount;
+    double lastWriteSeconds;
+    double totalWriteSeconds;
+    long long lastWriteBytes;
+
+public:
+    // Constructor (reads the headers of existing slots to continue their sequence)
+    explicit CheckpointWriter(const std::string& base_path, bool sync_to_disk = true);
+
+    // Write a checkpoint into the older slot
+    bool write(const CheckpointState& state, const std::vector<CheckpointNode>& path, const OccupancyGrid& grid,
+               int destX, int destY, std::string& error);
+
+    // Get the base path of the slot files
+    const std::string& getBasePath() const;
+
+    // Get the sequence number of the last checkpoint written or found on disk
+    uint64_t getSequence() const;
+
+    // Get the number of checkpoints written
+    long long getWriteCount() const;
+
+    // Get the wall time of the last write in seconds
+    double getLastWriteSeconds() const;
+
+    // Get the wall time of all writes in seconds
+    double getTotalWriteSeconds() const;
+
+    // Get the size of the last checkpoint in bytes
+    long long getLastWriteBytes() const;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,234 @@
+#include "clearance_map.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Diagonal of a cell; the reach of the incremental spread past a new obstacle's region
+const double kCellDiagonal = 1.4142135624;
+
+// Position where the parabolas of columns v and q (v < q) intersect
+double intersect(const std::vector<long long>& heights, int v, int q) {
+    return static_cast<double>((heights[q] + static_cast<long long>(q) * q) -
+                               (heights[v] + static_cast<long long>(v) * v)) / (2.0 * (q - v));
+}
+}
+
+// Constructor (builds the distances of the current grid unless build_now is false)
+ClearanceMap::ClearanceMap(const OccupancyGrid& occupancy_grid, bool build_now) :
+    grid(occupancy_grid), width(occupancy_grid.getWidth()), height(occupancy_grid.getHeight()),
+    visitStamp(0), built(false) {
+
+    frontier.reserve(64);
+    if (build_now) {
+        rebuild();
+    }
+}
+
+// Split [0, count) into chunks and run them on the pool (inline without one)
+template <typename Body>
+void ClearanceMap::runChunks(int count, ThreadPool* pool, Body body) {
+    if (pool == nullptr || pool->getThreadCount() <= 1 || count < 64) {
+        body(0, count);
+        return;
+    }
+
+    // A few chunks per thread so stealing can even out the load
+    int chunks = pool->getThreadCount() * 4;
+    int chunkSize = (count + chunks - 1) / chunks;
+    for (int from = 0; from < count; from += chunkSize) {
+        int to = (from + chunkSize < count) ? from + chunkSize : count;
+        pool->submit([body, from, to] { body(from, to); });
+    }
+    pool->wait();
+}
+
+// Pass 1: nearest obstacle row within each padded column in [fromX, toX)
+//
+// Padded coordinates run from -1 to width / height, so the ring of cells
+// around the map acts as an obstacle border. The scratch table is stored
+// row-major and both passes sweep whole rows, keeping memory access linear.
+void ClearanceMap::scanColumns(int fromX, int toX) {
+    int paddedWidth = width + 2;
+    std::vector<int> last(toX - fromX);
+
+    // Downward pass: nearest obstacle at or below each row
+    int* border = &columnNearest[fromX];
+    for (int column = fromX; column < toX; column++) {
+        last[column - fromX] = -1;
+        border[column - fromX] = -1;
+    }
+    for (int y = 0; y < height; y++) {
+        int* nearest = &columnNearest[static_cast<size_t>(y + 1) * paddedWidth];
+        for (int column = fromX; column < toX; column++) {
+            int x = column - 1;
+            if (x < 0 || x >= width || grid.isObstacleDetected(x, y)) {
+                last[column - fromX] = y;
+            }
+            nearest[column] = last[column - fromX];
+        }
+    }
+
+    // Upward pass: keep whichever of the two is closer
+    int* top = &columnNearest[static_cast<size_t>(height + 1) * paddedWidth];
+    for (int column = fromX; column < toX; column++) {
+        last[column - fromX] = height;
+        top[column] = height;
+    }
+    for (int y = height - 1; y >= 0; y--) {
+        int* nearest = &columnNearest[static_cast<size_t>(y + 1) * paddedWidth];
+        for (int column = fromX; column < toX; column++) {
+            int below = nearest[column];
+            if (below == y) {
+                last[column - fromX] = y;
+            } else if (last[column - fromX] - y < y - below) {
+                nearest[column] = last[column - fromX];
+            }
+        }
+    }
+}
+
+// Pass 2: combine the column results along each row in [fromY, toY)
+//
+// For a fixed row every padded column q contributes the parabola
+// (x - q)^2 + gap(q)^2; the lower envelope gives the exact distance.
+void ClearanceMap::scanRows(int fromY, int toY) {
+    int paddedWidth = width + 2;
+    std::vector<int> vertices(paddedWidth);
+    std::vector<double> boundaries(paddedWidth + 1);
+    std::vector<long long> heights(paddedWidth);
+
+    for (int y = fromY; y < toY; y++) {
+        int row = y + 1;
+
+        // Parabola heights: squared gap to the nearest obstacle in each column
+        const int* nearest = &columnNearest[static_cast<size_t>(row) * paddedWidth];
+        for (int q = 0; q < paddedWidth; q++) {
+            long long gap = nearest[q] - y;
+            heights[q] = gap * gap;
+        }
+
+        // Lower envelope of the parabolas
+        int count = 0;
+        vertices[0] = 0;
+        boundaries[0] = -1e30;
+        boundaries[1] = 1e30;
+        for (int q = 1; q < paddedWidth; q++) {
+            double s = intersect(heights, vertices[count], q);
+            while (s <= boundaries[count]) {
+                count--;
+                s = intersect(heights, vertices[count], q);
+            }
+            count++;
+            vertices[count] = q;
+            boundaries[count] = s;
+            boundaries[count + 1] = 1e30;
+        }
+
+        // Read the envelope back for the interior cells
+        int k = 0;
+        for (int q = 1; q <= width; q++) {
+            while (boundaries[k + 1] < q) {
+                k++;
+            }
+            int v = vertices[k];
+            long long dx = q - v;
+            size_t cell = static_cast<size_t>(y) * width + (q - 1);
+            distanceSquared[cell] = static_cast<int>(dx * dx + heights[v]);
+        }
+    }
+}
+
+// Recompute every distance from the grid, optionally on a thread pool
+void ClearanceMap::rebuild(ThreadPool* pool) {
+    distanceSquared.resize(static_cast<size_t>(width) * height);
+    columnNearest.resize(static_cast<size_t>(width + 2) * (height + 2));
+
+    runChunks(width + 2, pool, [this](int from, int to) { scanColumns(from, to); });
+    runChunks(height, pool, [this](int from, int to) { scanRows(from, to); });
+
+    // The scratch column table is only needed during a build
+    std::vector<int>().swap(columnNearest);
+    built = true;
+}
+
+// Fold in an obstacle already marked in the grid; returns the cells updated
+//
+// Only distances can shrink, and only in the cells the new obstacle is now
+// nearest to. Those cells are the grid points of a convex region, but the
+// grid points of a thin region need not be 8-connected, so spreading only
+// through improved cells can strand some of them. Every grid point within
+// half a diagonal of the region is 8-connected to the obstacle and lies
+// less than a diagonal further from it than from its old nearest obstacle,
+// so the spread continues through every cell passing that looser test.
+int ClearanceMap::notifyObstacleAdded(int x, int y) {
+    if (!built || x < 0 || x >= width || y < 0 || y >= height) {
+        return 0;
+    }
+    size_t start = static_cast<size_t>(y) * width + x;
+    if (distanceSquared[start] == 0) {
+        return 0;
+    }
+
+    // A new stamp marks every cell unreached without clearing the table
+    visited.resize(distanceSquared.size(), 0);
+    visitStamp++;
+    if (visitStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        visitStamp = 1;
+    }
+
+    distanceSquared[start] = 0;
+    visited[start] = visitStamp;
+    frontier.clear();
+    frontier.push_back(GridCell{x, y});
+
+    int updated = 1;
+    for (size_t head = 0; head < frontier.size(); head++) {
+        GridCell cell = frontier[head];
+        int fromX = (cell.x > 0) ? cell.x - 1 : 0;
+        int toX = (cell.x + 1 < width) ? cell.x + 1 : width - 1;
+        int fromY = (cell.y > 0) ? cell.y - 1 : 0;
+        int toY = (cell.y + 1 < height) ? cell.y + 1 : height - 1;
+
+        for (int ny = fromY; ny <= toY; ny++) {
+            int oy = ny - y;
+            size_t rowStart = static_cast<size_t>(ny) * width;
+            for (int nx = fromX; nx <= toX; nx++) {
+                size_t index = rowStart + nx;
+                if (visited[index] == visitStamp) {
+                    continue;
+                }
+                visited[index] = visitStamp;
+
+                int ox = nx - x;
+                int candidate = ox * ox + oy * oy;
+                int old = distanceSquared[index];
+                if (candidate < old) {
+                    distanceSquared[index] = candidate;
+                    updated++;
+                }
+                double reach = std::sqrt(static_cast<double>(old)) + kCellDiagonal;
+                if (candidate <= reach * reach) {
+                    frontier.push_back(GridCell{nx, ny});
+                }
+            }
+        }
+    }
+
+    return updated;
+}
+
+// Get the distance to the nearest obstacle in cells
+double ClearanceMap::getClearance(int x, int y) const {
+    return std::sqrt(static_cast<double>(getDistanceSquared(x, y)));
+}
+
+// Get the width of the map
+int ClearanceMap::getWidth() const {
+    return width;
+}
+
+// Get the height of the map
+int ClearanceMap::getHeight() const {
+    return height;
+}
@@ -0,0 +1,82 @@
+#ifndef CLEARANCE_MAP_H
+#define CLEARANCE_MAP_H
+
+#include "grid_search.h"
+#include "occupancy_grid.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <vector>
+
+// Distance from every cell to the nearest obstacle
+//
+// Holds the exact squared Euclidean distance (in cells) from each cell to
+// the nearest obstacle, with everything outside the map counting as an
+// obstacle. A full build uses the separable two-pass transform (column
+// scans, then a lower envelope of parabolas per row); both passes split
+// across a thread pool. New obstacles are folded in incrementally by
+// propagating their position outwards over the cells it may be nearest to.
+class ClearanceMap {
+private:
+    const OccupancyGrid& grid;      // Map the distances are computed from
+    int width;
+    int height;
+    std::vector<int> distanceSquared;   // Row-major squared distance per cell
+    std::vector<int> columnNearest;     // Pass 1 scratch: nearest obstacle row per padded column
+    std::vector<GridCell> frontier;     // Incremental update scratch queue
+    std::vector<uint32_t> visited;      // Update in which each cell was last reached
+    uint32_t visitStamp;                // Current incremental update number
+    bool built;                         // Distances have been computed
+
+    // Pass 1: nearest obstacle row within each padded column in [fromX, toX)
+    void scanColumns(int fromX, int toX);
+
+    // Pass 2: combine the column results along each row in [fromY, toY)
+    void scanRows(int fromY, int toY);
+
+    // Split [0, count) into chunks and run them on the pool (inline without one)
+    template <typename Body>
+    void runChunks(int count, ThreadPool* pool, Body body);
+
+public:
+    // Constructor (builds the distances of the current grid unless build_now is false)
+    explicit ClearanceMap(const OccupancyGrid& occupancy_grid, bool build_now = true);
+
+    // Recompute every distance from the grid, optionally on a thread pool
+    //
+    // The pool must not be running unrelated work: the build waits for it to drain.
+    void rebuild(ThreadPool* pool = nullptr);
+
+    // Fold in an obstacle already marked in the grid; returns the cells updated
+    //
+    // Does nothing before the first build, which will see the obstacle anyway.
+    int notifyObstacleAdded(int x, int y);
+
+    // Check if the distances have been computed (the queries below need them)
+    bool isBuilt() const {
+        return built;
+    }
+
+    // Get the squared distance to the nearest obstacle (0 on or outside obstacles and the map)
+    int getDistanceSquared(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return 0;
+        }
+        return distanceSquared[static_cast<size_t>(y) * width + x];
+    }
+
+    // Get the distance to the nearest obstacle in cells
+    double getClearance(int x, int y) const;
+
+    // Check if a cell is at least min_clearance cells away from every obstacle
+    bool hasClearance(int x, int y, double min_clearance) const {
+        return getDistanceSquared(x, y) >= min_clearance * min_clearance;
+    }
+
+    // Get the width of the map
+    int getWidth() const;
+
+    // Get the height of the map
+    int getHeight() const;
+};
+
+#endif // CLEARANCE_MAP_H
@@ -0,0 +1,203 @@
+#include "connectivity_index.h"
+#include <algorithm>
+
+// Step offsets to the four neighbours
+static const int kNeighbourDx[4] = {1, -1, 0, 0};
+static const int kNeighbourDy[4] = {0, 0, 1, -1};
+
+// Find the root of a union-find element, halving the path on the way
+static int findRoot(std::vector<int>& parent, int element) {
+    while (parent[element] != element) {
+        parent[element] = parent[parent[element]];
+        element = parent[element];
+    }
+    return element;
+}
+
+// Constructor (labels the current grid unless build_now is false)
+ConnectivityIndex::ConnectivityIndex(const OccupancyGrid& occupancy_grid, bool build_now) :
+    grid(occupancy_grid), width(occupancy_grid.getWidth()), height(occupancy_grid.getHeight()),
+    componentCount(0), built(false), floodStamp(0), lastSplitCells(0) {
+    if (build_now) {
+        rebuild();
+    }
+}
+
+// Recompute every label from the grid
+void ConnectivityIndex::rebuild() {
+    width = grid.getWidth();
+    height = grid.getHeight();
+    size_t cellCount = static_cast<size_t>(width) * height;
+
+    // Pass 1: union every free cell with its free west and south neighbours
+    std::vector<int> parent(cellCount, -1);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (grid.isObstacleDetected(x, y)) {
+                continue;
+            }
+            int cell = indexOf(x, y);
+            parent[cell] = cell;
+            if (x > 0 && parent[cell - 1] != -1) {
+                parent[cell] = findRoot(parent, cell - 1);
+            }
+            if (y > 0 && parent[cell - width] != -1) {
+                int below = findRoot(parent, cell - width);
+                int self = findRoot(parent, cell);
+                if (below != self) {
+                    parent[std::max(below, self)] = std::min(below, self);
+                }
+            }
+        }
+    }
+
+    // Pass 2: number the roots in scan order
+    labels.assign(cellCount, -1);
+    componentCount = 0;
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        if (parent[cell] == -1) {
+            continue;
+        }
+        int root = findRoot(parent, static_cast<int>(cell));
+        if (labels[root] == -1) {
+            labels[root] = componentCount++;
+        }
+        labels[cell] = labels[root];
+    }
+
+    visitStamp.assign(cellCount, 0);
+    visitOwner.assign(cellCount, 0);
+    floodStamp = 0;
+    built = true;
+}
+
+// Relabel the cells of the floods in group with a new label
+void ConnectivityIndex::relabelFloods(const int* floodGroup, int group, int flood_count) {
+    int label = componentCount++;
+    for (int flood = 0; flood < flood_count; flood++) {
+        if (floodGroup[flood] != group) {
+            continue;
+        }
+        for (int cell : floodCells[flood]) {
+            labels[cell] = label;
+        }
+    }
+}
+
+// Fold in an obstacle already marked in the grid; returns true if its component split
+bool ConnectivityIndex::notifyObstacleAdded(int x, int y) {
+    lastSplitCells = 0;
+    if (!built || x < 0 || x >= width || y < 0 || y >= height || labels[indexOf(x, y)] == -1) {
+        return false;
+    }
+    int oldLabel = labels[indexOf(x, y)];
+    labels[indexOf(x, y)] = -1;
+
+    // One flood per free neighbour; fewer than two cannot be split apart
+    int floodCount = 0;
+    int floodGroup[4];
+    size_t floodHead[4];
+    floodStamp++;
+    if (floodStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        floodStamp = 1;
+    }
+    for (int i = 0; i < 4; i++) {
+        int nextX = x + kNeighbourDx[i];
+        int nextY = y + kNeighbourDy[i];
+        if (getComponent(nextX, nextY) != oldLabel) {
+            continue;
+        }
+        int cell = indexOf(nextX, nextY);
+        floodCells[floodCount].clear();
+        floodCells[floodCount].push_back(cell);
+        floodHead[floodCount] = 0;
+        floodGroup[floodCount] = floodCount;
+        visitStamp[cell] = floodStamp;
+        visitOwner[cell] = static_cast<uint8_t>(floodCount);
+        floodCount++;
+    }
+    if (floodCount < 2) {
+        return false;
+    }
+
+    // Expand the floods one cell at a time each until at most one group is still open
+    bool split = false;
+    int openGroups = floodCount;
+    bool groupOpen[4] = {true, true, true, true};
+    while (openGroups > 1) {
+        for (int flood = 0; flood < floodCount && openGroups > 1; flood++) {
+            if (!groupOpen[floodGroup[flood]] || floodHead[flood] >= floodCells[flood].size()) {
+                continue;
+            }
+
+            int cell = floodCells[flood][floodHead[flood]++];
+            int cellX = cell % width;
+            int cellY = cell / width;
+            for (int i = 0; i < 4; i++) {
+                int nextX = cellX + kNeighbourDx[i];
+                int nextY = cellY + kNeighbourDy[i];
+                if (getComponent(nextX, nextY) != oldLabel) {
+                    continue;
+                }
+                int next = indexOf(nextX, nextY);
+                if (visitStamp[next] != floodStamp) {
+                    visitStamp[next] = floodStamp;
+                    visitOwner[next] = static_cast<uint8_t>(flood);
+                    floodCells[flood].push_back(next);
+                    continue;
+                }
+
+                // Meeting another group merges the two
+                int from = floodGroup[flood];
+                int into = floodGroup[visitOwner[next]];
+                if (from != into) {
+                    for (int other = 0; other < floodCount; other++) {
+                        if (floodGroup[other] == from) {
+                            floodGroup[other] = into;
+                        }
+                    }
+                    groupOpen[from] = false;
+                    openGroups--;
+                }
+            }
+
+            // A group whose floods have all run dry is cut off from the rest
+            int group = floodGroup[flood];
+            bool exhausted = true;
+            for (int other = 0; other < floodCount && exhausted; other++) {
+                if (floodGroup[other] == group && floodHead[other] < floodCells[other].size()) {
+                    exhausted = false;
+                }
+            }
+            if (exhausted && openGroups > 1) {
+                relabelFloods(floodGroup, group, floodCount);
+                groupOpen[group] = false;
+                openGroups--;
+                split = true;
+            }
+        }
+    }
+
+    for (int flood = 0; flood < floodCount; flood++) {
+        lastSplitCells += static_cast<long long>(floodCells[flood].size());
+    }
+    return split;
+}
+
+// Get the number of labels handed out
+int ConnectivityIndex::getComponentCount() const {
+    return componentCount;
+}
+
+// Get the number of cells visited by the last split check
+long long ConnectivityIndex::getLastSplitCells() const {
+    return lastSplitCells;
+}
+
+// Get the memory used by the labels and the split scratch in bytes
+long long ConnectivityIndex::getMemoryBytes() const {
+    return static_cast<long long>(labels.capacity()) * static_cast<long long>(sizeof(int)) +
+           static_cast<long long>(visitStamp.capacity()) * static_cast<long long>(sizeof(uint32_t)) +
+           static_cast<long long>(visitOwner.capacity());
+}
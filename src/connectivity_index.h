@@ -0,0 +1,82 @@
+#ifndef CONNECTIVITY_INDEX_H
+#define CONNECTIVITY_INDEX_H
+
+#include "occupancy_grid.h"
+#include <cstdint>
+#include <vector>
+
+// Connected-component labels of the free cells of a grid
+//
+// Two free cells share a label exactly when a 4-connected route of free
+// cells joins them, so "can the destination still be reached" is one
+// comparison. The full build is a two-pass union-find over the rows. A new
+// obstacle can only split its own component: floods started from its free
+// neighbours run in lockstep, merge when they meet, and any group that runs
+// dry first is cut off and relabelled. The work is bounded by the smaller
+// side of a split rather than by the map.
+class ConnectivityIndex {
+private:
+    const OccupancyGrid& grid;      // Map the labels are computed from
+    int width;
+    int height;
+    std::vector<int> labels;        // Row-major component label per cell, -1 on obstacles
+    int componentCount;             // Labels handed out (split-off labels are never reused)
+    bool built;                     // Labels have been computed
+
+    // Split detection scratch, valid only where visitStamp matches floodStamp
+    std::vector<uint32_t> visitStamp;
+    std::vector<uint8_t> visitOwner;    // Flood that reached the cell
+    uint32_t floodStamp;
+    std::vector<int> floodCells[4];     // Cells reached by each flood, in BFS order
+    long long lastSplitCells;           // Cells visited by the last split check
+
+    // Get the cell index of (x, y)
+    int indexOf(int x, int y) const {
+        return y * width + x;
+    }
+
+    // Relabel the cells of the floods in group with a new label
+    void relabelFloods(const int* floodGroup, int group, int flood_count);
+
+public:
+    // Constructor (labels the current grid unless build_now is false)
+    explicit ConnectivityIndex(const OccupancyGrid& occupancy_grid, bool build_now = true);
+
+    // Recompute every label from the grid
+    void rebuild();
+
+    // Fold in an obstacle already marked in the grid; returns true if its component split
+    //
+    // Does nothing before the first build, which will see the obstacle anyway.
+    bool notifyObstacleAdded(int x, int y);
+
+    // Check if the labels have been computed (the queries below need them)
+    bool isBuilt() const {
+        return built;
+    }
+
+    // Get the component label of (x, y) (-1 on obstacles and outside the map)
+    int getComponent(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return -1;
+        }
+        return labels[indexOf(x, y)];
+    }
+
+    // Check if a route of free cells joins (fromX, fromY) and (toX, toY)
+    bool isConnected(int fromX, int fromY, int toX, int toY) const {
+        int component = getComponent(fromX, fromY);
+        return component != -1 && component == getComponent(toX, toY);
+    }
+
+    // Get the number of labels handed out
+    int getComponentCount() const;
+
+    // Get the number of cells visited by the last split check
+    long long getLastSplitCells() const;
+
+    // Get the memory used by the labels and the split scratch in bytes
+    long long getMemoryBytes() const;
+};
+
+#endif // CONNECTIVITY_INDEX_H
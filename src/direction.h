@@ -0,0 +1,82 @@
+#ifndef DIRECTION_H
+#define DIRECTION_H
+
+// Direction enumeration (IMU heading in degrees, clockwise)
+enum Direction {
+    SOUTH = 0,          // 0 degrees (negative y direction)
+    SOUTH_WEST = 45,
+    WEST = 90,          // 90 degrees (negative x direction)
+    NORTH_WEST = 135,
+    NORTH = 180,        // 180 degrees (positive y direction)
+    NORTH_EAST = 225,
+    EAST = 270,         // 270 degrees (positive x direction)
+    SOUTH_EAST = 315
+};
+
+// Number of directions in the lookup tables
+const int kDirectionCount = 8;
+
+// Directions by table index, clockwise from NORTH
+constexpr Direction kDirections[kDirectionCount] = {
+    NORTH, NORTH_EAST, EAST, SOUTH_EAST, SOUTH, SOUTH_WEST, WEST, NORTH_WEST
+};
+
+// Grid step of each direction by table index
+constexpr int kDirectionDx[kDirectionCount] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kDirectionDy[kDirectionCount] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+// Printable name of each direction by table index
+constexpr const char* kDirectionNames[kDirectionCount] = {
+    "NORTH", "NORTH_EAST", "EAST", "SOUTH_EAST", "SOUTH", "SOUTH_WEST", "WEST", "NORTH_WEST"
+};
+
+// Table index of each grid step, as kStepDirectionIndex[dy + 1][dx + 1] (-1 for no step)
+constexpr int kStepDirectionIndex[3][3] = {
+    {5, 4, 3},      // dy = -1: SOUTH_WEST, SOUTH, SOUTH_EAST
+    {6, -1, 2},     // dy =  0: WEST, none, EAST
+    {7, 0, 1}       // dy = +1: NORTH_WEST, NORTH, NORTH_EAST
+};
+
+// Get the table index of a direction
+constexpr int getDirectionIndex(Direction direction) {
+    return ((static_cast<int>(direction) + 180) % 360) / 45;
+}
+
+// Get the grid step taken when moving one cell in a direction
+inline void getDirectionStep(Direction direction, int& dx, int& dy) {
+    int index = getDirectionIndex(direction);
+    dx = kDirectionDx[index];
+    dy = kDirectionDy[index];
+}
+
+// Check if a grid step is one of the eight single-cell moves
+constexpr bool isDirectionStep(int dx, int dy) {
+    return dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && (dx != 0 || dy != 0);
+}
+
+// Get the direction of a single-cell grid step (see isDirectionStep)
+constexpr Direction getDirectionFromStep(int dx, int dy) {
+    return kDirections[kStepDirectionIndex[dy + 1][dx + 1]];
+}
+
+// Check if a direction moves along both axes
+constexpr bool isDiagonal(Direction direction) {
+    return getDirectionIndex(direction) % 2 == 1;
+}
+
+// Get the direction reached by turning clockwise (negative turns counterclockwise)
+constexpr Direction rotateDirection(Direction direction, int degrees) {
+    return kDirections[(getDirectionIndex(direction) + (degrees % 360 + 360) / 45) % kDirectionCount];
+}
+
+// Get the signed turn from one direction to another in (-180, 180] degrees (clockwise positive)
+constexpr int getTurnDegrees(Direction from, Direction to) {
+    return 180 - (static_cast<int>(from) - static_cast<int>(to) + 540) % 360;
+}
+
+// Get the printable name of a direction
+inline const char* getDirectionName(Direction direction) {
+    return kDirectionNames[getDirectionIndex(direction)];
+}
+
+#endif // DIRECTION_H
@@ -1,24 +1,92 @@
 #include "doubly_linked_list.h"
-#include <iostream>
 
 // Constructor
 DoublyLinkedList::DoublyLinkedList(int max_capacity) : 
-    head(nullptr), tail(nullptr), size(0), capacity(max_capacity) {}
+    head(nullptr), tail(nullptr), size(0), capacity(max_capacity),
+    allocator(nullptr), ownedPool(nullptr), latestNecessary(nullptr) {
+    
+    // The list never holds more than capacity nodes, so a pool of that size suffices
+    ownedPool = new NodePool(capacity);
+    allocator = ownedPool;
+}
+
+// Constructor with an external node allocator
+DoublyLinkedList::DoublyLinkedList(int max_capacity, NodeAllocator* node_allocator) : 
+    head(nullptr), tail(nullptr), size(0), capacity(max_capacity),
+    allocator(node_allocator), ownedPool(nullptr), latestNecessary(nullptr) {
+    
+    // Fall back to a private pool if no allocator was supplied
+    if (allocator == nullptr) {
+        ownedPool = new NodePool(capacity);
+        allocator = ownedPool;
+    }
+}
+
+// Copy constructor
+DoublyLinkedList::DoublyLinkedList(const DoublyLinkedList& other) : 
+    head(nullptr), tail(nullptr), size(0), capacity(other.capacity),
+    allocator(nullptr), ownedPool(nullptr), latestNecessary(nullptr) {
+    
+    // The copy always gets its own pool
+    ownedPool = new NodePool(capacity);
+    allocator = ownedPool;
+    appendFrom(other);
+}
+
+// Copy assignment
+DoublyLinkedList& DoublyLinkedList::operator=(const DoublyLinkedList& other) {
+    if (this == &other) {
+        return *this;
+    }
+    
+    clear();
+    
+    // A private pool must be resized to the new capacity; an external allocator is kept
+    if (ownedPool != nullptr && ownedPool->getCapacity() != other.capacity) {
+        delete ownedPool;
+        ownedPool = new NodePool(other.capacity);
+        allocator = ownedPool;
+    }
+    
+    capacity = other.capacity;
+    appendFrom(other);
+    
+    return *this;
+}
 
 // Destructor
 DoublyLinkedList::~DoublyLinkedList() {
-    // Delete all nodes in the list
+    // Return all nodes to the allocator
+    clear();
+    
+    delete ownedPool;
+    ownedPool = nullptr;
+    allocator = nullptr;
+}
+
+// Remove all nodes from the list
+void DoublyLinkedList::clear() {
     Node* current = head;
     while (current != nullptr) {
         Node* next = current->next;
-        delete current;
+        allocator->deallocate(current);
         current = next;
     }
     head = nullptr;
     tail = nullptr;
+    latestNecessary = nullptr;
     size = 0;
 }
 
+// Copy the nodes of another list onto the end of this one
+void DoublyLinkedList::appendFrom(const DoublyLinkedList& other) {
+    for (Node* node = other.head; node != nullptr; node = node->next) {
+        if (!insert(node->x, node->y, node->type)) {
+            break;
+        }
+    }
+}
+
 // Insert a new node at the end of the list
 bool DoublyLinkedList::insert(int x, int y, NodeType type) {
     // Check if the list is full
@@ -26,8 +94,11 @@ bool DoublyLinkedList::insert(int x, int y, NodeType type) {
         return false;
     }
     
-    // Create a new node
-    Node* newNode = new Node(x, y, type);
+    // Take a new node from the allocator
+    Node* newNode = allocator->allocate(x, y, type);
+    if (newNode == nullptr) {
+        return false;
+    }
     
     // If the list is empty, set the new node as both head and tail
     if (isEmpty()) {
@@ -40,6 +111,11 @@ bool DoublyLinkedList::insert(int x, int y, NodeType type) {
         tail = newNode;
     }
     
+    // Keep track of the latest necessary node as it is appended
+    if (type != REGULAR) {
+        latestNecessary = newNode;
+    }
+    
     // Increment the size
     size++;
     
@@ -53,10 +129,26 @@ bool DoublyLinkedList::remove(int index) {
         return false;
     }
     
-    // Find the node to remove
-    Node* current = head;
-    for (int i = 0; i < index; i++) {
-        current = current->next;
+    // Find the node to remove, walking from whichever end is closer
+    Node* current = nullptr;
+    if (index < size / 2) {
+        current = head;
+        for (int i = 0; i < index; i++) {
+            current = current->next;
+        }
+    } else {
+        current = tail;
+        for (int i = size - 1; i > index; i--) {
+            current = current->prev;
+        }
+    }
+    
+    // Removing the latest necessary node hands the role to the previous one
+    if (current == latestNecessary) {
+        latestNecessary = current->prev;
+        while (latestNecessary != nullptr && latestNecessary->type == REGULAR) {
+            latestNecessary = latestNecessary->prev;
+        }
     }
     
     // If the node to remove is the head
@@ -80,8 +172,8 @@ bool DoublyLinkedList::remove(int index) {
         current->next->prev = current->prev;
     }
     
-    // Delete the node
-    delete current;
+    // Return the node to the allocator
+    allocator->deallocate(current);
     
     // Decrement the size
     size--;
@@ -89,46 +181,52 @@ bool DoublyLinkedList::remove(int index) {
     return true;
 }
 
+// Unlink and release the nodes strictly between first and last; returns the count
+int DoublyLinkedList::removeRange(Node* first, Node* last) {
+    int removed = 0;
+    Node* node = first->next;
+    while (node != last) {
+        Node* next = node->next;
+        allocator->deallocate(node);
+        removed++;
+        node = next;
+    }
+    
+    // Close the gap with a single relink
+    first->next = last;
+    last->prev = first;
+    size -= removed;
+    
+    return removed;
+}
+
 // Remove regular nodes between the current position and the latest necessary node
-void DoublyLinkedList::removeRegularNodes() {
+int DoublyLinkedList::removeRegularNodes() {
     if (isEmpty() || size <= 1) {
-        return;
+        return 0;
     }
     
     // Find the latest necessary node
-    Node* latestNecessary = findLatestNecessaryNode();
+    Node* necessary = findLatestNecessaryNode();
     
-    if (latestNecessary == nullptr || latestNecessary == tail) {
-        return;
+    if (necessary == nullptr || necessary == tail) {
+        return 0;
     }
     
-    // Remove regular nodes between the latest necessary node and the tail
-    Node* current = latestNecessary->next;
-    while (current != nullptr && current != tail) {
-        Node* next = current->next;
-        if (current->type == REGULAR) {
-            // Update links
-            current->prev->next = current->next;
-            current->next->prev = current->prev;
-            
-            // Delete the node
-            delete current;
-            
-            // Decrement the size
-            size--;
-        }
-        current = next;
-    }
+    // Everything after the latest necessary node is regular, so the whole
+    // run up to the tail can be dropped without checking node types
+    return removeRange(necessary, tail);
 }
 
 // Remove regular nodes between two necessary nodes
-void DoublyLinkedList::removeRegularNodesBetweenNecessary(Node* current, Node* previous) {
+int DoublyLinkedList::removeRegularNodesBetweenNecessary(Node* current, Node* previous) {
     if (isEmpty() || size <= 1 || current == nullptr || previous == nullptr) {
-        return;
+        return 0;
     }
     
     // Start from the node after previous
     Node* node = previous->next;
+    int removed = 0;
     
     // Remove regular nodes between previous and current
     while (node != nullptr && node != current) {
@@ -138,14 +236,17 @@ void DoublyLinkedList::removeRegularNodesBetweenNecessary(Node* current, Node* p
             node->prev->next = node->next;
             node->next->prev = node->prev;
             
-            // Delete the node
-            delete node;
+            // Return the node to the allocator
+            allocator->deallocate(node);
             
             // Decrement the size
             size--;
+            removed++;
         }
         node = next;
     }
+    
+    return removed;
 }
 
 // Get the current size of the list
@@ -168,10 +269,15 @@ bool DoublyLinkedList::isEmpty() const {
     return size == 0;
 }
 
-// Print the list
-void DoublyLinkedList::print() const {
+// Print the list at the given log level
+void DoublyLinkedList::print(LogLevel level) const {
+    // Skip the walk entirely when the level is not being written
+    if (level > PATH_PLANNER_LOG_LEVEL || !Logger::instance().isEnabled(level)) {
+        return;
+    }
+    
     if (isEmpty()) {
-        std::cout << "List is empty" << std::endl;
+        PLANNER_LOG(level, "List is empty");
         return;
     }
     
@@ -179,25 +285,8 @@ void DoublyLinkedList::print() const {
     int index = 0;
     
     while (current != nullptr) {
-        std::cout << "Node " << index << ": (" << current->x << ", " << current->y << ") - ";
-        
-        // Print the node type
-        switch (current->type) {
-            case REGULAR:
-                std::cout << "REGULAR";
-                break;
-            case START_LOCATION:
-                std::cout << "START_LOCATION";
-                break;
-            case TURNING_NODE:
-                std::cout << "TURNING_NODE";
-                break;
-            case OBJECT_DETECTION:
-                std::cout << "OBJECT_DETECTION";
-                break;
-        }
-        
-        std::cout << std::endl;
+        PLANNER_LOG(level, "Node " << index << ": (" << current->x << ", " << current->y << ") - "
+                    << getNodeTypeName(current->type));
         
         current = current->next;
         index++;
@@ -214,24 +303,33 @@ Node* DoublyLinkedList::getTail() const {
     return tail;
 }
 
+// Get the node after a node (nullptr at the tail)
+Node* DoublyLinkedList::getNext(Node* node) const {
+    return node->next;
+}
+
+// Get the X coordinate of a node
+int DoublyLinkedList::getX(Node* node) const {
+    return node->x;
+}
+
+// Get the Y coordinate of a node
+int DoublyLinkedList::getY(Node* node) const {
+    return node->y;
+}
+
+// Get the type of a node
+NodeType DoublyLinkedList::getType(Node* node) const {
+    return node->type;
+}
+
 // Find the latest necessary node
 Node* DoublyLinkedList::findLatestNecessaryNode() const {
     if (isEmpty()) {
         return nullptr;
     }
     
-    // Start from the tail and move backwards
-    Node* current = tail;
-    
-    while (current != nullptr) {
-        // Check if the current node is a necessary node
-        if (current->type != REGULAR) {
-            return current;
-        }
-        
-        current = current->prev;
-    }
-    
-    // If no necessary node is found, return the head
-    return head;
+    // The latest necessary node is tracked on insert and remove;
+    // if no necessary node exists, return the head
+    return (latestNecessary != nullptr) ? latestNecessary : head;
 }
@@ -1,44 +1,50 @@
 #ifndef DOUBLY_LINKED_LIST_H
 #define DOUBLY_LINKED_LIST_H
 
-#include <iostream>
-
-// Node type enumeration
-enum NodeType {
-    REGULAR,           // Regular node (empty square)
-    START_LOCATION,    // Starting location node
-    TURNING_NODE,      // Node where robot needs to turn
-    OBJECT_DETECTION   // Node where an object is detected
-};
-
-// Doubly Linked List Node structure
-struct Node {
-    int x;              // X coordinate (East)
-    int y;              // Y coordinate (North)
-    NodeType type;      // Type of node
-    Node* prev;         // Pointer to previous node
-    Node* next;         // Pointer to next node
-    
-    // Constructor
-    Node(int x_coord, int y_coord, NodeType node_type) : 
-        x(x_coord), y(y_coord), type(node_type), prev(nullptr), next(nullptr) {}
-};
+#include "logger.h"
+#include "node_allocator.h"
 
 // Doubly Linked List class
 class DoublyLinkedList {
+public:
+    // Nodes are referred to by pointer; nullptr marks "no node"
+    typedef Node* NodeHandle;
+    static constexpr NodeHandle kNullHandle = nullptr;
+
 private:
     Node* head;         // Pointer to the first node
     Node* tail;         // Pointer to the last node
     int size;           // Current size of the list
     int capacity;       // Maximum capacity of the list
+    NodeAllocator* allocator;   // Allocator providing node storage
+    NodePool* ownedPool;        // Pool created by the list itself (nullptr if external)
+    Node* latestNecessary;      // Last non-REGULAR node (nullptr if there is none)
+
+    // Copy the nodes of another list onto the end of this one
+    void appendFrom(const DoublyLinkedList& other);
+    
+    // Unlink and release the nodes strictly between first and last; returns the count
+    int removeRange(Node* first, Node* last);
 
 public:
-    // Constructor
+    // Constructor (nodes come from a private pool sized from the capacity)
     DoublyLinkedList(int max_capacity = 10);
     
+    // Constructor with an external node allocator (not owned by the list)
+    DoublyLinkedList(int max_capacity, NodeAllocator* node_allocator);
+    
+    // Copy constructor
+    DoublyLinkedList(const DoublyLinkedList& other);
+    
+    // Copy assignment
+    DoublyLinkedList& operator=(const DoublyLinkedList& other);
+    
     // Destructor
     ~DoublyLinkedList();
     
+    // Remove all nodes from the list
+    void clear();
+    
     // Insert a new node at the end of the list
     bool insert(int x, int y, NodeType type);
     
@@ -46,10 +52,10 @@ public:
     bool remove(int index);
     
     // Remove regular nodes between the current position and the latest necessary node
-    void removeRegularNodes();
+    int removeRegularNodes();
     
     // Remove regular nodes between two necessary nodes
-    void removeRegularNodesBetweenNecessary(Node* current, Node* previous);
+    int removeRegularNodesBetweenNecessary(Node* current, Node* previous);
     
     // Get the current size of the list
     int getSize() const;
@@ -63,8 +69,8 @@ public:
     // Check if the list is empty
     bool isEmpty() const;
     
-    // Print the list
-    void print() const;
+    // Print the list at the given log level
+    void print(LogLevel level = LOG_LEVEL_SUMMARY) const;
     
     // Get the head of the list
     Node* getHead() const;
@@ -72,6 +78,18 @@ public:
     // Get the tail of the list
     Node* getTail() const;
     
+    // Get the node after a node (nullptr at the tail)
+    Node* getNext(Node* node) const;
+    
+    // Get the X coordinate of a node
+    int getX(Node* node) const;
+    
+    // Get the Y coordinate of a node
+    int getY(Node* node) const;
+    
+    // Get the type of a node
+    NodeType getType(Node* node) const;
+    
     // Find the latest necessary node
     Node* findLatestNecessaryNode() const;
 };
@@ -0,0 +1,283 @@
+#include "dstar_lite.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+// Distance used for unreachable cells (leaves headroom for additions)
+static const int kInfinity = INT_MAX / 4;
+
+// Expansions between checks of the cancel flag, less one
+static const long long kCancelCheckMask = 1023;
+
+// Constructor
+DStarLite::DStarLite(const OccupancyGrid& map, int allowed_moves) :
+    grid(map), allowedMoves(allowed_moves), startX(0), startY(0), lastStartX(0), lastStartY(0),
+    goalX(0), goalY(0), km(0), initialized(false), cancelFlag(nullptr), lastRepair(), totalRepairs() {}
+
+// Heuristic distance from the robot to (x, y)
+int DStarLite::heuristic(int x, int y) const {
+    return std::abs(startX - x) + std::abs(startY - y);
+}
+
+// Calculate the priority key of a cell
+DStarKey DStarLite::calculateKey(int cell) const {
+    int best = std::min(g[cell], rhs[cell]);
+    int x = cell % grid.getWidth();
+    int y = cell / grid.getWidth();
+
+    DStarKey key;
+    key.k1 = (best >= kInfinity) ? kInfinity : best + heuristic(x, y) + km;
+    key.k2 = best;
+    return key;
+}
+
+// Recompute rhs of a cell and requeue it if inconsistent
+void DStarLite::updateVertex(int cell, RepairStats& stats) {
+    stats.updated++;
+    int x = cell % grid.getWidth();
+    int y = cell / grid.getWidth();
+
+    if (x != goalX || y != goalY) {
+        int best = kInfinity;
+
+        // A blocked cell cannot be the source of any step
+        if (!grid.isObstacleDetected(x, y)) {
+            for (int i = 0; i < kAxisMoveCount; i++) {
+                if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+                    continue;
+                }
+                int nx = x + kAxisMoves[i].dx;
+                int ny = y + kAxisMoves[i].dy;
+                if (grid.isObstacleDetected(nx, ny)) {
+                    continue;
+                }
+                int next = g[indexOf(nx, ny)];
+                if (next < kInfinity) {
+                    best = std::min(best, next + 1);
+                }
+            }
+        }
+
+        rhs[cell] = best;
+    }
+
+    // Keep exactly the inconsistent cells in the queue
+    if (g[cell] != rhs[cell]) {
+        queue.push(cell, calculateKey(cell));
+    } else {
+        queue.remove(cell);
+    }
+}
+
+// Update every cell that can step into the given cell
+void DStarLite::updatePredecessors(int cell, RepairStats& stats) {
+    int x = cell % grid.getWidth();
+    int y = cell / grid.getWidth();
+
+    for (int i = 0; i < kAxisMoveCount; i++) {
+        if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+            continue;
+        }
+        int px = x - kAxisMoves[i].dx;
+        int py = y - kAxisMoves[i].dy;
+        if (grid.isInBounds(px, py)) {
+            updateVertex(indexOf(px, py), stats);
+        }
+    }
+}
+
+// Expand cells until the robot's distance is consistent (false if stopped)
+bool DStarLite::computeShortestPath(RepairStats& stats) {
+    int startCell = indexOf(startX, startY);
+
+    while (!queue.isEmpty() &&
+           (queue.topKey() < calculateKey(startCell) || rhs[startCell] != g[startCell])) {
+        int cell = queue.top();
+        DStarKey oldKey = queue.topKey();
+        DStarKey newKey = calculateKey(cell);
+        stats.expanded++;
+        if ((stats.expanded & kCancelCheckMask) == 0 && cancelFlag != nullptr &&
+            cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        if (oldKey < newKey) {
+            // The key is stale because km grew; requeue with the current key
+            queue.push(cell, newKey);
+        } else if (g[cell] > rhs[cell]) {
+            // Overconsistent: the distance improved
+            g[cell] = rhs[cell];
+            queue.remove(cell);
+            updatePredecessors(cell, stats);
+        } else {
+            // Underconsistent: the distance got worse
+            g[cell] = kInfinity;
+            updateVertex(cell, stats);
+            updatePredecessors(cell, stats);
+        }
+    }
+
+    return true;
+}
+
+// Run the initial search from scratch
+bool DStarLite::initialize(int start_x, int start_y, int goal_x, int goal_y) {
+    startX = start_x;
+    startY = start_y;
+    lastStartX = start_x;
+    lastStartY = start_y;
+    goalX = goal_x;
+    goalY = goal_y;
+    km = 0;
+    pendingCells.clear();
+    lastRepair = RepairStats();
+    totalRepairs = RepairStats();
+    initialized = false;
+
+    if (!grid.isInBounds(startX, startY) || !grid.isInBounds(goalX, goalY)) {
+        return false;
+    }
+
+    // Every cell starts unreachable except the destination
+    size_t cellCount = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+    g.assign(cellCount, kInfinity);
+    rhs.assign(cellCount, kInfinity);
+    queue.reset(static_cast<int>(cellCount));
+
+    int goalCell = indexOf(goalX, goalY);
+    if (!grid.isObstacleDetected(goalX, goalY)) {
+        rhs[goalCell] = 0;
+        queue.push(goalCell, calculateKey(goalCell));
+    }
+
+    // The initial search is recorded as the first repair
+    if (!computeShortestPath(lastRepair)) {
+        return false;
+    }
+    totalRepairs = lastRepair;
+    initialized = true;
+
+    return getDistanceToGoal() >= 0;
+}
+
+// Check if the search state has been initialized
+bool DStarLite::isInitialized() const {
+    return initialized;
+}
+
+// Set a flag another thread raises to stop a running search (null for none)
+void DStarLite::setCancelFlag(const std::atomic<bool>* cancel) {
+    cancelFlag = cancel;
+}
+
+// Change the moves usable by the robot (the next search starts from scratch)
+void DStarLite::setAllowedMoves(int allowed_moves) {
+    if (allowed_moves != allowedMoves) {
+        allowedMoves = allowed_moves;
+        reset();
+    }
+}
+
+// Drop the search state so the next search starts from scratch
+void DStarLite::reset() {
+    initialized = false;
+    pendingCells.clear();
+}
+
+// Record a cell whose obstacle state changed in the grid
+void DStarLite::notifyCellChanged(int x, int y) {
+    if (initialized && grid.isInBounds(x, y)) {
+        pendingCells.push_back(indexOf(x, y));
+    }
+}
+
+// Check if there are changes waiting to be repaired
+bool DStarLite::hasPendingChanges() const {
+    return !pendingCells.empty();
+}
+
+// Update the robot position after it moved
+void DStarLite::moveStart(int x, int y) {
+    startX = x;
+    startY = y;
+}
+
+// Repair the search state after changes; returns false if nothing was pending
+bool DStarLite::repair() {
+    if (!initialized || pendingCells.empty()) {
+        return false;
+    }
+
+    lastRepair = RepairStats();
+    lastRepair.changedCells = static_cast<int>(pendingCells.size());
+
+    // Account for the distance the robot travelled since the last repair
+    km += std::abs(startX - lastStartX) + std::abs(startY - lastStartY);
+    lastStartX = startX;
+    lastStartY = startY;
+
+    // Edges into and out of each changed cell have new costs
+    for (int cell : pendingCells) {
+        updateVertex(cell, lastRepair);
+        updatePredecessors(cell, lastRepair);
+    }
+    pendingCells.clear();
+
+    // A stopped repair leaves inconsistent distances behind
+    if (!computeShortestPath(lastRepair)) {
+        initialized = false;
+        return true;
+    }
+
+    totalRepairs.changedCells += lastRepair.changedCells;
+    totalRepairs.expanded += lastRepair.expanded;
+    totalRepairs.updated += lastRepair.updated;
+
+    return true;
+}
+
+// Get the best next cell for the robot (false if the destination is unreachable)
+bool DStarLite::getNextStep(int& nextX, int& nextY) const {
+    if (!initialized) {
+        return false;
+    }
+
+    int best = kInfinity;
+    for (int i = 0; i < kAxisMoveCount; i++) {
+        if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+            continue;
+        }
+        int nx = startX + kAxisMoves[i].dx;
+        int ny = startY + kAxisMoves[i].dy;
+        if (grid.isObstacleDetected(nx, ny)) {
+            continue;
+        }
+        int cost = g[indexOf(nx, ny)];
+        if (cost < kInfinity && cost + 1 < best) {
+            best = cost + 1;
+            nextX = nx;
+            nextY = ny;
+        }
+    }
+
+    return best < kInfinity;
+}
+
+// Get the distance from the robot to the destination (-1 if unreachable)
+int DStarLite::getDistanceToGoal() const {
+    if (g.empty()) {
+        return -1;
+    }
+    int cost = g[indexOf(startX, startY)];
+    return (cost >= kInfinity) ? -1 : cost;
+}
+
+// Get the work done by the most recent repair
+const RepairStats& DStarLite::getLastRepairStats() const {
+    return lastRepair;
+}
+
+// Get the work done by all repairs since initialize
+const RepairStats& DStarLite::getTotalRepairStats() const {
+    return totalRepairs;
+}
@@ -0,0 +1,123 @@
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include "grid_search.h"
+#include "indexed_min_heap.h"
+#include "occupancy_grid.h"
+#include <atomic>
+#include <vector>
+
+// D* Lite priority key
+struct DStarKey {
+    int k1;             // min(g, rhs) + heuristic + km
+    int k2;             // min(g, rhs)
+
+    bool operator<(const DStarKey& other) const {
+        return k1 < other.k1 || (k1 == other.k1 && k2 < other.k2);
+    }
+};
+
+// Work done by one repair of the search state
+struct RepairStats {
+    int changedCells;       // Cells reported through notifyCellChanged
+    long long expanded;     // Cells popped from the priority queue
+    long long updated;      // Vertex updates (rhs recomputations)
+};
+
+// Incremental shortest-path planner (D* Lite)
+//
+// Distances are kept from every cell to the destination. When cells change
+// after the initial search, only the vertices whose distance is affected
+// are re-expanded, so the cost of a repair follows the size of the change
+// rather than the size of the map.
+class DStarLite {
+private:
+    const OccupancyGrid& grid;      // Map being searched
+    int allowedMoves;               // MoveSet flags usable by the robot
+
+    std::vector<int> g;             // Current distance estimate to the destination
+    std::vector<int> rhs;           // One-step lookahead distance
+    IndexedMinHeap<DStarKey> queue; // Locally inconsistent cells
+    std::vector<int> pendingCells;  // Changed cells not yet repaired
+
+    int startX;                     // Robot position
+    int startY;
+    int lastStartX;                 // Robot position at the last repair
+    int lastStartY;
+    int goalX;                      // Destination
+    int goalY;
+    int km;                         // Accumulated heuristic offset
+    bool initialized;
+    const std::atomic<bool>* cancelFlag;    // Stops a running search once set (null if none)
+
+    RepairStats lastRepair;         // Work done by the most recent repair
+    RepairStats totalRepairs;       // Work done by all repairs since initialize
+
+    // Get the cell index of (x, y)
+    int indexOf(int x, int y) const {
+        return y * grid.getWidth() + x;
+    }
+
+    // Heuristic distance from the robot to (x, y)
+    int heuristic(int x, int y) const;
+
+    // Calculate the priority key of a cell
+    DStarKey calculateKey(int cell) const;
+
+    // Recompute rhs of a cell and requeue it if inconsistent
+    void updateVertex(int cell, RepairStats& stats);
+
+    // Update every cell that can step into the given cell
+    void updatePredecessors(int cell, RepairStats& stats);
+
+    // Expand cells until the robot's distance is consistent (false if stopped)
+    bool computeShortestPath(RepairStats& stats);
+
+public:
+    // Constructor
+    DStarLite(const OccupancyGrid& map, int allowed_moves = MOVES_ALL);
+
+    // Run the initial search from scratch
+    bool initialize(int start_x, int start_y, int goal_x, int goal_y);
+
+    // Check if the search state has been initialized
+    bool isInitialized() const;
+
+    // Set a flag another thread raises to stop a running search (null for none)
+    //
+    // A stopped search leaves the planner uninitialized, so the next
+    // initialize starts from scratch.
+    void setCancelFlag(const std::atomic<bool>* cancel);
+
+    // Change the moves usable by the robot (the next search starts from scratch)
+    void setAllowedMoves(int allowed_moves);
+    
+    // Drop the search state so the next search starts from scratch
+    void reset();
+
+    // Record a cell whose obstacle state changed in the grid
+    void notifyCellChanged(int x, int y);
+
+    // Check if there are changes waiting to be repaired
+    bool hasPendingChanges() const;
+
+    // Update the robot position after it moved
+    void moveStart(int x, int y);
+
+    // Repair the search state after changes; returns false if nothing was pending
+    bool repair();
+
+    // Get the best next cell for the robot (false if the destination is unreachable)
+    bool getNextStep(int& nextX, int& nextY) const;
+
+    // Get the distance from the robot to the destination (-1 if unreachable)
+    int getDistanceToGoal() const;
+
+    // Get the work done by the most recent repair
+    const RepairStats& getLastRepairStats() const;
+
+    // Get the work done by all repairs since initialize
+    const RepairStats& getTotalRepairStats() const;
+};
+
+#endif // DSTAR_LITE_H
@@ -0,0 +1,292 @@
+#ifndef FIXED_PATH_LIST_H
+#define FIXED_PATH_LIST_H
+
+#include "logger.h"
+#include "path_node.h"
+#include <array>
+
+// Doubly linked path list with a compile-time capacity
+//
+// Nodes live in an inline std::array and link to each other by slot index,
+// so the list never touches the heap and copying it is a plain array copy.
+// The capacity is a template parameter, which lets the compiler fold
+// isFull and the bounds checks into constants. Nodes are referred to by
+// NodeHandle (a slot index); kNullHandle plays the role of nullptr.
+template <int Capacity>
+class FixedPathList {
+    static_assert(Capacity > 0, "FixedPathList needs a positive capacity");
+
+public:
+    typedef int NodeHandle;
+    static constexpr NodeHandle kNullHandle = -1;
+
+private:
+    // One node slot
+    struct Slot {
+        int x;              // X coordinate (East)
+        int y;              // Y coordinate (North)
+        NodeType type;      // Type of node
+        int prev;           // Slot of the previous node (kNullHandle if none)
+        int next;           // Slot of the next node, or the next free slot
+    };
+
+    std::array<Slot, Capacity> slots;
+    int head;               // Slot of the first node
+    int tail;               // Slot of the last node
+    int size;               // Current size of the list
+    int freeHead;           // First released slot (kNullHandle if none)
+    int nextUnused;         // First slot never handed out since the last clear
+    int latestNecessary;    // Last non-REGULAR node (kNullHandle if there is none)
+
+    // Take a slot from the free list or the untouched tail of the array
+    constexpr int allocateSlot() noexcept {
+        if (freeHead != kNullHandle) {
+            int slot = freeHead;
+            freeHead = slots[slot].next;
+            return slot;
+        }
+        return nextUnused++;
+    }
+
+    // Give a slot back to the free list
+    constexpr void releaseSlot(int slot) noexcept {
+        slots[slot].next = freeHead;
+        freeHead = slot;
+    }
+
+    // Unlink and release the nodes strictly between first and last; returns the count
+    constexpr int removeRange(int first, int last) noexcept {
+        int removed = 0;
+        int node = slots[first].next;
+        while (node != last) {
+            int next = slots[node].next;
+            releaseSlot(node);
+            removed++;
+            node = next;
+        }
+
+        // Close the gap with a single relink
+        slots[first].next = last;
+        slots[last].prev = first;
+        size -= removed;
+
+        return removed;
+    }
+
+public:
+    // Constructor
+    constexpr FixedPathList() noexcept :
+        slots(), head(kNullHandle), tail(kNullHandle), size(0),
+        freeHead(kNullHandle), nextUnused(0), latestNecessary(kNullHandle) {}
+
+    // Remove all nodes from the list (O(1): the slots are simply forgotten)
+    constexpr void clear() noexcept {
+        head = kNullHandle;
+        tail = kNullHandle;
+        size = 0;
+        freeHead = kNullHandle;
+        nextUnused = 0;
+        latestNecessary = kNullHandle;
+    }
+
+    // Insert a new node at the end of the list
+    constexpr bool insert(int x, int y, NodeType type) noexcept {
+        // Check if the list is full
+        if (isFull()) {
+            return false;
+        }
+
+        int slot = allocateSlot();
+        slots[slot].x = x;
+        slots[slot].y = y;
+        slots[slot].type = type;
+        slots[slot].prev = tail;
+        slots[slot].next = kNullHandle;
+
+        // Link the new node at the end
+        if (isEmpty()) {
+            head = slot;
+        } else {
+            slots[tail].next = slot;
+        }
+        tail = slot;
+
+        // Keep track of the latest necessary node as it is appended
+        if (type != REGULAR) {
+            latestNecessary = slot;
+        }
+
+        size++;
+        return true;
+    }
+
+    // Remove node at the specified index
+    constexpr bool remove(int index) noexcept {
+        // Check if the list is empty or if the index is out of bounds
+        if (isEmpty() || index < 0 || index >= size) {
+            return false;
+        }
+
+        // Find the node to remove, walking from whichever end is closer
+        int current = kNullHandle;
+        if (index < size / 2) {
+            current = head;
+            for (int i = 0; i < index; i++) {
+                current = slots[current].next;
+            }
+        } else {
+            current = tail;
+            for (int i = size - 1; i > index; i--) {
+                current = slots[current].prev;
+            }
+        }
+
+        // Removing the latest necessary node hands the role to the previous one
+        if (current == latestNecessary) {
+            latestNecessary = slots[current].prev;
+            while (latestNecessary != kNullHandle && slots[latestNecessary].type == REGULAR) {
+                latestNecessary = slots[latestNecessary].prev;
+            }
+        }
+
+        // Unlink the node from its neighbours
+        int prev = slots[current].prev;
+        int next = slots[current].next;
+        if (prev != kNullHandle) {
+            slots[prev].next = next;
+        } else {
+            head = next;
+        }
+        if (next != kNullHandle) {
+            slots[next].prev = prev;
+        } else {
+            tail = prev;
+        }
+
+        releaseSlot(current);
+        size--;
+        return true;
+    }
+
+    // Remove regular nodes between the current position and the latest necessary node
+    constexpr int removeRegularNodes() noexcept {
+        if (size <= 1) {
+            return 0;
+        }
+
+        // Everything after the latest necessary node is regular
+        int necessary = findLatestNecessaryNode();
+        if (necessary == tail) {
+            return 0;
+        }
+        return removeRange(necessary, tail);
+    }
+
+    // Remove regular nodes between two necessary nodes
+    constexpr int removeRegularNodesBetweenNecessary(NodeHandle current, NodeHandle previous) noexcept {
+        if (size <= 1 || current == kNullHandle || previous == kNullHandle) {
+            return 0;
+        }
+
+        int node = slots[previous].next;
+        int removed = 0;
+
+        // Remove regular nodes between previous and current
+        while (node != kNullHandle && node != current) {
+            int next = slots[node].next;
+            if (slots[node].type == REGULAR) {
+                slots[slots[node].prev].next = next;
+                slots[next].prev = slots[node].prev;
+                releaseSlot(node);
+                size--;
+                removed++;
+            }
+            node = next;
+        }
+
+        return removed;
+    }
+
+    // Get the current size of the list
+    constexpr int getSize() const noexcept {
+        return size;
+    }
+
+    // Get the capacity of the list
+    static constexpr int getCapacity() noexcept {
+        return Capacity;
+    }
+
+    // Check if the list is full
+    constexpr bool isFull() const noexcept {
+        return size >= Capacity;
+    }
+
+    // Check if the list is empty
+    constexpr bool isEmpty() const noexcept {
+        return size == 0;
+    }
+
+    // Get the head of the list
+    constexpr NodeHandle getHead() const noexcept {
+        return head;
+    }
+
+    // Get the tail of the list
+    constexpr NodeHandle getTail() const noexcept {
+        return tail;
+    }
+
+    // Get the node after a node (kNullHandle at the tail)
+    constexpr NodeHandle getNext(NodeHandle node) const noexcept {
+        return slots[node].next;
+    }
+
+    // Get the node before a node (kNullHandle at the head)
+    constexpr NodeHandle getPrev(NodeHandle node) const noexcept {
+        return slots[node].prev;
+    }
+
+    // Get the X coordinate of a node
+    constexpr int getX(NodeHandle node) const noexcept {
+        return slots[node].x;
+    }
+
+    // Get the Y coordinate of a node
+    constexpr int getY(NodeHandle node) const noexcept {
+        return slots[node].y;
+    }
+
+    // Get the type of a node
+    constexpr NodeType getType(NodeHandle node) const noexcept {
+        return slots[node].type;
+    }
+
+    // Find the latest necessary node
+    constexpr NodeHandle findLatestNecessaryNode() const noexcept {
+        // If no necessary node exists, return the head (kNullHandle when empty)
+        return (latestNecessary != kNullHandle) ? latestNecessary : head;
+    }
+
+    // Print the list at the given log level
+    void print(LogLevel level = LOG_LEVEL_SUMMARY) const {
+        // Skip the walk entirely when the level is not being written
+        if (level > PATH_PLANNER_LOG_LEVEL || !Logger::instance().isEnabled(level)) {
+            return;
+        }
+
+        if (isEmpty()) {
+            PLANNER_LOG(level, "List is empty");
+            return;
+        }
+
+        int index = 0;
+        for (int node = head; node != kNullHandle; node = slots[node].next) {
+            PLANNER_LOG(level, "Node " << index << ": (" << slots[node].x << ", " << slots[node].y << ") - "
+                        << getNodeTypeName(slots[node].type));
+            index++;
+        }
+    }
+};
+
+#endif // FIXED_PATH_LIST_H
@@ -0,0 +1,319 @@
+#include "grid_search.h"
+#include <algorithm>
+#include <cstdlib>
+
+// Expansions between checks of the cancel flag, less one
+static const long long kCancelCheckMask = 1023;
+
+// Get the sign of a value
+static int signOf(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// Write waypoints into a list as START_LOCATION/TURNING_NODE nodes (false if they do not fit)
+bool buildWaypointList(const std::vector<GridCell>& waypoints, DoublyLinkedList& out) {
+    out.clear();
+    if (waypoints.empty()) {
+        return false;
+    }
+
+    // The destination closes the route as its final waypoint
+    for (size_t i = 0; i < waypoints.size(); i++) {
+        NodeType type = (i == 0) ? START_LOCATION : TURNING_NODE;
+        if (!out.insert(waypoints[i].x, waypoints[i].y, type)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Constructor
+GridSearch::GridSearch(const OccupancyGrid& map, int allowed_moves, SearchMode search_mode) :
+    grid(map), allowedMoves(allowed_moves), mode(search_mode), searchStamp(0),
+    expansions(0), pathLength(-1), goalX(0), goalY(0), cancelFlag(nullptr) {}
+
+// Set the search algorithm
+void GridSearch::setMode(SearchMode search_mode) {
+    mode = search_mode;
+}
+
+// Set the allowed moves
+void GridSearch::setAllowedMoves(int allowed_moves) {
+    allowedMoves = allowed_moves;
+}
+
+// Set a flag another thread raises to stop a running search (null for none)
+void GridSearch::setCancelFlag(const std::atomic<bool>* cancel) {
+    cancelFlag = cancel;
+}
+
+// Check if a move along (dx, dy) is allowed
+bool GridSearch::isMoveAllowed(int dx, int dy) const {
+    for (int i = 0; i < kAxisMoveCount; i++) {
+        if (kAxisMoves[i].dx == dx && kAxisMoves[i].dy == dy) {
+            return (allowedMoves & kAxisMoves[i].flag) != 0;
+        }
+    }
+    return false;
+}
+
+// Heuristic distance from (x, y) to the destination
+int GridSearch::heuristic(int x, int y) const {
+    // Manhattan distance is exact on an empty 4-connected grid
+    return std::abs(goalX - x) + std::abs(goalY - y);
+}
+
+// Search for a route from start to destination
+bool GridSearch::findPath(int startX, int startY, int destX, int destY) {
+    goalX = destX;
+    goalY = destY;
+    waypoints.clear();
+    pathLength = -1;
+    expansions = 0;
+
+    // Both endpoints must be free cells on the map
+    if (!isFree(startX, startY) || !isFree(destX, destY)) {
+        return false;
+    }
+
+    // Size the per-cell state on first use or when the map changes size
+    size_t cellCount = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+    if (stamp.size() != cellCount) {
+        gScore.assign(cellCount, 0);
+        parent.assign(cellCount, -1);
+        stamp.assign(cellCount, 0);
+        searchStamp = 0;
+    }
+
+    // A new stamp invalidates the state of the previous search without clearing it
+    searchStamp++;
+    if (searchStamp == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        searchStamp = 1;
+    }
+    openSet.reset(static_cast<int>(cellCount));
+
+    // Open the start cell
+    relax(startX, startY, 0, -1);
+
+    while (!openSet.isEmpty()) {
+        int cell = openSet.pop();
+        int x = cell % grid.getWidth();
+        int y = cell / grid.getWidth();
+        expansions++;
+        if ((expansions & kCancelCheckMask) == 0 && cancelFlag != nullptr &&
+            cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        // The first time the destination is popped its cost is minimal
+        if (x == goalX && y == goalY) {
+            pathLength = gScore[cell];
+            buildWaypoints(cell);
+            return true;
+        }
+
+        if (mode == SEARCH_JUMP_POINT) {
+            expandJumpPoint(x, y, gScore[cell]);
+        } else {
+            expandAStar(x, y, gScore[cell]);
+        }
+    }
+
+    return false;
+}
+
+// Reach a cell with cost g from parentCell, opening it if it improved
+void GridSearch::relax(int x, int y, int g, int parentCell) {
+    int cell = indexOf(x, y);
+    if (stamp[cell] == searchStamp && g >= gScore[cell]) {
+        return;
+    }
+
+    stamp[cell] = searchStamp;
+    gScore[cell] = g;
+    parent[cell] = parentCell;
+
+    // Order by f, breaking ties towards the destination
+    int h = heuristic(x, y);
+    openSet.push(cell, (static_cast<int64_t>(g + h) << 32) | static_cast<int64_t>(h));
+}
+
+// Expand a cell as plain A*
+void GridSearch::expandAStar(int x, int y, int g) {
+    int cell = indexOf(x, y);
+    for (int i = 0; i < kAxisMoveCount; i++) {
+        if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+            continue;
+        }
+
+        int nx = x + kAxisMoves[i].dx;
+        int ny = y + kAxisMoves[i].dy;
+        if (isFree(nx, ny)) {
+            relax(nx, ny, g + 1, cell);
+        }
+    }
+}
+
+// Expand a cell as a jump point
+//
+// Canonical routes move vertically first and only turn from a horizontal
+// run into a vertical one where the cell diagonally behind is blocked
+// (a forced neighbour). Any other turn could be shifted earlier without
+// changing the route length, so those successors are pruned.
+void GridSearch::expandJumpPoint(int x, int y, int g) {
+    int cell = indexOf(x, y);
+    int parentCell = parent[cell];
+
+    // Collect the successor directions that survive pruning
+    int dirX[kAxisMoveCount];
+    int dirY[kAxisMoveCount];
+    int count = 0;
+
+    if (parentCell < 0) {
+        // The start cell may leave in any allowed direction
+        for (int i = 0; i < kAxisMoveCount; i++) {
+            if (allowedMoves & kAxisMoves[i].flag) {
+                dirX[count] = kAxisMoves[i].dx;
+                dirY[count] = kAxisMoves[i].dy;
+                count++;
+            }
+        }
+    } else {
+        int dx = signOf(x - parentCell % grid.getWidth());
+        int dy = signOf(y - parentCell / grid.getWidth());
+
+        if (dx != 0) {
+            // Horizontal arrival: keep going, or turn at a forced neighbour
+            dirX[count] = dx;
+            dirY[count] = 0;
+            count++;
+            for (int vy = -1; vy <= 1; vy += 2) {
+                if (isMoveAllowed(0, vy) && isFree(x, y + vy) && !isFree(x - dx, y + vy)) {
+                    dirX[count] = 0;
+                    dirY[count] = vy;
+                    count++;
+                }
+            }
+        } else {
+            // Vertical arrival: keep going or turn to either side
+            dirX[count] = 0;
+            dirY[count] = dy;
+            count++;
+            for (int hx = -1; hx <= 1; hx += 2) {
+                if (isMoveAllowed(hx, 0)) {
+                    dirX[count] = hx;
+                    dirY[count] = 0;
+                    count++;
+                }
+            }
+        }
+    }
+
+    // Jump along each direction and open the jump points found
+    for (int i = 0; i < count; i++) {
+        int jump = (dirX[i] != 0) ? jumpHorizontal(x, y, dirX[i]) : jumpVertical(x, y, dirY[i]);
+        if (jump < 0) {
+            continue;
+        }
+
+        int jx = jump % grid.getWidth();
+        int jy = jump / grid.getWidth();
+        relax(jx, jy, g + std::abs(jx - x) + std::abs(jy - y), cell);
+    }
+}
+
+// Jump horizontally from (x, y); returns the jump point index or -1
+int GridSearch::jumpHorizontal(int x, int y, int dx) const {
+    while (true) {
+        x += dx;
+        if (!isFree(x, y)) {
+            return -1;
+        }
+        if (x == goalX && y == goalY) {
+            return indexOf(x, y);
+        }
+
+        // Stop where a vertical neighbour opens up behind a blocked cell
+        for (int vy = -1; vy <= 1; vy += 2) {
+            if (isMoveAllowed(0, vy) && isFree(x, y + vy) && !isFree(x - dx, y + vy)) {
+                return indexOf(x, y);
+            }
+        }
+    }
+}
+
+// Jump vertically from (x, y); returns the jump point index or -1
+int GridSearch::jumpVertical(int x, int y, int dy) const {
+    while (true) {
+        y += dy;
+        if (!isFree(x, y)) {
+            return -1;
+        }
+        if (x == goalX && y == goalY) {
+            return indexOf(x, y);
+        }
+
+        // Stop where a horizontal scan from this cell finds something
+        for (int hx = -1; hx <= 1; hx += 2) {
+            if (isMoveAllowed(hx, 0) && jumpHorizontal(x, y, hx) >= 0) {
+                return indexOf(x, y);
+            }
+        }
+    }
+}
+
+// Rebuild the waypoint list from the parent links
+void GridSearch::buildWaypoints(int goalCell) {
+    // Collect the route from the destination back to the start
+    std::vector<GridCell> route;
+    for (int cell = goalCell; cell >= 0; cell = parent[cell]) {
+        GridCell point = {cell % grid.getWidth(), cell / grid.getWidth()};
+        route.push_back(point);
+    }
+    std::reverse(route.begin(), route.end());
+
+    // Keep the start, every cell where the heading changes and the destination
+    waypoints.clear();
+    int last = static_cast<int>(route.size()) - 1;
+    for (int i = 0; i <= last; i++) {
+        if (i == 0 || i == last) {
+            waypoints.push_back(route[i]);
+            continue;
+        }
+
+        int inX = signOf(route[i].x - route[i - 1].x);
+        int inY = signOf(route[i].y - route[i - 1].y);
+        int outX = signOf(route[i + 1].x - route[i].x);
+        int outY = signOf(route[i + 1].y - route[i].y);
+        if (inX != outX || inY != outY) {
+            waypoints.push_back(route[i]);
+        }
+    }
+}
+
+// Get the waypoints of the last route (start, turning cells, destination)
+const std::vector<GridCell>& GridSearch::getWaypoints() const {
+    return waypoints;
+}
+
+// Get the number of waypoints of the last route
+int GridSearch::getWaypointCount() const {
+    return static_cast<int>(waypoints.size());
+}
+
+// Write the last route into a list as START_LOCATION/TURNING_NODE waypoints
+bool GridSearch::buildPath(DoublyLinkedList& out) const {
+    return buildWaypointList(waypoints, out);
+}
+
+// Get the number of steps on the last route (-1 if none was found)
+int GridSearch::getPathLength() const {
+    return pathLength;
+}
+
+// Get the number of cells expanded by the last search
+long long GridSearch::getExpansions() const {
+    return expansions;
+}
@@ -0,0 +1,162 @@
+#ifndef GRID_SEARCH_H
+#define GRID_SEARCH_H
+
+#include "direction.h"
+#include "doubly_linked_list.h"
+#include "indexed_min_heap.h"
+#include "occupancy_grid.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Grid moves the search may use (bit flags)
+//
+// MOVE_DIAGONALS adds the diagonal between two allowed axis moves. Only the
+// robot's own step-by-step walker takes diagonals; the searches expand the
+// four axis moves and ignore the flag.
+enum MoveSet {
+    MOVE_POSITIVE_X = 1,    // East
+    MOVE_NEGATIVE_X = 2,    // West
+    MOVE_POSITIVE_Y = 4,    // North
+    MOVE_NEGATIVE_Y = 8,    // South
+    MOVE_DIAGONALS = 16,    // Diagonals between allowed axis moves
+    MOVES_NORTH_EAST = MOVE_POSITIVE_X | MOVE_POSITIVE_Y,
+    MOVES_ALL = MOVE_POSITIVE_X | MOVE_NEGATIVE_X | MOVE_POSITIVE_Y | MOVE_NEGATIVE_Y,
+    MOVES_ALL_DIAGONAL = MOVES_ALL | MOVE_DIAGONALS
+};
+
+// Check if a set of MoveSet flags allows driving in a direction
+inline bool isDirectionAllowed(Direction direction, int allowed_moves) {
+    int dx = 0;
+    int dy = 0;
+    getDirectionStep(direction, dx, dy);
+    int needed = (dx > 0 ? MOVE_POSITIVE_X : 0) | (dx < 0 ? MOVE_NEGATIVE_X : 0) |
+                 (dy > 0 ? MOVE_POSITIVE_Y : 0) | (dy < 0 ? MOVE_NEGATIVE_Y : 0) |
+                 (isDiagonal(direction) ? MOVE_DIAGONALS : 0);
+    return (allowed_moves & needed) == needed;
+}
+
+// One axis move of the grid searches and the MoveSet flag allowing it
+struct AxisMove {
+    int dx;
+    int dy;
+    int flag;
+};
+
+// Number of axis moves
+const int kAxisMoveCount = 4;
+
+// The axis moves in MoveSet order: east, west, north, south
+const AxisMove kAxisMoves[kAxisMoveCount] = {
+    {1, 0, MOVE_POSITIVE_X}, {-1, 0, MOVE_NEGATIVE_X}, {0, 1, MOVE_POSITIVE_Y}, {0, -1, MOVE_NEGATIVE_Y}
+};
+
+// Search algorithm enumeration
+enum SearchMode {
+    SEARCH_ASTAR,           // A* expanding every neighbouring cell
+    SEARCH_JUMP_POINT       // Jump Point Search for uniform-cost grids
+};
+
+// Grid cell coordinates
+struct GridCell {
+    int x;              // X coordinate (East)
+    int y;              // Y coordinate (North)
+};
+
+// Write waypoints into a list as START_LOCATION/TURNING_NODE nodes (false if they do not fit)
+bool buildWaypointList(const std::vector<GridCell>& waypoints, DoublyLinkedList& out);
+
+// Shortest-path search over an occupancy grid
+//
+// Finds a minimum-length 4-connected route with unit step cost using A*
+// with a binary heap and an indexed open set. The jump point mode prunes
+// symmetric routes and only pushes jump points onto the open set. The
+// result is reported as the list of cells where the heading changes.
+class GridSearch {
+private:
+    const OccupancyGrid& grid;      // Map being searched
+    int allowedMoves;               // MoveSet flags usable by the robot
+    SearchMode mode;                // Algorithm used by findPath
+
+    // Per-cell search state, valid only where stamp matches searchStamp
+    std::vector<int> gScore;        // Cost from the start
+    std::vector<int> parent;        // Previous cell (or jump point) on the route
+    std::vector<uint32_t> stamp;    // Search in which the cell was reached
+    uint32_t searchStamp;           // Current search number
+
+    IndexedMinHeap<int64_t> openSet;    // Cells keyed by f and then h
+    std::vector<GridCell> waypoints;    // Start, turning cells and destination
+
+    long long expansions;           // Cells popped from the open set
+    int pathLength;                 // Steps on the last route, -1 if none
+    int goalX;                      // Destination of the current search
+    int goalY;
+    const std::atomic<bool>* cancelFlag;    // Stops a running search once set (null if none)
+
+    // Get the cell index of (x, y)
+    int indexOf(int x, int y) const {
+        return y * grid.getWidth() + x;
+    }
+
+    // Check if the robot can stand on (x, y)
+    bool isFree(int x, int y) const {
+        return !grid.isObstacleDetected(x, y);
+    }
+
+    // Check if a move along (dx, dy) is allowed
+    bool isMoveAllowed(int dx, int dy) const;
+
+    // Heuristic distance from (x, y) to the destination
+    int heuristic(int x, int y) const;
+
+    // Reach a cell with cost g from parentCell, opening it if it improved
+    void relax(int x, int y, int g, int parentCell);
+
+    // Expand a cell as plain A*
+    void expandAStar(int x, int y, int g);
+
+    // Expand a cell as a jump point
+    void expandJumpPoint(int x, int y, int g);
+
+    // Jump horizontally from (x, y); returns the jump point index or -1
+    int jumpHorizontal(int x, int y, int dx) const;
+
+    // Jump vertically from (x, y); returns the jump point index or -1
+    int jumpVertical(int x, int y, int dy) const;
+
+    // Rebuild the waypoint list from the parent links
+    void buildWaypoints(int goalCell);
+
+public:
+    // Constructor
+    GridSearch(const OccupancyGrid& map, int allowed_moves = MOVES_ALL, SearchMode search_mode = SEARCH_ASTAR);
+
+    // Set the search algorithm
+    void setMode(SearchMode search_mode);
+
+    // Set the allowed moves
+    void setAllowedMoves(int allowed_moves);
+
+    // Set a flag another thread raises to stop a running search (null for none)
+    void setCancelFlag(const std::atomic<bool>* cancel);
+
+    // Search for a route from start to destination (false if none or stopped)
+    bool findPath(int startX, int startY, int destX, int destY);
+
+    // Get the waypoints of the last route (start, turning cells, destination)
+    const std::vector<GridCell>& getWaypoints() const;
+
+    // Get the number of waypoints of the last route
+    int getWaypointCount() const;
+
+    // Write the last route into a list as START_LOCATION/TURNING_NODE waypoints
+    bool buildPath(DoublyLinkedList& out) const;
+
+    // Get the number of steps on the last route (-1 if none was found)
+    int getPathLength() const;
+
+    // Get the number of cells expanded by the last search
+    long long getExpansions() const;
+};
+
+#endif // GRID_SEARCH_H
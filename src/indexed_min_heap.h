@@ -0,0 +1,164 @@
+#ifndef INDEXED_MIN_HEAP_H
+#define INDEXED_MIN_HEAP_H
+
+#include <utility>
+#include <vector>
+
+// Binary min-heap of grid cell indices with an index into the heap
+//
+// Each cell index maps to its current heap slot, so membership tests,
+// decrease-key and removal are O(1) / O(log n) without duplicate entries.
+template <typename Key>
+class IndexedMinHeap {
+private:
+    std::vector<int> heap;          // Cell indices in heap order
+    std::vector<Key> keys;          // Keys parallel to heap
+    std::vector<int> position;      // Heap slot of each cell, -1 if absent
+
+    // Swap two heap slots and fix their positions
+    void swapSlots(int a, int b) {
+        std::swap(heap[a], heap[b]);
+        std::swap(keys[a], keys[b]);
+        position[heap[a]] = a;
+        position[heap[b]] = b;
+    }
+
+    // Move the entry at slot i up until the heap property holds
+    void siftUp(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!(keys[i] < keys[parent])) {
+                break;
+            }
+            swapSlots(i, parent);
+            i = parent;
+        }
+    }
+
+    // Move the entry at slot i down until the heap property holds
+    void siftDown(int i) {
+        int count = static_cast<int>(heap.size());
+        while (true) {
+            int left = 2 * i + 1;
+            if (left >= count) {
+                break;
+            }
+            int smallest = left;
+            int right = left + 1;
+            if (right < count && keys[right] < keys[left]) {
+                smallest = right;
+            }
+            if (!(keys[smallest] < keys[i])) {
+                break;
+            }
+            swapSlots(i, smallest);
+            i = smallest;
+        }
+    }
+
+    // Remove the entry at slot i
+    void removeSlot(int i) {
+        int last = static_cast<int>(heap.size()) - 1;
+        position[heap[i]] = -1;
+        if (i != last) {
+            heap[i] = heap[last];
+            keys[i] = keys[last];
+            position[heap[i]] = i;
+        }
+        heap.pop_back();
+        keys.pop_back();
+
+        if (i < static_cast<int>(heap.size())) {
+            siftDown(i);
+            siftUp(i);
+        }
+    }
+
+public:
+    // Prepare the heap for cells in [0, cell_count) and empty it
+    void reset(int cell_count) {
+        clear();
+        if (static_cast<int>(position.size()) != cell_count) {
+            position.assign(cell_count, -1);
+        }
+    }
+
+    // Remove all entries (cost proportional to the number of entries)
+    void clear() {
+        for (int cell : heap) {
+            position[cell] = -1;
+        }
+        heap.clear();
+        keys.clear();
+    }
+
+    // Check if the heap is empty
+    bool isEmpty() const {
+        return heap.empty();
+    }
+
+    // Get the number of entries
+    int getSize() const {
+        return static_cast<int>(heap.size());
+    }
+
+    // Get the cell in heap slot i (0 <= i < getSize(), in no particular order)
+    int cellAt(int i) const {
+        return heap[i];
+    }
+
+    // Check if a cell is in the heap
+    bool contains(int cell) const {
+        return position[cell] >= 0;
+    }
+
+    // Get the cell with the smallest key
+    int top() const {
+        return heap.front();
+    }
+
+    // Get the smallest key
+    const Key& topKey() const {
+        return keys.front();
+    }
+
+    // Get the key of a cell in the heap
+    const Key& keyOf(int cell) const {
+        return keys[position[cell]];
+    }
+
+    // Insert a cell or change its key if it is already present
+    void push(int cell, const Key& key) {
+        int slot = position[cell];
+        if (slot >= 0) {
+            // Update in place and restore the heap property in either direction
+            keys[slot] = key;
+            siftUp(slot);
+            siftDown(position[cell]);
+            return;
+        }
+
+        heap.push_back(cell);
+        keys.push_back(key);
+        slot = static_cast<int>(heap.size()) - 1;
+        position[cell] = slot;
+        siftUp(slot);
+    }
+
+    // Remove and return the cell with the smallest key
+    int pop() {
+        int cell = heap.front();
+        removeSlot(0);
+        return cell;
+    }
+
+    // Remove a cell if it is in the heap
+    void remove(int cell) {
+        int slot = position[cell];
+        if (slot >= 0) {
+            removeSlot(slot);
+        }
+    }
+};
+
+#endif // INDEXED_MIN_HEAP_H
@@ -0,0 +1,184 @@
+#include "instrumentation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+// Live thread blocks and the totals of exited threads
+struct Registry {
+    std::mutex lock;
+    std::vector<const void*> blocks;
+    InstrumentSnapshot exited;
+
+    Registry() : exited(getEmptyInstrumentSnapshot()) {}
+};
+
+// Get the process-wide registry (never destroyed, so exiting threads can always reach it)
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+}
+
+// Constructor (registers the block)
+Instrumentation::ThreadBlock::ThreadBlock() {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counters[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        timerCalls[i].store(0, std::memory_order_relaxed);
+        timerTicks[i].store(0, std::memory_order_relaxed);
+    }
+
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    shared.blocks.push_back(this);
+}
+
+// Destructor (folds the block into the exited-thread totals)
+Instrumentation::ThreadBlock::~ThreadBlock() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    addTo(shared.exited);
+    shared.blocks.erase(std::find(shared.blocks.begin(), shared.blocks.end(), this));
+}
+
+// Add the block to a snapshot
+void Instrumentation::ThreadBlock::addTo(InstrumentSnapshot& snapshot) const {
+    double scale = getNanosecondsPerTick();
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        snapshot.counters[i] += counters[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        snapshot.timerCalls[i] += timerCalls[i].load(std::memory_order_relaxed);
+        snapshot.timerNanos[i] += std::llround(timerTicks[i].load(std::memory_order_relaxed) * scale);
+    }
+}
+
+// Get the length of one clock tick in nanoseconds (measured once on first use)
+double Instrumentation::getNanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    // Time a short busy wait with both clocks
+    static const double scale = [] {
+        std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+        uint64_t tickStart = readInstrumentClock();
+        while (std::chrono::steady_clock::now() - wallStart < std::chrono::milliseconds(2)) {}
+        double nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wallStart).count());
+        uint64_t ticks = readInstrumentClock() - tickStart;
+        return (ticks > 0) ? nanos / static_cast<double>(ticks) : 1.0;
+    }();
+    return scale;
+#else
+    return 1.0;
+#endif
+}
+
+// Get the calling thread's block
+Instrumentation::ThreadBlock& Instrumentation::local() {
+    thread_local ThreadBlock block;
+    return block;
+}
+
+// Get the totals of the calling thread
+InstrumentSnapshot Instrumentation::getThreadSnapshot() {
+    InstrumentSnapshot snapshot = getEmptyInstrumentSnapshot();
+    local().addTo(snapshot);
+    return snapshot;
+}
+
+// Get the totals of every thread, including threads that have exited
+InstrumentSnapshot Instrumentation::getSnapshot() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    InstrumentSnapshot snapshot = shared.exited;
+    for (const void* block : shared.blocks) {
+        static_cast<const ThreadBlock*>(block)->addTo(snapshot);
+    }
+    return snapshot;
+}
+
+// Get an all-zero snapshot
+InstrumentSnapshot getEmptyInstrumentSnapshot() {
+    InstrumentSnapshot snapshot;
+    std::fill(snapshot.counters, snapshot.counters + COUNTER_COUNT, 0);
+    std::fill(snapshot.timerCalls, snapshot.timerCalls + TIMER_COUNT, 0);
+    std::fill(snapshot.timerNanos, snapshot.timerNanos + TIMER_COUNT, 0);
+    return snapshot;
+}
+
+// Get the change from before to after
+InstrumentSnapshot subtractInstrumentSnapshots(const InstrumentSnapshot& after, const InstrumentSnapshot& before) {
+    InstrumentSnapshot difference;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        difference.counters[i] = after.counters[i] - before.counters[i];
+    }
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        difference.timerCalls[i] = after.timerCalls[i] - before.timerCalls[i];
+        difference.timerNanos[i] = after.timerNanos[i] - before.timerNanos[i];
+    }
+    return difference;
+}
+
+// Get the JSON key of a counter
+const char* getInstrumentCounterName(InstrumentCounter counter) {
+    switch (counter) {
+        case COUNTER_MOVES:
+            return "moves";
+        case COUNTER_TURNS:
+            return "turns";
+        case COUNTER_NODES_INSERTED:
+            return "nodes_inserted";
+        case COUNTER_NODES_REMOVED:
+            return "nodes_removed";
+        case COUNTER_CAPACITY_TRIGGERS:
+            return "capacity_triggers";
+        case COUNTER_TURNING_TRIGGERS:
+            return "turning_triggers";
+        case COUNTER_NECESSARY_LOOKUPS:
+            return "necessary_lookups";
+        case COUNTER_SENSOR_OBSERVATIONS:
+            return "sensor_observations";
+        default:
+            return "unknown";
+    }
+}
+
+// Get the JSON key of a timer
+const char* getInstrumentTimerName(InstrumentTimer timer) {
+    switch (timer) {
+        case TIMER_PLANNING:
+            return "planning";
+        case TIMER_MOVEMENT_PRIORITY:
+            return "movement_priority";
+        case TIMER_CAPACITY_TRIGGER:
+            return "capacity_trigger";
+        case TIMER_TURNING_TRIGGER:
+            return "turning_trigger";
+        default:
+            return "unknown";
+    }
+}
+
+// Write a snapshot as a JSON object
+void writeInstrumentationJson(std::ostream& out, const InstrumentSnapshot& snapshot) {
+    char number[32];
+    out << "{\n  \"enabled\": " << (PATH_PLANNER_INSTRUMENTATION ? "true" : "false") << ",\n  \"counters\": {";
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        out << (i == 0 ? "" : ", ") << '"' << getInstrumentCounterName(static_cast<InstrumentCounter>(i))
+            << "\": " << snapshot.counters[i];
+    }
+    out << "},\n  \"timers\": {";
+
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        long long calls = snapshot.timerCalls[i];
+        double mean = (calls > 0) ? static_cast<double>(snapshot.timerNanos[i]) / calls : 0.0;
+        std::snprintf(number, sizeof(number), "%.1f", mean);
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    \"" << getInstrumentTimerName(static_cast<InstrumentTimer>(i)) << "\": {\"calls\": " << calls
+            << ", \"total_ns\": " << snapshot.timerNanos[i] << ", \"mean_ns\": " << number << '}';
+    }
+    out << "\n  }\n}\n";
+}
@@ -0,0 +1,162 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Compile-time switch; with 0 every INSTRUMENT_* macro expands to nothing.
+// Build with -DPATH_PLANNER_INSTRUMENTATION=0 to compile the probes out.
+#ifndef PATH_PLANNER_INSTRUMENTATION
+#define PATH_PLANNER_INSTRUMENTATION 1
+#endif
+
+// Event counters
+enum InstrumentCounter {
+    COUNTER_MOVES,                  // Cells driven
+    COUNTER_TURNS,                  // Heading changes
+    COUNTER_NODES_INSERTED,         // Path nodes inserted by the planner
+    COUNTER_NODES_REMOVED,          // Path nodes removed by the planner's compactions
+    COUNTER_CAPACITY_TRIGGERS,      // Capacity compactions run by the planner
+    COUNTER_TURNING_TRIGGERS,       // Turning compactions run by the planner
+    COUNTER_NECESSARY_LOOKUPS,      // Latest necessary node lookups by the planner
+    COUNTER_SENSOR_OBSERVATIONS,    // Sensor observations drained by the planner
+    COUNTER_COUNT
+};
+
+// Timed regions
+enum InstrumentTimer {
+    TIMER_PLANNING,                 // executePlanningAlgorithm
+    TIMER_MOVEMENT_PRIORITY,        // determineMovementPriority
+    TIMER_CAPACITY_TRIGGER,         // handleCapacityTrigger
+    TIMER_TURNING_TRIGGER,          // handleTurningTrigger
+    TIMER_COUNT
+};
+
+// Counter and timer totals at one point in time
+struct InstrumentSnapshot {
+    long long counters[COUNTER_COUNT];
+    long long timerCalls[TIMER_COUNT];
+    long long timerNanos[TIMER_COUNT];
+};
+
+// Read the timer clock: the time-stamp counter on x86, nanoseconds elsewhere
+//
+// The TSC read is several times cheaper than steady_clock::now(). Ticks are
+// only converted to nanoseconds when a snapshot is taken.
+inline uint64_t readInstrumentClock() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Per-thread counters and timers
+//
+// Every thread updates its own block, so the hot path is a plain load and
+// store with no locked instruction and no shared cache line. A snapshot of
+// the process sums the live blocks and the totals of exited threads. When
+// PATH_PLANNER_INSTRUMENTATION is 0 nothing is ever recorded and every
+// snapshot is zero.
+class Instrumentation {
+private:
+    // Counters of one thread (registered with the process while it lives)
+    struct ThreadBlock {
+        std::atomic<long long> counters[COUNTER_COUNT];
+        std::atomic<long long> timerCalls[TIMER_COUNT];
+        std::atomic<long long> timerTicks[TIMER_COUNT];
+
+        // Constructor (registers the block)
+        ThreadBlock();
+
+        // Destructor (folds the block into the exited-thread totals)
+        ~ThreadBlock();
+
+        // Add the block to a snapshot
+        void addTo(InstrumentSnapshot& snapshot) const;
+    };
+
+    // Get the calling thread's block
+    static ThreadBlock& local();
+
+    // Add to a counter owned by the calling thread
+    static void bump(std::atomic<long long>& value, long long amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+public:
+    // Add to a counter of the calling thread
+    static void add(InstrumentCounter counter, long long amount) {
+        bump(local().counters[counter], amount);
+    }
+
+    // Add one timed call to a timer of the calling thread
+    static void addTime(InstrumentTimer timer, uint64_t ticks) {
+        ThreadBlock& block = local();
+        bump(block.timerCalls[timer], 1);
+        bump(block.timerTicks[timer], static_cast<long long>(ticks));
+    }
+
+    // Get the length of one clock tick in nanoseconds (measured once on first use)
+    static double getNanosecondsPerTick();
+
+    // Get the totals of the calling thread
+    static InstrumentSnapshot getThreadSnapshot();
+
+    // Get the totals of every thread, including threads that have exited
+    static InstrumentSnapshot getSnapshot();
+};
+
+// Times the enclosing scope into a timer
+class ScopedInstrumentTimer {
+private:
+    InstrumentTimer timer;
+    uint64_t start;
+
+public:
+    // Constructor (starts timing)
+    explicit ScopedInstrumentTimer(InstrumentTimer scope_timer) :
+        timer(scope_timer), start(readInstrumentClock()) {}
+
+    // Destructor (records the elapsed time)
+    ~ScopedInstrumentTimer() {
+        Instrumentation::addTime(timer, readInstrumentClock() - start);
+    }
+
+    ScopedInstrumentTimer(const ScopedInstrumentTimer&) = delete;
+    ScopedInstrumentTimer& operator=(const ScopedInstrumentTimer&) = delete;
+};
+
+// Get an all-zero snapshot
+InstrumentSnapshot getEmptyInstrumentSnapshot();
+
+// Get the change from before to after
+InstrumentSnapshot subtractInstrumentSnapshots(const InstrumentSnapshot& after, const InstrumentSnapshot& before);
+
+// Get the JSON key of a counter
+const char* getInstrumentCounterName(InstrumentCounter counter);
+
+// Get the JSON key of a timer
+const char* getInstrumentTimerName(InstrumentTimer timer);
+
+// Write a snapshot as a JSON object
+void writeInstrumentationJson(std::ostream& out, const InstrumentSnapshot& snapshot);
+
+#if PATH_PLANNER_INSTRUMENTATION
+#define INSTRUMENT_ADD(counter, amount) Instrumentation::add(counter, amount)
+#define INSTRUMENT_COUNT(counter) Instrumentation::add(counter, 1)
+#define INSTRUMENT_SCOPE(timer) ScopedInstrumentTimer instrumentTimer_(timer)
+#else
+// Probes compiled out: the amount is not evaluated
+#define INSTRUMENT_ADD(counter, amount) do {} while (0)
+#define INSTRUMENT_COUNT(counter) do {} while (0)
+#define INSTRUMENT_SCOPE(timer) do {} while (0)
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,181 @@
+#include "logger.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// Constructor
+Logger::Logger() :
+    enqueuePos(0), dequeuePos(0), writtenPos(0), runtimeLevel(LOG_LEVEL_TRACE),
+    running(true), output(&std::cout) {
+
+    // Each slot starts ready for the producer at its own position
+    for (size_t i = 0; i < kSlotCount; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+        slots[i].length = 0;
+    }
+
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+// Destructor (drains the ring and stops the writer)
+Logger::~Logger() {
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+// Get the process-wide logger
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+// Set the runtime log level
+void Logger::setLevel(LogLevel level) {
+    runtimeLevel.store(level, std::memory_order_relaxed);
+}
+
+// Get the runtime log level
+LogLevel Logger::getLevel() const {
+    return static_cast<LogLevel>(runtimeLevel.load(std::memory_order_relaxed));
+}
+
+// Set the destination stream (call before logging starts)
+void Logger::setOutput(std::ostream& stream) {
+    flush();
+    output = &stream;
+}
+
+// Queue a chunk of text
+void Logger::write(const char* text, int length) {
+    if (length <= 0) {
+        return;
+    }
+    if (length > kLogSlotBytes) {
+        length = kLogSlotBytes;
+    }
+
+    // Claim a slot (bounded MPMC ring, one consumer)
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots[pos & (kSlotCount - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        long difference = static_cast<long>(sequence) - static_cast<long>(pos);
+
+        if (difference == 0) {
+            // The slot is free for this position; try to claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The ring is full; let the writer catch up
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            // Another producer claimed this position first
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Fill the slot and publish it to the writer
+    std::memcpy(slot->text, text, static_cast<size_t>(length));
+    slot->length = length;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+// Block until everything queued so far has been written
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    while (writtenPos.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+// Write every message currently in the ring; returns the number written
+int Logger::drain() {
+    int count = 0;
+    while (true) {
+        Slot& slot = slots[dequeuePos & (kSlotCount - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            break;
+        }
+
+        output->write(slot.text, slot.length);
+
+        // Hand the slot back to producers one lap later
+        slot.sequence.store(dequeuePos + kSlotCount, std::memory_order_release);
+        dequeuePos++;
+        count++;
+    }
+    return count;
+}
+
+// Writer thread body
+void Logger::writerLoop() {
+    while (true) {
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        if (drain() > 0) {
+            // Flush once per burst instead of once per line
+            output->flush();
+            writtenPos.store(dequeuePos, std::memory_order_release);
+            continue;
+        }
+
+        // Producers that already claimed a slot may still be filling it
+        if (stopping && dequeuePos == enqueuePos.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+// Constructor
+LogLine::LogLine() : std::streambuf(), std::ostream(this) {
+    setp(buffer, buffer + kLogSlotBytes);
+}
+
+// Destructor (terminates the line and queues it)
+LogLine::~LogLine() {
+    if (pptr() == epptr()) {
+        sendChunk();
+    }
+    *pptr() = '\n';
+    pbump(1);
+    sendChunk();
+}
+
+// Hand the buffered bytes to the logger
+void LogLine::sendChunk() {
+    Logger::instance().write(pbase(), static_cast<int>(pptr() - pbase()));
+    setp(buffer, buffer + kLogSlotBytes);
+}
+
+// Called by the stream when the buffer is full
+int LogLine::overflow(int ch) {
+    sendChunk();
+    if (ch != std::streambuf::traits_type::eof()) {
+        *pptr() = static_cast<char>(ch);
+        pbump(1);
+    }
+    return std::streambuf::traits_type::not_eof(ch);
+}
+
+// Parse a level name (off/summary/step/trace); returns false if unknown
+bool parseLogLevel(const char* name, LogLevel& level) {
+    if (std::strcmp(name, "off") == 0) {
+        level = LOG_LEVEL_OFF;
+    } else if (std::strcmp(name, "summary") == 0) {
+        level = LOG_LEVEL_SUMMARY;
+    } else if (std::strcmp(name, "step") == 0) {
+        level = LOG_LEVEL_STEP;
+    } else if (std::strcmp(name, "trace") == 0) {
+        level = LOG_LEVEL_TRACE;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,141 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+// Compile-time log level; messages above it are compiled out entirely.
+// Build with -DPATH_PLANNER_LOG_LEVEL=0 for a silent build.
+#ifndef PATH_PLANNER_LOG_LEVEL
+#define PATH_PLANNER_LOG_LEVEL 3
+#endif
+
+// Log level enumeration
+enum LogLevel {
+    LOG_LEVEL_OFF = 0,      // No output
+    LOG_LEVEL_SUMMARY = 1,  // Setup, results and errors
+    LOG_LEVEL_STEP = 2,     // One line per move, turn, node and trigger
+    LOG_LEVEL_TRACE = 3     // Full path dumps
+};
+
+// Size of one queued message chunk
+const int kLogSlotBytes = 256;
+
+// Asynchronous logger
+//
+// Producers format into a stack buffer and copy it into a bounded lock-free
+// ring buffer; a background thread drains the ring to the output stream and
+// only flushes when the ring runs empty. A full ring makes the producer
+// yield until the writer catches up, so no message is lost.
+class Logger {
+private:
+    // One ring buffer entry
+    struct Slot {
+        std::atomic<size_t> sequence;   // Ring position the slot is ready for
+        int length;                     // Bytes used in text
+        char text[kLogSlotBytes];       // Message bytes (not terminated)
+    };
+
+    static const size_t kSlotCount = 1024;  // Must be a power of two
+
+    Slot slots[kSlotCount];
+    std::atomic<size_t> enqueuePos;     // Next position claimed by a producer
+    size_t dequeuePos;                  // Next position read by the writer
+    std::atomic<size_t> writtenPos;     // Positions written and flushed so far
+    std::atomic<int> runtimeLevel;      // Current runtime level
+    std::atomic<bool> running;          // Cleared to stop the writer
+    std::ostream* output;               // Destination stream
+    std::thread writer;                 // Background writer thread
+
+    // Constructor
+    Logger();
+
+    // Destructor (drains the ring and stops the writer)
+    ~Logger();
+
+    // Writer thread body
+    void writerLoop();
+
+    // Write every message currently in the ring; returns the number written
+    int drain();
+
+public:
+    // Get the process-wide logger
+    static Logger& instance();
+
+    // Set the runtime log level
+    void setLevel(LogLevel level);
+
+    // Get the runtime log level
+    LogLevel getLevel() const;
+
+    // Check if messages at a level are currently written
+    bool isEnabled(LogLevel level) const {
+        return level != LOG_LEVEL_OFF && level <= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    // Set the destination stream (call before logging starts)
+    void setOutput(std::ostream& stream);
+
+    // Queue a chunk of text
+    void write(const char* text, int length);
+
+    // Block until everything queued so far has been written
+    void flush();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+};
+
+// Stream that formats one log message into a fixed stack buffer
+//
+// Messages longer than one slot are handed to the logger in several
+// chunks, so formatting never allocates.
+class LogLine : private std::streambuf, public std::ostream {
+private:
+    char buffer[kLogSlotBytes];
+
+    // Hand the buffered bytes to the logger
+    void sendChunk();
+
+    // Called by the stream when the buffer is full
+    int overflow(int ch) override;
+
+public:
+    // Constructor
+    LogLine();
+
+    // Destructor (terminates the line and queues it)
+    ~LogLine();
+};
+
+// Parse a level name (off/summary/step/trace); returns false if unknown
+bool parseLogLevel(const char* name, LogLevel& level);
+
+#if PATH_PLANNER_LOG_LEVEL > 0
+#define PLANNER_LOG(level, expr) \
+    do { \
+        if ((level) <= PATH_PLANNER_LOG_LEVEL && Logger::instance().isEnabled(level)) { \
+            LogLine logLine_; \
+            logLine_ << expr; \
+        } \
+    } while (0)
+#else
+// Silent build: the statement is still type-checked but never evaluated
+#define PLANNER_LOG(level, expr) \
+    do { \
+        if (false && (level) > LOG_LEVEL_OFF) { \
+            LogLine logLine_; \
+            logLine_ << expr; \
+        } \
+    } while (0)
+#endif
+
+#define LOG_SUMMARY(expr) PLANNER_LOG(LOG_LEVEL_SUMMARY, expr)
+#define LOG_STEP(expr) PLANNER_LOG(LOG_LEVEL_STEP, expr)
+#define LOG_TRACE(expr) PLANNER_LOG(LOG_LEVEL_TRACE, expr)
+
+#endif // LOGGER_H
@@ -1,109 +1,99 @@
+#include "logger.h"
+#include "map_file.h"
 #include "robot_path_planner.h"
-#include <iostream>
+#include "simulated_hardware.h"
+#include "telemetry.h"
+#include <fstream>
+#include <memory>
 #include <string>
 
-// Simulated VEX robot hardware interface
-namespace vex {
-    // Motor class
-    class motor {
-    public:
-        void setVelocity(double velocity, const std::string& unit) {
-            std::cout << "Motor velocity set to " << velocity << " " << unit << std::endl;
-        }
-    };
+// Main function
+int main(int argc, char** argv) {
+    // Select the runtime log level (trace by default)
+    LogLevel level = LOG_LEVEL_TRACE;
+    if (argc > 2 && parseLogLevel(argv[2], level)) {
+        Logger::instance().setLevel(level);
+    }
     
-    // Inertial Measurement Unit (IMU) class
-    class inertial {
-    public:
-        void calibrate() {
-            std::cout << "IMU calibration started" << std::endl;
-            calibrating = true;
-        }
-        
-        bool isCalibrating() {
-            if (calibrating) {
-                calibrating = false;
-                return true;
-            }
-            return false;
-        }
-        
-        double angle(const std::string& unit) {
-            return 180.0; // Simulated angle
-        }
-        
-    private:
-        bool calibrating = false;
-    };
+    LOG_SUMMARY("Robot Path Planning Lab - Implementation");
+    LOG_SUMMARY("=======================================");
     
-    // Drivetrain class
-    class drivetrain {
-    public:
-        void turn(const std::string& direction) {
-            std::cout << "Drivetrain turning " << direction << std::endl;
-        }
-        
-        void stop(const std::string& mode) {
-            std::cout << "Drivetrain stopped with " << mode << " mode" << std::endl;
+    // Use a binary map file (argv[3], "-" for none) as the obstacle grid when one is given
+    MappedMapFile mapFile;
+    std::unique_ptr<FixedRobotPathPlanner> planner;
+    if (argc > 3 && std::string(argv[3]) != "-") {
+        std::string error;
+        if (!mapFile.open(argv[3], error, true)) {
+            LOG_SUMMARY("Cannot load map: " << error);
+            Logger::instance().flush();
+            return 1;
         }
-    };
-    
-    // Constants
-    const std::string rpm = "rpm";
-    const std::string degrees = "degrees";
-    const std::string seconds = "seconds";
-    const std::string msec = "msec";
-    const std::string right = "right";
-    const std::string brake = "brake";
-}
-
-// Global VEX robot objects
-vex::motor left_motor;
-vex::motor right_motor;
-vex::inertial imu;
-vex::drivetrain Drivetrain;
-
-// Wait function to simulate time delays
-void wait(double time, const std::string& unit) {
-    std::cout << "Waiting for " << time << " " << unit << std::endl;
-}
-
-// Calibrate inertial function as provided in the appendix
-void cali_inertial() {
-    left_motor.setVelocity(15, vex::rpm);
-    right_motor.setVelocity(15, vex::rpm);
+        planner.reset(new FixedRobotPathPlanner(mapFile));
+        LOG_SUMMARY("Loaded " << mapFile.getHeader().width << "x" << mapFile.getHeader().height
+                    << " map from " << argv[3]);
+    } else {
+        // Initialize the robot path planner
+        // Starting at (0,0), destination at (18,18), map size 20x20
+        planner.reset(new FixedRobotPathPlanner(0, 0, 18, 18, 20, 20));
+    }
+    FixedRobotPathPlanner& pathPlanner = *planner;
     
-    imu.calibrate();
-    while (imu.isCalibrating()) {}
-    wait(1, vex::seconds);
-    Drivetrain.turn(vex::right);
-    wait(400, vex::msec);
+    // Drive a simulated robot (virtual clock) so the run reports a mission time
+    SimulatedHardware hardware;
+    pathPlanner.setHardware(&hardware);
     
-    while (imu.angle(vex::degrees) < 166.0) {}
-    Drivetrain.stop(vex::brake);
-    wait(1, vex::seconds);
-}
-
-// Main function
-int main() {
-    std::cout << "Robot Path Planning Lab - Implementation" << std::endl;
-    std::cout << "=======================================" << std::endl;
+    // Record a binary event stream to argv[4] ("-" for none) when one is given
+    TelemetryWriter telemetry;
+    if (argc > 4 && std::string(argv[4]) != "-") {
+        std::string error;
+        if (!telemetry.open(argv[4], kRobotPathCapacity, error)) {
+            LOG_SUMMARY("Cannot record telemetry: " << error);
+            Logger::instance().flush();
+            return 1;
+        }
+        pathPlanner.setTelemetry(&telemetry);
+    }
     
     // Create obstacles for testing
     // These coordinates match the red squares in the map description
     // You would replace these with actual obstacle detection in a real robot
-    const int NUM_OBSTACLES = 4;
-    int obstacleX[NUM_OBSTACLES] = {5, 10, 15, 10};
-    int obstacleY[NUM_OBSTACLES] = {5, 10, 5, 15};
+    if (!mapFile.isOpen()) {
+        const int NUM_OBSTACLES = 4;
+        int obstacleX[NUM_OBSTACLES] = {5, 10, 15, 10};
+        int obstacleY[NUM_OBSTACLES] = {5, 10, 5, 15};
+        
+        // Add obstacles to the map
+        for (int i = 0; i < NUM_OBSTACLES; i++) {
+            pathPlanner.markObstacle(obstacleX[i], obstacleY[i]);
+            LOG_SUMMARY("Obstacle added at (" << obstacleX[i] << ", " << obstacleY[i] << ")");
+        }
+    }
     
-    // Initialize the robot path planner
-    // Starting at (0,0), destination at (18,18), map size 20x20
-    RobotPathPlanner pathPlanner(0, 0, 18, 18, 20, 20);
+    // Select the planning mode (greedy by default); a "-pipelined" suffix plans on a worker thread
+    std::string mode = (argc > 1) ? argv[1] : "greedy";
+    const std::string pipelinedSuffix = "-pipelined";
+    if (mode.size() > pipelinedSuffix.size() &&
+        mode.compare(mode.size() - pipelinedSuffix.size(), pipelinedSuffix.size(), pipelinedSuffix) == 0) {
+        mode.erase(mode.size() - pipelinedSuffix.size());
+        pathPlanner.setExecutionMode(EXECUTION_PIPELINED);
+    }
+    if (mode == "astar") {
+        pathPlanner.setPlannerMode(ASTAR_PLANNER);
+    } else if (mode == "jps") {
+        pathPlanner.setPlannerMode(JUMP_POINT_PLANNER);
+    } else if (mode == "dstar") {
+        pathPlanner.setPlannerMode(INCREMENTAL_PLANNER);
+    } else if (mode == "turns") {
+        pathPlanner.setPlannerMode(TURN_AWARE_PLANNER);
+    } else if (mode == "anytime") {
+        pathPlanner.setPlannerMode(ANYTIME_PLANNER);
+    }
     
-    // Add obstacles to the map
-    for (int i = 0; i < NUM_OBSTACLES; i++) {
-        pathPlanner.markObstacle(obstacleX[i], obstacleY[i]);
-        std::cout << "Obstacle added at (" << obstacleX[i] << ", " << obstacleY[i] << ")" << std::endl;
+    // Dump the planner instrumentation as JSON to argv[5] when one is given
+    std::ofstream instrumentation;
+    if (argc > 5) {
+        instrumentation.open(argv[5]);
+        pathPlanner.setInstrumentationOutput(&instrumentation);
     }
     
     // Initialize the robot
@@ -113,8 +103,23 @@ int main() {
     pathPlanner.executePlanningAlgorithm();
     
     // Print the final path
-    std::cout << "\nFinal path:" << std::endl;
+    LOG_SUMMARY("\nFinal path:");
     pathPlanner.getPath().print();
     
+    // Summarize the full driven route
+    const SegmentPath& driven = pathPlanner.getSegmentPath();
+    LOG_SUMMARY("Driven route: " << driven.getNodeCount() << " nodes in "
+                << driven.getSegmentCount() << " segments");
+    LOG_SUMMARY("Mission time: " << hardware.getTime() << " s simulated, "
+                << hardware.getDistanceDriven() << " cm driven");
+    if (telemetry.isOpen()) {
+        telemetry.close();
+        LOG_SUMMARY("Telemetry: " << telemetry.getWrittenCount() << " events written, "
+                    << telemetry.getDroppedCount() << " dropped");
+    }
+    
+    // Wait for the background writer before exiting
+    Logger::instance().flush();
+    
     return 0;
 }
@@ -0,0 +1,236 @@
+#include "map_file.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+// Check that the host stores integers the way the file does
+bool isLittleEndianHost() {
+    const uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+}
+
+// Checksum of a payload: 64-bit FNV-1a over its little-endian words
+uint64_t computeMapChecksum(const uint64_t* words, size_t count) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < count; i++) {
+        hash ^= words[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Write a grid and its start/destination as a binary map file
+bool writeMapFile(const std::string& path, const OccupancyGrid& grid, GridCell start, GridCell dest,
+                  std::string& error) {
+    if (!isLittleEndianHost()) {
+        error = "binary maps are little-endian; this host is not";
+        return false;
+    }
+
+    size_t wordCount = static_cast<size_t>(grid.getWordsPerRow()) * grid.getHeight();
+
+    MapFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMapFileMagic, sizeof(header.magic));
+    header.version = kMapFileVersion;
+    header.headerBytes = sizeof(MapFileHeader);
+    header.width = grid.getWidth();
+    header.height = grid.getHeight();
+    header.startX = start.x;
+    header.startY = start.y;
+    header.destX = dest.x;
+    header.destY = dest.y;
+    header.wordsPerRow = static_cast<uint32_t>(grid.getWordsPerRow());
+    header.flags = 0;
+    header.payloadBytes = wordCount * sizeof(uint64_t);
+    header.checksum = computeMapChecksum(grid.getWords(), wordCount);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(grid.getWords()), static_cast<std::streamsize>(header.payloadBytes));
+    if (!out) {
+        error = "cannot write '" + path + "'";
+        return false;
+    }
+    return true;
+}
+
+// Read an ASCII-art map
+bool readAsciiMap(std::istream& in, std::unique_ptr<OccupancyGrid>& grid, GridCell& start, GridCell& dest,
+                  std::string& error) {
+    std::vector<std::string> rows;
+    std::string line;
+    size_t width = 0;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (!line.empty() && line[0] == ';') {
+            continue;
+        }
+        rows.push_back(line);
+        if (line.size() > width) {
+            width = line.size();
+        }
+    }
+
+    // Trailing empty lines are not rows
+    while (!rows.empty() && rows.back().empty()) {
+        rows.pop_back();
+    }
+    if (rows.empty() || width == 0) {
+        error = "map has no cells";
+        return false;
+    }
+
+    int height = static_cast<int>(rows.size());
+    grid.reset(new OccupancyGrid(static_cast<int>(width), height));
+    start = GridCell{0, 0};
+    dest = GridCell{static_cast<int>(width) - 1, height - 1};
+
+    // The first line is the northmost row
+    for (int row = 0; row < height; row++) {
+        int y = height - 1 - row;
+        const std::string& text = rows[row];
+        for (size_t column = 0; column < text.size(); column++) {
+            int x = static_cast<int>(column);
+            char cell = text[column];
+            if (cell == '#' || cell == 'X') {
+                grid->markObstacle(x, y);
+            } else if (cell == 'S') {
+                start = GridCell{x, y};
+            } else if (cell == 'D') {
+                dest = GridCell{x, y};
+            }
+        }
+    }
+    return true;
+}
+
+// Write a grid as an ASCII-art map in the format read by readAsciiMap
+void writeAsciiMap(std::ostream& out, const OccupancyGrid& grid, GridCell start, GridCell dest) {
+    std::string text(static_cast<size_t>(grid.getWidth()), '.');
+    for (int y = grid.getHeight() - 1; y >= 0; y--) {
+        for (int x = 0; x < grid.getWidth(); x++) {
+            char cell = grid.isObstacleDetected(x, y) ? '#' : '.';
+            if (x == start.x && y == start.y) {
+                cell = 'S';
+            } else if (x == dest.x && y == dest.y) {
+                cell = 'D';
+            }
+            text[x] = cell;
+        }
+        out << text << '\n';
+    }
+}
+
+// Constructor
+MappedMapFile::MappedMapFile() : mapping(nullptr), mappingBytes(0), header(nullptr) {}
+
+// Destructor (unmaps the file)
+MappedMapFile::~MappedMapFile() {
+    close();
+}
+
+// Map a file and check its header; the payload checksum is only read when asked
+bool MappedMapFile::open(const std::string& path, std::string& error, bool verify_checksum) {
+    close();
+    if (!isLittleEndianHost()) {
+        error = "binary maps are little-endian; this host is not";
+        return false;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MapFileHeader)) {
+        ::close(fd);
+        error = "'" + path + "' is too short for a map header";
+        return false;
+    }
+
+    // Private writable mapping: pages are shared with the page cache until written
+    size_t bytes = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        error = "cannot map '" + path + "'";
+        return false;
+    }
+    mapping = address;
+    mappingBytes = bytes;
+    header = static_cast<const MapFileHeader*>(address);
+
+    // Validate the header against the file size before anything reads the payload
+    const char* problem = nullptr;
+    if (std::memcmp(header->magic, kMapFileMagic, sizeof(header->magic)) != 0) {
+        problem = "not a binary map file";
+    } else if (header->version != kMapFileVersion) {
+        problem = "unsupported map file version";
+    } else if (header->headerBytes != sizeof(MapFileHeader)) {
+        problem = "unexpected header size";
+    } else if (header->width <= 0 || header->height <= 0 ||
+               header->wordsPerRow != static_cast<uint32_t>(OccupancyGrid::wordsForWidth(header->width))) {
+        problem = "bad map dimensions";
+    } else if (header->payloadBytes !=
+               static_cast<uint64_t>(header->wordsPerRow) * static_cast<uint64_t>(header->height) * 8u ||
+               header->payloadBytes > bytes - sizeof(MapFileHeader)) {
+        problem = "payload size does not match the file";
+    } else if (verify_checksum && !verifyChecksum()) {
+        problem = "payload checksum mismatch";
+    }
+
+    if (problem != nullptr) {
+        error = "'" + path + "': " + problem;
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmap the file
+void MappedMapFile::close() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingBytes);
+    }
+    mapping = nullptr;
+    mappingBytes = 0;
+    header = nullptr;
+}
+
+// Check if a file is mapped
+bool MappedMapFile::isOpen() const {
+    return mapping != nullptr;
+}
+
+// Recompute the payload checksum and compare it with the header
+bool MappedMapFile::verifyChecksum() const {
+    size_t count = static_cast<size_t>(header->payloadBytes / sizeof(uint64_t));
+    return computeMapChecksum(getWords(), count) == header->checksum;
+}
+
+// Get the header of the mapped file
+const MapFileHeader& MappedMapFile::getHeader() const {
+    return *header;
+}
+
+// Get the payload as grid storage (copy-on-write)
+uint64_t* MappedMapFile::getWords() const {
+    return reinterpret_cast<uint64_t*>(static_cast<char*>(mapping) + sizeof(MapFileHeader));
+}
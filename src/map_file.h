@@ -0,0 +1,102 @@
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+#include "grid_search.h"
+#include "occupancy_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+// Binary map file format, version 1
+//
+// A 64-byte header followed by the occupancy payload in exactly the layout
+// OccupancyGrid uses in memory: row-major, 1 bit per cell, every row padded
+// to whole 64-bit words, bit (x & 63) of word (x >> 6) for column x. All
+// fields are little-endian. The payload starts 64 bytes into the file, so a
+// page-aligned mapping of the file can serve directly as grid storage.
+const char kMapFileMagic[8] = {'R', 'P', 'M', 'A', 'P', 'B', 'I', 'N'};
+const uint32_t kMapFileVersion = 1;
+
+// Map file header (64 bytes)
+struct MapFileHeader {
+    char magic[8];          // kMapFileMagic
+    uint32_t version;       // kMapFileVersion
+    uint32_t headerBytes;   // sizeof(MapFileHeader); the payload starts here
+    int32_t width;          // Cells in the x direction (East)
+    int32_t height;         // Cells in the y direction (North)
+    int32_t startX;         // Start cell
+    int32_t startY;
+    int32_t destX;          // Destination cell
+    int32_t destY;
+    uint32_t wordsPerRow;   // 64-bit words per payload row
+    uint32_t flags;         // Reserved, 0
+    uint64_t payloadBytes;  // wordsPerRow * height * 8
+    uint64_t checksum;      // computeMapChecksum of the payload
+};
+
+static_assert(sizeof(MapFileHeader) == 64, "MapFileHeader must stay 64 bytes");
+
+// Checksum of a payload: 64-bit FNV-1a over its little-endian words
+uint64_t computeMapChecksum(const uint64_t* words, size_t count);
+
+// Write a grid and its start/destination as a binary map file
+bool writeMapFile(const std::string& path, const OccupancyGrid& grid, GridCell start, GridCell dest,
+                  std::string& error);
+
+// Read an ASCII-art map
+//
+// One text line per row, northmost row first. '#' or 'X' marks an obstacle,
+// 'S' the start and 'D' the destination; any other character is free.
+// Lines starting with ';' are comments. Short lines are padded with free
+// cells. Without 'S' / 'D' the start is (0, 0) and the destination the
+// north-east corner.
+bool readAsciiMap(std::istream& in, std::unique_ptr<OccupancyGrid>& grid, GridCell& start, GridCell& dest,
+                  std::string& error);
+
+// Write a grid as an ASCII-art map in the format read by readAsciiMap
+void writeAsciiMap(std::ostream& out, const OccupancyGrid& grid, GridCell start, GridCell dest);
+
+// Read-only binary map file mapped into memory
+//
+// The file is mapped copy-on-write, so a grid viewing the payload can still
+// mark obstacles without touching the file. Grids viewing the payload must
+// not outlive the MappedMapFile.
+class MappedMapFile {
+private:
+    void* mapping;          // Start of the mapping (nullptr when closed)
+    size_t mappingBytes;    // Length of the mapping
+    const MapFileHeader* header;
+
+public:
+    // Constructor
+    MappedMapFile();
+
+    // Destructor (unmaps the file)
+    ~MappedMapFile();
+
+    // Map a file and check its header; the payload checksum is only read when asked
+    bool open(const std::string& path, std::string& error, bool verify_checksum = false);
+
+    // Unmap the file
+    void close();
+
+    // Check if a file is mapped
+    bool isOpen() const;
+
+    // Recompute the payload checksum and compare it with the header
+    bool verifyChecksum() const;
+
+    // Get the header of the mapped file
+    const MapFileHeader& getHeader() const;
+
+    // Get the payload as grid storage (copy-on-write)
+    uint64_t* getWords() const;
+
+    MappedMapFile(const MappedMapFile&) = delete;
+    MappedMapFile& operator=(const MappedMapFile&) = delete;
+};
+
+#endif // MAP_FILE_H
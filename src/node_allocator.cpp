@@ -0,0 +1,117 @@
+#include "node_allocator.h"
+#include <new>
+
+// Allocate a node with new
+Node* HeapNodeAllocator::allocate(int x, int y, NodeType type) {
+    return new Node(x, y, type);
+}
+
+// Release a node with delete
+void HeapNodeAllocator::deallocate(Node* node) {
+    delete node;
+}
+
+// Constructor
+NodePool::NodePool(int pool_capacity) :
+    slots(nullptr), poolCapacity(pool_capacity > 0 ? pool_capacity : 0),
+    nextUnused(0), freeList(nullptr) {
+
+    // Reserve raw storage; nodes are constructed in place on allocate
+    if (poolCapacity > 0) {
+        slots = static_cast<Node*>(::operator new(sizeof(Node) * poolCapacity));
+    }
+}
+
+// Destructor
+NodePool::~NodePool() {
+    // Node is trivially destructible, so the storage can be released directly
+    ::operator delete(slots);
+    slots = nullptr;
+}
+
+// Take a node from the free list or the unused slots
+Node* NodePool::allocate(int x, int y, NodeType type) {
+    Node* slot = nullptr;
+
+    if (freeList != nullptr) {
+        // Reuse the most recently released slot
+        slot = freeList;
+        freeList = freeList->next;
+    } else if (nextUnused < poolCapacity) {
+        // Hand out a slot that has never been used
+        slot = slots + nextUnused;
+        nextUnused++;
+    } else {
+        // The pool is exhausted
+        return nullptr;
+    }
+
+    return new (slot) Node(x, y, type);
+}
+
+// Push a node back onto the free list
+void NodePool::deallocate(Node* node) {
+    if (node == nullptr) {
+        return;
+    }
+
+    node->next = freeList;
+    freeList = node;
+}
+
+// Get the number of node slots
+int NodePool::getCapacity() const {
+    return poolCapacity;
+}
+
+// Constructor
+NodeArena::NodeArena(int initial_block_size) :
+    nextBlockSize(initial_block_size > 0 ? initial_block_size : 1),
+    blockUsed(0), blockSize(0), freeList(nullptr) {}
+
+// Destructor
+NodeArena::~NodeArena() {
+    for (Node* block : blocks) {
+        ::operator delete(block);
+    }
+    blocks.clear();
+}
+
+// Take a node from the free list or the newest block
+Node* NodeArena::allocate(int x, int y, NodeType type) {
+    Node* slot = nullptr;
+
+    if (freeList != nullptr) {
+        // Reuse the most recently released slot
+        slot = freeList;
+        freeList = freeList->next;
+    } else {
+        // Grow by a new block once the newest one is used up
+        if (blockUsed == blockSize) {
+            blocks.push_back(static_cast<Node*>(::operator new(sizeof(Node) * nextBlockSize)));
+            blockSize = nextBlockSize;
+            blockUsed = 0;
+            nextBlockSize *= 2;
+        }
+
+        slot = blocks.back() + blockUsed;
+        blockUsed++;
+    }
+
+    return new (slot) Node(x, y, type);
+}
+
+// Push a node back onto the free list
+void NodeArena::deallocate(Node* node) {
+    if (node == nullptr) {
+        return;
+    }
+
+    node->next = freeList;
+    freeList = node;
+}
+
+// Get the number of storage blocks allocated so far
+int NodeArena::getBlockCount() const {
+    return static_cast<int>(blocks.size());
+}
@@ -0,0 +1,96 @@
+#ifndef NODE_ALLOCATOR_H
+#define NODE_ALLOCATOR_H
+
+#include "path_node.h"
+#include <vector>
+
+// Node allocator interface used by DoublyLinkedList
+class NodeAllocator {
+public:
+    // Destructor
+    virtual ~NodeAllocator() {}
+
+    // Allocate and construct a node (returns nullptr when exhausted)
+    virtual Node* allocate(int x, int y, NodeType type) = 0;
+
+    // Return a node previously obtained from allocate
+    virtual void deallocate(Node* node) = 0;
+};
+
+// Allocator that uses the global heap for every node
+class HeapNodeAllocator : public NodeAllocator {
+public:
+    // Allocate a node with new
+    Node* allocate(int x, int y, NodeType type) override;
+
+    // Release a node with delete
+    void deallocate(Node* node) override;
+};
+
+// Fixed-capacity free-list pool
+//
+// All node storage is reserved up front, so allocate and deallocate never
+// touch the global heap after construction.
+class NodePool : public NodeAllocator {
+private:
+    Node* slots;        // Raw storage for poolCapacity nodes
+    int poolCapacity;   // Number of node slots
+    int nextUnused;     // Index of the first slot never handed out
+    Node* freeList;     // Released slots, linked through Node::next
+
+public:
+    // Constructor
+    NodePool(int pool_capacity);
+
+    // Destructor
+    ~NodePool();
+
+    // Take a node from the free list or the unused slots
+    Node* allocate(int x, int y, NodeType type) override;
+
+    // Push a node back onto the free list
+    void deallocate(Node* node) override;
+
+    // Get the number of node slots
+    int getCapacity() const;
+
+    // The pool owns raw storage and cannot be copied
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+};
+
+// Growable arena with free-list reuse
+//
+// Storage grows in blocks that double in size and is only returned to the
+// heap when the arena is destroyed. Released nodes are recycled first, so
+// the heap is only touched when the live node count reaches a new high.
+class NodeArena : public NodeAllocator {
+private:
+    std::vector<Node*> blocks;  // Raw storage blocks
+    int nextBlockSize;          // Slot count of the next block to allocate
+    int blockUsed;              // Slots handed out from the newest block
+    int blockSize;              // Slot count of the newest block
+    Node* freeList;             // Released slots, linked through Node::next
+
+public:
+    // Constructor
+    NodeArena(int initial_block_size = 64);
+
+    // Destructor
+    ~NodeArena();
+
+    // Take a node from the free list or the newest block
+    Node* allocate(int x, int y, NodeType type) override;
+
+    // Push a node back onto the free list
+    void deallocate(Node* node) override;
+
+    // Get the number of storage blocks allocated so far
+    int getBlockCount() const;
+
+    // The arena owns raw storage and cannot be copied
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+};
+
+#endif // NODE_ALLOCATOR_H
@@ -0,0 +1,42 @@
+#ifndef OBSTACLE_MAP_H
+#define OBSTACLE_MAP_H
+
+// Storage used for a planner's obstacles
+enum MapBackend {
+    MAP_DENSE,          // OccupancyGrid: one bit per cell, allocated up front
+    MAP_SPARSE          // SparseObstacleMap: tiles allocated by the first obstacle in them
+};
+
+// Obstacle storage behind the planner
+//
+// Implemented by the dense OccupancyGrid and the tiled SparseObstacleMap.
+// OccupancyGrid is final, so code holding one directly still gets inlined
+// lookups; only callers going through this interface pay for the dispatch.
+class ObstacleMap {
+public:
+    // Destructor
+    virtual ~ObstacleMap() {}
+
+    // Get the map width
+    virtual int getWidth() const = 0;
+
+    // Get the map height
+    virtual int getHeight() const = 0;
+
+    // Check if an obstacle is detected (out-of-bounds cells count as obstacles)
+    virtual bool isObstacleDetected(int x, int y) const = 0;
+
+    // Mark an obstacle at the specified position (ignored if out of bounds)
+    virtual void markObstacle(int x, int y) = 0;
+
+    // Check if the rectangle [fromX, toX] x [fromY, toY] is free (blocked if any part is outside)
+    virtual bool isRectangleFree(int fromX, int fromY, int toX, int toY) const = 0;
+
+    // Count all obstacles in the map
+    virtual long long countObstacles() const = 0;
+
+    // Get the memory held by the obstacle storage in bytes
+    virtual long long getStorageBytes() const = 0;
+};
+
+#endif // OBSTACLE_MAP_H
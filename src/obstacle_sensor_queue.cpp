@@ -0,0 +1,30 @@
+#include "obstacle_sensor_queue.h"
+
+// Constructor
+ObstacleSensorQueue::ObstacleSensorQueue() : queue(new ObservationQueue()), published(0), dropped(0) {}
+
+// Publish an observation (sensor thread only); returns false if it was dropped
+bool ObstacleSensorQueue::publish(int x, int y) {
+    ObstacleObservation observation = {x, y};
+    if (!queue->tryPush(observation)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    published.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Take the oldest observation (planning thread only); returns false if there is none
+bool ObstacleSensorQueue::poll(ObstacleObservation& observation) {
+    return queue->tryPop(observation);
+}
+
+// Get the number of observations accepted so far
+long long ObstacleSensorQueue::getPublishedCount() const {
+    return published.load(std::memory_order_relaxed);
+}
+
+// Get the number of observations dropped because the queue was full
+long long ObstacleSensorQueue::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
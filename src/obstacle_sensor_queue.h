@@ -0,0 +1,53 @@
+#ifndef OBSTACLE_SENSOR_QUEUE_H
+#define OBSTACLE_SENSOR_QUEUE_H
+
+#include "spsc_queue.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// One obstacle seen by the distance sensor
+struct ObstacleObservation {
+    int x;          // Cell of the obstacle (East)
+    int y;          // (North)
+};
+
+// Number of observations the queue holds before the sensor starts dropping
+const size_t kSensorQueueCapacity = 1024;
+
+// Bounded lock-free hand-off of obstacle observations to the planner
+//
+// The sensor thread publishes observations and the planning thread drains
+// them at the start of each step, marking them through markObstacle. The
+// planning thread is then the only writer of the obstacle grid, so grid
+// reads need no lock. Publishing never blocks: when the planner falls a
+// whole queue behind, observations are dropped and counted.
+class ObstacleSensorQueue {
+private:
+    typedef SpscQueue<ObstacleObservation, kSensorQueueCapacity> ObservationQueue;
+
+    std::unique_ptr<ObservationQueue> queue;
+    std::atomic<long long> published;   // Observations accepted (sensor side)
+    std::atomic<long long> dropped;     // Observations lost to a full queue (sensor side)
+
+public:
+    // Constructor
+    ObstacleSensorQueue();
+
+    // Publish an observation (sensor thread only); returns false if it was dropped
+    bool publish(int x, int y);
+
+    // Take the oldest observation (planning thread only); returns false if there is none
+    bool poll(ObstacleObservation& observation);
+
+    // Get the number of observations accepted so far
+    long long getPublishedCount() const;
+
+    // Get the number of observations dropped because the queue was full
+    long long getDroppedCount() const;
+
+    ObstacleSensorQueue(const ObstacleSensorQueue&) = delete;
+    ObstacleSensorQueue& operator=(const ObstacleSensorQueue&) = delete;
+};
+
+#endif // OBSTACLE_SENSOR_QUEUE_H
@@ -0,0 +1,261 @@
+#include "occupancy_grid.h"
+#include <algorithm>
+#include <bitset>
+
+// Constructor
+OccupancyGrid::OccupancyGrid(int grid_width, int grid_height, uint64_t* external_words) :
+    width(grid_width > 0 ? grid_width : 0), height(grid_height > 0 ? grid_height : 0),
+    wordsPerRow(wordsForWidth(width)), words(external_words), ownsWords(external_words == nullptr) {
+
+    // Allocate all rows as one zeroed block unless the caller supplied storage
+    if (ownsWords) {
+        words = new uint64_t[static_cast<size_t>(wordsPerRow) * height]();
+    }
+}
+
+// Constructor (allocate_now = false leaves the storage for a later allocate() call)
+OccupancyGrid::OccupancyGrid(int grid_width, int grid_height, bool allocate_now) :
+    width(grid_width > 0 ? grid_width : 0), height(grid_height > 0 ? grid_height : 0),
+    wordsPerRow(wordsForWidth(width)), words(nullptr), ownsWords(true) {
+    if (allocate_now) {
+        allocate();
+    }
+}
+
+// Copy constructor
+OccupancyGrid::OccupancyGrid(const OccupancyGrid& other) :
+    width(other.width), height(other.height), wordsPerRow(other.wordsPerRow), words(nullptr),
+    ownsWords(true) {
+
+    // A copy always owns its storage, even when copied from a view
+    if (other.words != nullptr) {
+        size_t count = static_cast<size_t>(wordsPerRow) * height;
+        words = new uint64_t[count];
+        std::copy(other.words, other.words + count, words);
+    }
+}
+
+// Copy assignment
+OccupancyGrid& OccupancyGrid::operator=(const OccupancyGrid& other) {
+    if (this != &other) {
+        uint64_t* newWords = nullptr;
+        if (other.words != nullptr) {
+            size_t count = static_cast<size_t>(other.wordsPerRow) * other.height;
+            newWords = new uint64_t[count];
+            std::copy(other.words, other.words + count, newWords);
+        }
+
+        if (ownsWords) {
+            delete[] words;
+        }
+        words = newWords;
+        ownsWords = true;
+        width = other.width;
+        height = other.height;
+        wordsPerRow = other.wordsPerRow;
+    }
+    return *this;
+}
+
+// Destructor
+OccupancyGrid::~OccupancyGrid() {
+    if (ownsWords) {
+        delete[] words;
+    }
+    words = nullptr;
+}
+
+// Allocate zeroed bit storage if the grid has none yet
+void OccupancyGrid::allocate() {
+    if (words == nullptr) {
+        words = new uint64_t[static_cast<size_t>(wordsPerRow) * height]();
+        ownsWords = true;
+    }
+}
+
+// Get the mask selecting bits [from, to] of a single word
+uint64_t OccupancyGrid::rangeMask(int from, int to) {
+    uint64_t upper = (to >= 63) ? ~uint64_t(0) : ((uint64_t(1) << (to + 1)) - 1);
+    uint64_t lower = (uint64_t(1) << from) - 1;
+    return upper & ~lower;
+}
+
+// Clear all obstacles
+void OccupancyGrid::clear() {
+    if (words == nullptr) {
+        return;
+    }
+    std::fill(words, words + static_cast<size_t>(wordsPerRow) * height, uint64_t(0));
+}
+
+// Merge the obstacles of another grid of the same size into this one
+bool OccupancyGrid::mergeFrom(const OccupancyGrid& other) {
+    // Only grids with identical dimensions can be merged word by word
+    if (other.width != width || other.height != height) {
+        return false;
+    }
+
+    size_t count = static_cast<size_t>(wordsPerRow) * height;
+    for (size_t i = 0; i < count; i++) {
+        words[i] |= other.words[i];
+    }
+
+    return true;
+}
+
+// Count obstacles in row y between columns fromX and toX (inclusive)
+int OccupancyGrid::countRowObstacles(int y, int fromX, int toX) const {
+    // Clip the range to the grid
+    fromX = std::max(fromX, 0);
+    toX = std::min(toX, width - 1);
+    if (y < 0 || y >= height || fromX > toX) {
+        return 0;
+    }
+
+    const uint64_t* row = words + static_cast<size_t>(y) * wordsPerRow;
+    int firstWord = fromX >> 6;
+    int lastWord = toX >> 6;
+
+    // The range lies within a single word
+    if (firstWord == lastWord) {
+        return static_cast<int>(std::bitset<64>(row[firstWord] & rangeMask(fromX & 63, toX & 63)).count());
+    }
+
+    // Partial first word, full middle words, partial last word
+    int count = static_cast<int>(std::bitset<64>(row[firstWord] & rangeMask(fromX & 63, 63)).count());
+    for (int i = firstWord + 1; i < lastWord; i++) {
+        count += static_cast<int>(std::bitset<64>(row[i]).count());
+    }
+    count += static_cast<int>(std::bitset<64>(row[lastWord] & rangeMask(0, toX & 63)).count());
+
+    return count;
+}
+
+// Count obstacles in column x between rows fromY and toY (inclusive)
+int OccupancyGrid::countColumnObstacles(int x, int fromY, int toY) const {
+    // Clip the range to the grid
+    fromY = std::max(fromY, 0);
+    toY = std::min(toY, height - 1);
+    if (x < 0 || x >= width || fromY > toY) {
+        return 0;
+    }
+
+    // Walk down the column one row stride at a time
+    const uint64_t* word = words + static_cast<size_t>(fromY) * wordsPerRow + (x >> 6);
+    uint64_t mask = bitMask(x);
+    int count = 0;
+    for (int y = fromY; y <= toY; y++) {
+        if (*word & mask) {
+            count++;
+        }
+        word += wordsPerRow;
+    }
+
+    return count;
+}
+
+// Check if row y is free between columns fromX and toX (inclusive)
+bool OccupancyGrid::isRowRangeFree(int y, int fromX, int toX) const {
+    // Any part of the range outside the grid counts as blocked
+    if (y < 0 || y >= height || fromX < 0 || toX >= width) {
+        return false;
+    }
+    if (fromX > toX) {
+        return true;
+    }
+
+    const uint64_t* row = words + static_cast<size_t>(y) * wordsPerRow;
+    int firstWord = fromX >> 6;
+    int lastWord = toX >> 6;
+
+    // The range lies within a single word
+    if (firstWord == lastWord) {
+        return (row[firstWord] & rangeMask(fromX & 63, toX & 63)) == 0;
+    }
+
+    // Partial first word, full middle words, partial last word
+    if (row[firstWord] & rangeMask(fromX & 63, 63)) {
+        return false;
+    }
+    for (int i = firstWord + 1; i < lastWord; i++) {
+        if (row[i] != 0) {
+            return false;
+        }
+    }
+    return (row[lastWord] & rangeMask(0, toX & 63)) == 0;
+}
+
+// Check if column x is free between rows fromY and toY (inclusive)
+bool OccupancyGrid::isColumnRangeFree(int x, int fromY, int toY) const {
+    // Any part of the range outside the grid counts as blocked
+    if (x < 0 || x >= width || fromY < 0 || toY >= height) {
+        return false;
+    }
+
+    const uint64_t* word = words + static_cast<size_t>(fromY) * wordsPerRow + (x >> 6);
+    uint64_t mask = bitMask(x);
+    for (int y = fromY; y <= toY; y++) {
+        if (*word & mask) {
+            return false;
+        }
+        word += wordsPerRow;
+    }
+
+    return true;
+}
+
+// Check if the rectangle [fromX, toX] x [fromY, toY] is free (blocked if any part is outside)
+bool OccupancyGrid::isRectangleFree(int fromX, int fromY, int toX, int toY) const {
+    if (fromY < 0 || toY >= height) {
+        return false;
+    }
+    for (int y = fromY; y <= toY; y++) {
+        if (!isRowRangeFree(y, fromX, toX)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Count all obstacles in the grid
+long long OccupancyGrid::countObstacles() const {
+    long long count = 0;
+    size_t total = (words == nullptr) ? 0 : static_cast<size_t>(wordsPerRow) * height;
+    for (size_t i = 0; i < total; i++) {
+        count += static_cast<long long>(std::bitset<64>(words[i]).count());
+    }
+    return count;
+}
+
+// Get the grid width
+int OccupancyGrid::getWidth() const {
+    return width;
+}
+
+// Get the grid height
+int OccupancyGrid::getHeight() const {
+    return height;
+}
+
+// Get the number of 64-bit words in one row
+int OccupancyGrid::getWordsPerRow() const {
+    return wordsPerRow;
+}
+
+// Get the raw row-major word storage
+const uint64_t* OccupancyGrid::getWords() const {
+    return words;
+}
+
+// Check if the storage is an external block
+bool OccupancyGrid::isView() const {
+    return !ownsWords;
+}
+
+// Get the size of the bit storage in bytes
+long long OccupancyGrid::getStorageBytes() const {
+    if (words == nullptr) {
+        return 0;
+    }
+    return static_cast<long long>(wordsPerRow) * height * static_cast<long long>(sizeof(uint64_t));
+}
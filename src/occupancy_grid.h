@@ -0,0 +1,135 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include "obstacle_map.h"
+#include <cstddef>
+#include <cstdint>
+
+// Bit-packed occupancy grid
+//
+// Cells are stored row-major with 1 bit per cell in a single contiguous
+// allocation. Every row starts on a 64-bit word boundary so row operations
+// can work a whole word at a time. The storage can also be an external
+// block (for example a memory-mapped map file) that the grid does not own,
+// or be left unallocated until the first allocate() call.
+class OccupancyGrid final : public ObstacleMap {
+private:
+    int width;              // Number of cells in the x direction (East)
+    int height;             // Number of cells in the y direction (North)
+    int wordsPerRow;        // Number of 64-bit words used by one row
+    uint64_t* words;        // Row-major bit storage, wordsPerRow * height words (nullptr until allocated)
+    bool ownsWords;         // False when words is an external block
+
+    // Get the word holding the cell at (x, y)
+    uint64_t& wordAt(int x, int y) const {
+        return words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)];
+    }
+
+    // Get the mask selecting the cell at x within its word
+    static uint64_t bitMask(int x) {
+        return uint64_t(1) << (x & 63);
+    }
+
+    // Get the mask selecting bits [from, to] of a single word
+    static uint64_t rangeMask(int from, int to);
+
+public:
+    // Constructor (uses external_words as storage when given, without taking ownership)
+    OccupancyGrid(int grid_width, int grid_height, uint64_t* external_words = nullptr);
+
+    // Constructor (allocate_now = false leaves the storage for a later allocate() call)
+    OccupancyGrid(int grid_width, int grid_height, bool allocate_now);
+
+    // Copy constructor
+    OccupancyGrid(const OccupancyGrid& other);
+
+    // Copy assignment
+    OccupancyGrid& operator=(const OccupancyGrid& other);
+
+    // Destructor
+    ~OccupancyGrid() override;
+
+    // Check if the bit storage exists (cell queries need it)
+    bool isAllocated() const {
+        return words != nullptr;
+    }
+
+    // Allocate zeroed bit storage if the grid has none yet
+    void allocate();
+
+    // Check if the position is within the grid bounds
+    bool isInBounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    // Check if an obstacle is detected (out-of-bounds cells count as obstacles)
+    bool isObstacleDetected(int x, int y) const override {
+        if (!isInBounds(x, y)) {
+            return true;
+        }
+        return (wordAt(x, y) & bitMask(x)) != 0;
+    }
+
+    // Mark an obstacle at the specified position (ignored if out of bounds)
+    void markObstacle(int x, int y) override {
+        if (isInBounds(x, y)) {
+            wordAt(x, y) |= bitMask(x);
+        }
+    }
+
+    // Clear the obstacle at the specified position (ignored if out of bounds)
+    void clearObstacle(int x, int y) {
+        if (isInBounds(x, y)) {
+            wordAt(x, y) &= ~bitMask(x);
+        }
+    }
+
+    // Clear all obstacles
+    void clear();
+
+    // Merge the obstacles of another grid of the same size into this one
+    bool mergeFrom(const OccupancyGrid& other);
+
+    // Count obstacles in row y between columns fromX and toX (inclusive)
+    int countRowObstacles(int y, int fromX, int toX) const;
+
+    // Count obstacles in column x between rows fromY and toY (inclusive)
+    int countColumnObstacles(int x, int fromY, int toY) const;
+
+    // Check if row y is free between columns fromX and toX (inclusive)
+    bool isRowRangeFree(int y, int fromX, int toX) const;
+
+    // Check if column x is free between rows fromY and toY (inclusive)
+    bool isColumnRangeFree(int x, int fromY, int toY) const;
+
+    // Check if the rectangle [fromX, toX] x [fromY, toY] is free (blocked if any part is outside)
+    bool isRectangleFree(int fromX, int fromY, int toX, int toY) const override;
+
+    // Count all obstacles in the grid
+    long long countObstacles() const override;
+
+    // Get the grid width
+    int getWidth() const override;
+
+    // Get the grid height
+    int getHeight() const override;
+
+    // Get the number of 64-bit words in one row
+    int getWordsPerRow() const;
+
+    // Get the raw row-major word storage
+    const uint64_t* getWords() const;
+
+    // Check if the storage is an external block
+    bool isView() const;
+
+    // Get the number of 64-bit words in a row of a grid of the given width
+    static int wordsForWidth(int grid_width) {
+        return (grid_width + 63) / 64;
+    }
+
+    // Get the size of the bit storage in bytes (0 while unallocated)
+    long long getStorageBytes() const override;
+};
+
+#endif // OCCUPANCY_GRID_H
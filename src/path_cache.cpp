@@ -0,0 +1,129 @@
+#include "path_cache.h"
+#include <bitset>
+#include <cstring>
+
+// Finalizer of splitmix64, used to spread cell indices and key fields
+static uint64_t mixBits(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Get the bits of a cost, with -0 folded into 0 so equal keys hash alike
+static uint64_t getCostBits(double cost) {
+    double normalized = cost + 0.0;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &normalized, sizeof(bits));
+    return bits;
+}
+
+// Hash a key
+size_t PathCacheKeyHash::operator()(const PathCacheKey& key) const {
+    uint64_t hash = key.mapHash;
+    const int fields[9] = {key.startX, key.startY, key.destX, key.destY, key.width, key.height,
+                           key.mode, key.allowedMoves, key.heading};
+    for (int field : fields) {
+        hash = mixBits(hash ^ static_cast<uint32_t>(field));
+    }
+    hash = mixBits(hash ^ getCostBits(key.turnSeconds));
+    hash = mixBits(hash ^ getCostBits(key.moveSeconds));
+    return static_cast<size_t>(hash);
+}
+
+// Get the hash contribution of an obstacle at (x, y)
+uint64_t getObstacleCellHash(int x, int y) {
+    return mixBits((static_cast<uint64_t>(static_cast<uint32_t>(y)) << 32) ^ static_cast<uint32_t>(x) ^
+                   0x9E3779B97F4A7C15ull);
+}
+
+// Compute the content hash of a grid from scratch
+uint64_t computeMapHash(const OccupancyGrid& grid) {
+    uint64_t hash = 0;
+    const uint64_t* words = grid.getWords();
+    int wordsPerRow = grid.getWordsPerRow();
+
+    // Only set bits contribute, so empty words cost one test each
+    for (int y = 0; y < grid.getHeight(); y++) {
+        const uint64_t* row = words + static_cast<size_t>(y) * wordsPerRow;
+        for (int word = 0; word < wordsPerRow; word++) {
+            uint64_t bits = row[word];
+            while (bits != 0) {
+                int x = word * 64 + static_cast<int>(std::bitset<64>((bits & (~bits + 1)) - 1).count());
+                hash ^= getObstacleCellHash(x, y);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    return hash;
+}
+
+// Constructor
+PathCache::PathCache(int max_entries) : capacity(max_entries > 0 ? max_entries : 1) {
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.insertions = 0;
+    stats.evictions = 0;
+    stats.entries = 0;
+    stats.capacity = capacity;
+    stats.waypoints = 0;
+    index.reserve(static_cast<size_t>(capacity));
+}
+
+// Copy the route stored under key into path (false on a miss)
+bool PathCache::lookup(const PathCacheKey& key, CachedPath& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    EntryIndex::iterator found = index.find(key);
+    if (found == index.end()) {
+        stats.misses++;
+        return false;
+    }
+
+    // Move the entry to the front of the recency order
+    entries.splice(entries.begin(), entries, found->second);
+    path = found->second->path;
+    stats.hits++;
+    return true;
+}
+
+// Store a route, evicting the least recently used one when full
+void PathCache::insert(const PathCacheKey& key, const CachedPath& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Another thread may have planned the same route first
+    EntryIndex::iterator found = index.find(key);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    if (static_cast<int>(entries.size()) >= capacity) {
+        Entry& oldest = entries.back();
+        stats.waypoints -= static_cast<long long>(oldest.path.waypoints.size());
+        index.erase(oldest.key);
+        entries.pop_back();
+        stats.evictions++;
+    }
+
+    entries.push_front(Entry{key, path});
+    entries.front().path.waypoints.shrink_to_fit();
+    index[key] = entries.begin();
+    stats.insertions++;
+    stats.waypoints += static_cast<long long>(path.waypoints.size());
+}
+
+// Drop every entry (the counters are kept)
+void PathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    stats.waypoints = 0;
+}
+
+// Get the counters
+PathCacheStats PathCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    PathCacheStats snapshot = stats;
+    snapshot.entries = static_cast<int>(entries.size());
+    return snapshot;
+}
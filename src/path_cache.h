@@ -0,0 +1,110 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include "grid_search.h"
+#include "occupancy_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Everything a cached route depends on
+struct PathCacheKey {
+    int startX;
+    int startY;
+    int destX;
+    int destY;
+    int width;              // Map size
+    int height;
+    uint64_t mapHash;       // Content hash of the obstacles (see computeMapHash)
+    int mode;               // Planner mode that searched the route
+    int allowedMoves;       // MoveSet flags the search could use
+    int heading;            // Direction index at the start (-1 if the route ignores it)
+    double turnSeconds;     // Turn and move costs the route was weighed with (0 if unused)
+    double moveSeconds;
+
+    // Check if two keys are equal
+    bool operator==(const PathCacheKey& other) const {
+        return startX == other.startX && startY == other.startY && destX == other.destX &&
+               destY == other.destY && width == other.width && height == other.height &&
+               mapHash == other.mapHash && mode == other.mode && allowedMoves == other.allowedMoves &&
+               heading == other.heading && turnSeconds == other.turnSeconds &&
+               moveSeconds == other.moveSeconds;
+    }
+};
+
+// Hash functor for PathCacheKey
+struct PathCacheKeyHash {
+    size_t operator()(const PathCacheKey& key) const;
+};
+
+// Cached route: its waypoints (start, turning cells, destination) and length
+struct CachedPath {
+    std::vector<GridCell> waypoints;
+    int length;
+};
+
+// Cache counters
+struct PathCacheStats {
+    long long hits;
+    long long misses;
+    long long insertions;
+    long long evictions;
+    int entries;            // Routes held now
+    int capacity;           // Most routes held at once
+    long long waypoints;    // Waypoints held by all entries
+};
+
+// Get the hash contribution of an obstacle at (x, y)
+//
+// The map hash is the XOR of the contributions of all obstacle cells, so
+// marking or clearing one cell updates it in O(1).
+uint64_t getObstacleCellHash(int x, int y);
+
+// Compute the content hash of a grid from scratch
+uint64_t computeMapHash(const OccupancyGrid& grid);
+
+// Bounded least-recently-used cache of planned routes
+//
+// Keys include the map content hash, so a route planned before an obstacle
+// was marked is never returned for the changed map; such entries simply
+// age out. All operations lock, so one cache can serve a whole thread pool.
+class PathCache {
+private:
+    // One cached route
+    struct Entry {
+        PathCacheKey key;
+        CachedPath path;
+    };
+    typedef std::list<Entry> EntryList;
+    typedef std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> EntryIndex;
+
+    EntryList entries;      // Most recently used first
+    EntryIndex index;       // Entry of each key
+    int capacity;           // Most entries held at once
+    PathCacheStats stats;
+    mutable std::mutex mutex;
+
+public:
+    // Constructor
+    explicit PathCache(int max_entries);
+
+    // Copy the route stored under key into path (false on a miss)
+    bool lookup(const PathCacheKey& key, CachedPath& path);
+
+    // Store a route, evicting the least recently used one when full
+    void insert(const PathCacheKey& key, const CachedPath& path);
+
+    // Drop every entry (the counters are kept)
+    void clear();
+
+    // Get the counters
+    PathCacheStats getStats() const;
+
+    PathCache(const PathCache&) = delete;
+    PathCache& operator=(const PathCache&) = delete;
+};
+
+#endif // PATH_CACHE_H
@@ -0,0 +1,40 @@
+#ifndef PATH_NODE_H
+#define PATH_NODE_H
+
+// Node type enumeration
+enum NodeType {
+    REGULAR,           // Regular node (empty square)
+    START_LOCATION,    // Starting location node
+    TURNING_NODE,      // Node where robot needs to turn
+    OBJECT_DETECTION   // Node where an object is detected
+};
+
+// Get the printable name of a node type
+inline const char* getNodeTypeName(NodeType type) {
+    switch (type) {
+        case REGULAR:
+            return "REGULAR";
+        case START_LOCATION:
+            return "START_LOCATION";
+        case TURNING_NODE:
+            return "TURNING_NODE";
+        case OBJECT_DETECTION:
+            return "OBJECT_DETECTION";
+    }
+    return "UNKNOWN";
+}
+
+// Doubly Linked List Node structure
+struct Node {
+    int x;              // X coordinate (East)
+    int y;              // Y coordinate (North)
+    NodeType type;      // Type of node
+    Node* prev;         // Pointer to previous node
+    Node* next;         // Pointer to next node
+    
+    // Constructor
+    Node(int x_coord, int y_coord, NodeType node_type) : 
+        x(x_coord), y(y_coord), type(node_type), prev(nullptr), next(nullptr) {}
+};
+
+#endif // PATH_NODE_H
@@ -0,0 +1,192 @@
+#include "plan_pipeline.h"
+#include <chrono>
+
+// Constructor (copies the grid and starts the worker)
+PlanPipeline::PlanPipeline(const OccupancyGrid& obstacles, int dest_x, int dest_y, int allowed_moves,
+                           SearchMode search_mode, bool use_incremental) :
+    grid(obstacles), destX(dest_x), destY(dest_y), incremental(use_incremental),
+    search(grid, allowed_moves, search_mode), dstar(grid, allowed_moves),
+    pendingGeneration(0), pendingX(0), pendingY(0), hasRequest(false), stopping(false),
+    latestGeneration(-1), finishedGeneration(-1), cancelled(false), legs(new LegQueue()),
+    planNanos(0) {
+
+    search.setCancelFlag(&cancelled);
+    dstar.setCancelFlag(&cancelled);
+
+    worker = std::thread(&PlanPipeline::workerLoop, this);
+}
+
+// Destructor (stops the worker)
+PlanPipeline::~PlanPipeline() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+
+    // No generation is current any more, so a worker waiting for queue room
+    // gives up and a search in progress stops
+    latestGeneration.store(-1, std::memory_order_release);
+    cancelled.store(true, std::memory_order_relaxed);
+    requestReady.notify_one();
+    worker.join();
+}
+
+// Ask for a route from (startX, startY) that avoids new_obstacles as well
+void PlanPipeline::requestPlan(int generation, int startX, int startY, const std::vector<GridCell>& new_obstacles) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        pendingObstacles.insert(pendingObstacles.end(), new_obstacles.begin(), new_obstacles.end());
+        pendingGeneration = generation;
+        pendingX = startX;
+        pendingY = startY;
+        hasRequest = true;
+    }
+    latestGeneration.store(generation, std::memory_order_release);
+    requestReady.notify_one();
+}
+
+// Take the next planned leg (executor only); returns false if none is ready
+bool PlanPipeline::pollLeg(PlannedLeg& leg) {
+    return legs->tryPop(leg);
+}
+
+// Check if the worker has queued every leg it will plan for generation (or a newer one)
+bool PlanPipeline::isGenerationFinished(int generation) const {
+    return finishedGeneration.load(std::memory_order_acquire) >= generation;
+}
+
+// Get the worker time spent planning in seconds
+double PlanPipeline::getPlanningSeconds() const {
+    return planNanos.load(std::memory_order_relaxed) / 1e9;
+}
+
+// Worker thread body
+void PlanPipeline::workerLoop() {
+    std::vector<GridCell> changes;
+    while (true) {
+        int generation = 0;
+        int startX = 0;
+        int startY = 0;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            requestReady.wait(guard, [this] { return hasRequest || stopping; });
+            if (stopping) {
+                return;
+            }
+
+            // Only the newest request is planned, but every obstacle is kept
+            changes.swap(pendingObstacles);
+            generation = pendingGeneration;
+            startX = pendingX;
+            startY = pendingY;
+            hasRequest = false;
+        }
+
+        for (const GridCell& cell : changes) {
+            if (!grid.isObstacleDetected(cell.x, cell.y)) {
+                grid.markObstacle(cell.x, cell.y);
+                dstar.notifyCellChanged(cell.x, cell.y);
+            }
+        }
+        changes.clear();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        plan(generation, startX, startY);
+        planNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+        finishedGeneration.store(generation, std::memory_order_release);
+    }
+}
+
+// Queue a leg, waiting for room; returns false if the generation went stale
+bool PlanPipeline::emit(const PlannedLeg& leg) {
+    while (!legs->tryPush(leg)) {
+        if (latestGeneration.load(std::memory_order_acquire) != leg.generation) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return latestGeneration.load(std::memory_order_acquire) == leg.generation;
+}
+
+// Plan from (startX, startY) and emit the legs of generation
+void PlanPipeline::plan(int generation, int startX, int startY) {
+    PlannedLeg leg = {generation, startX, startY, startX, startY, false, false};
+
+    if (!incremental) {
+        // Whole route at once, then one leg per pair of waypoints
+        if (!search.findPath(startX, startY, destX, destY)) {
+            leg.failed = true;
+            emit(leg);
+            return;
+        }
+        const std::vector<GridCell>& waypoints = search.getWaypoints();
+        for (size_t i = 1; i < waypoints.size(); i++) {
+            leg.fromX = waypoints[i - 1].x;
+            leg.fromY = waypoints[i - 1].y;
+            leg.toX = waypoints[i].x;
+            leg.toY = waypoints[i].y;
+            leg.last = (i + 1 == waypoints.size());
+            if (!emit(leg)) {
+                return;
+            }
+        }
+        if (waypoints.size() <= 1) {
+            leg.last = true;
+            emit(leg);
+        }
+        return;
+    }
+
+    // D* Lite: repair, then walk the route and emit each leg as soon as it turns
+    bool reachable = false;
+    if (!dstar.isInitialized()) {
+        reachable = dstar.initialize(startX, startY, destX, destY);
+    } else {
+        dstar.moveStart(startX, startY);
+        dstar.repair();
+        reachable = dstar.isInitialized() && dstar.getDistanceToGoal() >= 0;
+    }
+    if (!reachable) {
+        leg.failed = true;
+        emit(leg);
+        return;
+    }
+
+    int x = startX;
+    int y = startY;
+    int stepX = 0;
+    int stepY = 0;
+    while (x != destX || y != destY) {
+        int nextX = x;
+        int nextY = y;
+        dstar.moveStart(x, y);
+        if (!dstar.getNextStep(nextX, nextY)) {
+            leg.failed = true;
+            emit(leg);
+            return;
+        }
+
+        // A change of direction closes the current leg
+        bool turning = (nextX - x != stepX || nextY - y != stepY);
+        if (turning && (x != leg.fromX || y != leg.fromY)) {
+            leg.toX = x;
+            leg.toY = y;
+            if (!emit(leg)) {
+                return;
+            }
+            leg.fromX = x;
+            leg.fromY = y;
+        }
+        stepX = nextX - x;
+        stepY = nextY - y;
+        x = nextX;
+        y = nextY;
+    }
+    dstar.moveStart(startX, startY);
+
+    leg.toX = x;
+    leg.toY = y;
+    leg.last = true;
+    emit(leg);
+}
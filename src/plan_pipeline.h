@@ -0,0 +1,105 @@
+#ifndef PLAN_PIPELINE_H
+#define PLAN_PIPELINE_H
+
+#include "dstar_lite.h"
+#include "grid_search.h"
+#include "occupancy_grid.h"
+#include "spsc_queue.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One straight leg of a route planned by the pipeline worker
+struct PlannedLeg {
+    int generation;     // Request the leg was planned for
+    int fromX;          // Start cell of the leg
+    int fromY;
+    int toX;            // End cell of the leg
+    int toY;
+    bool last;          // The leg ends at the destination
+    bool failed;        // No route from the request start (the other fields are unused)
+};
+
+// Number of legs the worker can run ahead of the executor
+const size_t kPipelineLegCapacity = 256;
+
+// Background route planner feeding legs to an executing robot
+//
+// The worker owns a private copy of the obstacle grid, so it never reads
+// memory the executor is writing. Each request carries the obstacles found
+// since the previous one, a start cell and a generation number; the worker
+// folds in the obstacles, plans from the start and streams the legs of the
+// route through a lock-free queue as soon as each one is known. A newer
+// request supersedes older ones: the worker stops emitting for a stale
+// generation and the executor discards any of its legs already queued.
+class PlanPipeline {
+private:
+    typedef SpscQueue<PlannedLeg, kPipelineLegCapacity> LegQueue;
+
+    OccupancyGrid grid;             // Worker copy of the obstacles
+    int destX;
+    int destY;
+    bool incremental;               // Repair with D* Lite instead of searching from scratch
+    GridSearch search;
+    DStarLite dstar;
+
+    // Request mailbox (executor -> worker)
+    std::mutex lock;
+    std::condition_variable requestReady;
+    std::vector<GridCell> pendingObstacles;
+    int pendingGeneration;
+    int pendingX;
+    int pendingY;
+    bool hasRequest;
+    bool stopping;
+    std::atomic<int> latestGeneration;  // Newest generation requested
+    std::atomic<int> finishedGeneration;    // Newest generation whose legs are all queued
+    std::atomic<bool> cancelled;        // Raised on shutdown to stop the running search
+
+    std::unique_ptr<LegQueue> legs;     // Planned legs (worker -> executor)
+    std::atomic<long long> planNanos;   // Worker time spent planning
+    std::thread worker;
+
+    // Worker thread body
+    void workerLoop();
+
+    // Plan from (startX, startY) and emit the legs of generation
+    void plan(int generation, int startX, int startY);
+
+    // Queue a leg, waiting for room; returns false if the generation went stale
+    bool emit(const PlannedLeg& leg);
+
+public:
+    // Constructor (copies the grid and starts the worker)
+    //
+    // mode selects the search; INCREMENTAL uses D* Lite, everything else the
+    // GridSearch mode given. Only moves in allowed_moves are planned.
+    PlanPipeline(const OccupancyGrid& obstacles, int dest_x, int dest_y, int allowed_moves,
+                 SearchMode search_mode, bool use_incremental);
+
+    // Destructor (stops the worker)
+    ~PlanPipeline();
+
+    // Ask for a route from (startX, startY) that avoids new_obstacles as well
+    void requestPlan(int generation, int startX, int startY, const std::vector<GridCell>& new_obstacles);
+
+    // Take the next planned leg (executor only); returns false if none is ready
+    bool pollLeg(PlannedLeg& leg);
+
+    // Check if the worker has queued every leg it will plan for generation (or a newer one)
+    //
+    // Legs are queued before this turns true, so a poll that comes back
+    // empty after it did means no further leg of the generation is coming.
+    bool isGenerationFinished(int generation) const;
+
+    // Get the worker time spent planning in seconds
+    double getPlanningSeconds() const;
+
+    PlanPipeline(const PlanPipeline&) = delete;
+    PlanPipeline& operator=(const PlanPipeline&) = delete;
+};
+
+#endif // PLAN_PIPELINE_H
@@ -0,0 +1,46 @@
+#ifndef ROBOT_HARDWARE_H
+#define ROBOT_HARDWARE_H
+
+// Hardware abstraction used by the planner
+//
+// Mirrors the VEX calls the lab uses (motor velocity, drivetrain moves and
+// turns, inertial sensor) so the planner can drive either the real robot or
+// a simulator. Headings are IMU degrees in [0, 360), growing when turning
+// right. Blocking calls return once the motion has finished.
+class RobotHardware {
+public:
+    // Destructor
+    virtual ~RobotHardware() {}
+
+    // Get the time since start-up in seconds
+    virtual double getTime() const = 0;
+
+    // Sleep for a number of seconds
+    virtual void wait(double seconds) = 0;
+
+    // Set the drivetrain motor velocity in RPM
+    virtual void setVelocity(double rpm) = 0;
+
+    // Drive straight ahead for a distance in centimeters (blocking)
+    virtual void driveForward(double centimeters) = 0;
+
+    // Turn in place by a number of degrees, positive to the right (blocking)
+    virtual void turnBy(double degrees) = 0;
+
+    // Start turning right until stop is called
+    virtual void startTurnRight() = 0;
+
+    // Stop the drivetrain (brake)
+    virtual void stop() = 0;
+
+    // Start calibrating the inertial sensor
+    virtual void calibrateImu() = 0;
+
+    // Check if the inertial sensor is still calibrating
+    virtual bool isImuCalibrating() = 0;
+
+    // Read the inertial sensor heading in degrees
+    virtual double getHeading() = 0;
+};
+
+#endif // ROBOT_HARDWARE_H
@@ -1,38 +1,128 @@
 #include "robot_path_planner.h"
-#include <iostream>
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <thread>
+
+namespace {
+const double kCellSizeCm = 2.0;                 // One grid unit
+const double kDiagonalCellCm = 2.8284271247;    // Diagonal of one grid unit
+const double kCalibrationRpm = 15.0;            // Velocity used by cali_inertial
+const double kCorrectionRpm = 3.0;              // Velocity of IMU heading corrections
+const double kHeadingToleranceDegrees = 2.0;    // Heading error accepted after a turn
+const double kSettleSeconds = 0.25;             // Pause before reading the IMU after a turn
+const int kMaxHeadingCorrections = 3;
+const int kAvoidanceCells = 3;                  // Cells driven away from a detected obstacle
+const int kMinDetourClearanceSquared = 2;        // Squared clearance kept past a detour's first cell (none beside it)
+const int kPipelineCommitCells = 8;             // Cells driven on the old route while a replan runs
+const size_t kSparseFloodCells = 1024;          // Cells flooded on the sparse map before labelling the dense grid
+const long long kSparseLabelCells = 1LL << 22;  // Sparse fields up to this size are labelled on the dense grid at once
+const long long kMaxLabelCells = 1LL << 28;     // Sparse fields beyond this size are never labelled
+const double kDefaultPlanningBudget = 0.002;    // Anytime search seconds per cell driven
+const int kLegWaitSpins = 64;                   // Empty leg polls answered with a yield before sleeping
+const int kMaxLegWaitMicros = 500;              // Longest sleep between leg polls
+
+// Get the wall time since start in seconds
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Get the sign of a value (-1, 0 or 1)
+int getSign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// Wait before the next poll for a planned leg, a little longer after each empty poll
+void waitForLeg(int emptyPolls) {
+    if (emptyPolls < kLegWaitSpins) {
+        std::this_thread::yield();
+        return;
+    }
+    int micros = 1 << std::min(emptyPolls - kLegWaitSpins, 9);
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(micros, kMaxLegWaitMicros)));
+}
+
+// Wrap an angle difference into (-180, 180]
+double wrapDegrees(double degrees) {
+    degrees = std::fmod(degrees, 360.0);
+    if (degrees > 180.0) {
+        degrees -= 360.0;
+    } else if (degrees <= -180.0) {
+        degrees += 360.0;
+    }
+    return degrees;
+}
+}
 
 // Constructor
-RobotPathPlanner::RobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height) :
+template <typename PathList>
+BasicRobotPathPlanner<PathList>::BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height) :
+    BasicRobotPathPlanner(startX, startY, destX, destY, width, height, nullptr, MAP_DENSE) {}
+
+// Constructor choosing the obstacle storage
+template <typename PathList>
+BasicRobotPathPlanner<PathList>::BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height,
+                                                       MapBackend backend) :
+    BasicRobotPathPlanner(startX, startY, destX, destY, width, height, nullptr, backend) {}
+
+// Constructor using a mapped map file as the obstacle grid, without copying it
+template <typename PathList>
+BasicRobotPathPlanner<PathList>::BasicRobotPathPlanner(const MappedMapFile& map_file) :
+    BasicRobotPathPlanner(map_file.getHeader().startX, map_file.getHeader().startY,
+                          map_file.getHeader().destX, map_file.getHeader().destY,
+                          map_file.getHeader().width, map_file.getHeader().height, map_file.getWords(),
+                          MAP_DENSE) {}
+
+// Constructor over existing obstacle storage (nullptr to allocate it) or a sparse backend
+//
+// The clearance map is left unbuilt until the first detour needs it, so a
+// large mapped field costs nothing at startup. With MAP_SPARSE the dense
+// grid is not even allocated until getDenseObstacles needs it.
+template <typename PathList>
+BasicRobotPathPlanner<PathList>::BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height,
+                                                       uint64_t* obstacle_words, MapBackend backend) :
     currentX(startX), currentY(startY), currentDirection(NORTH),
-    finalX(destX), finalY(destY), mapWidth(width), mapHeight(height) {
+    finalX(destX), finalY(destY), mapWidth(width), mapHeight(height),
+    obstacles(backend == MAP_SPARSE ? OccupancyGrid(width, height, false) : OccupancyGrid(width, height, obstacle_words)),
+    sparseObstacles(backend == MAP_SPARSE ? new SparseObstacleMap(width, height) : nullptr),
+    obstacleMap(sparseObstacles ? static_cast<ObstacleMap*>(sparseObstacles.get()) : &obstacles),
+    clearance(obstacles, false), clearancePool(nullptr), connectivity(obstacles, false),
+    sparseFloodDone(false), sparseFloodDecided(false), sparseFloodReachable(false), path(),
+    plannerMode(GREEDY_PLANNER), executionMode(EXECUTION_SEQUENTIAL), route(0), turnCostModel(getDefaultTurnCostModel()),
+    allowedMoves(MOVES_NORTH_EAST), incrementalPlanner(obstacles, allowedMoves),
+    anytimeSearch(obstacles, allowedMoves), planningBudget(kDefaultPlanningBudget), hardware(nullptr), driveRpm(10.0),
+    telemetry(nullptr), sensorQueue(nullptr), pathCache(nullptr), mapVersion(0), mapHash(0), mapHashValid(false),
+    checkpointWriter(nullptr), checkpointInterval(0), lastCheckpointMoves(0), collectNewObstacles(false), stepLimit(0), timeLimit(0.0),
+    runStart(std::chrono::steady_clock::now()), planStatus(PLAN_UNREACHABLE), runInstrumentation(getEmptyInstrumentSnapshot()),
+    instrumentationOutput(nullptr) {
     
-    // Initialize obstacles map
-    obstacles = new bool*[mapWidth];
-    for (int i = 0; i < mapWidth; i++) {
-        obstacles[i] = new bool[mapHeight];
-        for (int j = 0; j < mapHeight; j++) {
-            obstacles[i][j] = false;
-        }
-    }
+    planStats.moves = 0;
+    planStats.turns = 0;
+    planStats.compactions = 0;
+    planStats.removedNodes = 0;
+    planStats.stepLimitReached = false;
+    planStats.timeLimitReached = false;
+    planStats.idleSeconds = 0.0;
+    planStats.replans = 0;
+    planStats.discardedLegs = 0;
     
-    // Initialize path with maximum capacity of 10
-    path = DoublyLinkedList(10);
+    // Both path lists default to kRobotPathCapacity (10) nodes
 }
 
 // Destructor
-RobotPathPlanner::~RobotPathPlanner() {
-    // Clean up obstacles map
-    for (int i = 0; i < mapWidth; i++) {
-        delete[] obstacles[i];
-    }
-    delete[] obstacles;
+template <typename PathList>
+BasicRobotPathPlanner<PathList>::~BasicRobotPathPlanner() {
+    // The obstacle grid releases its own storage
 }
 
 // Initialize the robot
-void RobotPathPlanner::initialize() {
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::initialize() {
     // Add starting location to path
     path.insert(currentX, currentY, START_LOCATION);
+    segmentPath.append(currentX, currentY, START_LOCATION, currentDirection);
+    recordEvent(TELEMETRY_NODE_INSERTED, currentX, currentY, START_LOCATION, 0);
     
     // Calibrate the IMU
     calibrateInertial();
@@ -40,22 +130,96 @@ void RobotPathPlanner::initialize() {
     // Set initial direction to NORTH (180 degrees)
     currentDirection = NORTH;
     
-    // Configure drivetrain speed to 10 RPM
-    std::cout << "Setting drivetrain speed to 10 RPM" << std::endl;
+    // Configure drivetrain speed (10 RPM by default)
+    LOG_SUMMARY("Setting drivetrain speed to " << driveRpm << " RPM");
+    if (hardware != nullptr) {
+        hardware->setVelocity(driveRpm);
+    }
     
     // Print initial state
     printState();
 }
 
+// Continue a mission restored by restoreCheckpoint instead of calling initialize
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::resume(bool recalibrate) {
+    // Calibration ends with the robot facing NORTH
+    if (recalibrate) {
+        calibrateInertial();
+        currentDirection = NORTH;
+    }
+    
+    LOG_SUMMARY("Resuming at (" << currentX << ", " << currentY << ") facing " << getDirectionName(currentDirection)
+                << "; setting drivetrain speed to " << driveRpm << " RPM");
+    if (hardware != nullptr) {
+        hardware->setVelocity(driveRpm);
+    }
+    
+    printState();
+}
+
 // Execute the path planning algorithm
-void RobotPathPlanner::executePlanningAlgorithm() {
+template <typename PathList>
+PlanStatus BasicRobotPathPlanner<PathList>::executePlanningAlgorithm() {
+    // Counters are per thread, so the run's share is the change over the call
+    InstrumentSnapshot before = Instrumentation::getThreadSnapshot();
+    runStart = std::chrono::steady_clock::now();
+    planStatus = PLAN_UNREACHABLE;
+    {
+        INSTRUMENT_SCOPE(TIMER_PLANNING);
+        if (plannerMode != GREEDY_PLANNER) {
+            // The global planners index per-cell arrays by the dense grid
+            getDenseObstacles();
+        }
+        if (!isDestinationReachable()) {
+            // Nothing to drive: the checks above logged why
+        } else if (plannerMode == GREEDY_PLANNER) {
+            // The greedy walker decides one cell at a time, so it has nothing to pipeline
+            executeGreedyPlan();
+        } else if (plannerMode == ANYTIME_PLANNER) {
+            // Planning already interleaves with driving, one budget per cell
+            executeAnytimePlan();
+        } else if (executionMode == EXECUTION_PIPELINED && plannerMode != TURN_AWARE_PLANNER) {
+            executePipelinedPlan();
+        } else if (plannerMode == INCREMENTAL_PLANNER) {
+            executeIncrementalPlan();
+        } else {
+            executeSearchPlan();
+        }
+    }
+    runInstrumentation = subtractInstrumentSnapshots(Instrumentation::getThreadSnapshot(), before);
+    
+    if (isDestinationReached()) {
+        planStatus = PLAN_SUCCESS;
+    }
+    
+    if (instrumentationOutput != nullptr) {
+        writeInstrumentationJson(*instrumentationOutput, runInstrumentation);
+    }
+    return planStatus;
+}
+
+// Walk towards the destination one greedy step at a time
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::executeGreedyPlan() {
     // Continue until destination is reached
     while (!isDestinationReached()) {
+        if (isBudgetExhausted()) {
+            return;
+        }
+        drainSensorQueue();
+        if (!isDestinationReachable()) {
+            return;
+        }
+        
         // Determine movement priority
         Direction movementDirection = determineMovementPriority();
         
         // Check if we need to turn
         if (currentDirection != movementDirection) {
+            // The previous necessary node must be taken before the turn is recorded
+            NodeHandle previousNode = getLatestNecessaryNode();
+            
             // Turn to the new direction
             turn(movementDirection);
             
@@ -63,9 +227,8 @@ void RobotPathPlanner::executePlanningAlgorithm() {
             updatePath(TURNING_NODE);
             
             // Handle turning trigger
-            Node* currentNode = path.getTail();
-            Node* previousNode = path.findLatestNecessaryNode();
-            if (previousNode != currentNode) {
+            NodeHandle currentNode = path.getTail();
+            if (previousNode != PathList::kNullHandle && previousNode != currentNode) {
                 handleTurningTrigger(currentNode, previousNode);
             }
         }
@@ -79,23 +242,27 @@ void RobotPathPlanner::executePlanningAlgorithm() {
             markObstacle(currentX, currentY);
             
             // Update path with object detection node
+            NodeHandle previousNode = getLatestNecessaryNode();
             updatePath(OBJECT_DETECTION);
             
             // Handle turning trigger for obstacle avoidance
-            Node* currentNode = path.getTail();
-            Node* previousNode = path.findLatestNecessaryNode();
-            if (previousNode != currentNode) {
+            NodeHandle currentNode = path.getTail();
+            if (previousNode != PathList::kNullHandle && previousNode != currentNode) {
                 handleTurningTrigger(currentNode, previousNode);
             }
             
             // Determine new direction to avoid obstacle
-            Direction newDirection = (currentDirection == NORTH) ? EAST : NORTH;
+            int detourLength = 0;
+            Direction newDirection = getAvoidanceDirection(detourLength);
             
             // Turn to the new direction
-            turn(newDirection);
+            if (newDirection != currentDirection) {
+                turn(newDirection);
+            }
             
-            // Move to a safe distance (3-4 units) away from the obstacle
-            for (int i = 0; i < 3; i++) {
+            // Move to a safe distance (3-4 units) away from the obstacle,
+            // stopping short of blocked cells, the map edge and the destination
+            for (int i = 0; i < detourLength; i++) {
                 move();
                 updatePath(REGULAR);
             }
@@ -113,123 +280,1278 @@ void RobotPathPlanner::executePlanningAlgorithm() {
         printState();
     }
     
-    std::cout << "Destination reached! Path planning completed successfully." << std::endl;
+    LOG_SUMMARY("Destination reached! Path planning completed successfully.");
+}
+
+// Plan a global route and drive along its waypoints
+//
+// Obstacles reported by the sensor while driving are checked against the
+// rest of the route; if one lands on it, the robot stops short of it and
+// the route is searched again from where the robot stands.
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::executeSearchPlan() {
+    // Search only the axis moves the drivetrain can make
+    GridSearch search(obstacles, allowedMoves,
+                      plannerMode == JUMP_POINT_PLANNER ? SEARCH_JUMP_POINT : SEARCH_ASTAR);
+    TurnAwareSearch turnSearch(obstacles, allowedMoves, turnCostModel);
+    if (!planGlobalRoute(search, turnSearch)) {
+        return;
+    }
+    
+    // Drive each straight leg between consecutive waypoints
+    Node* waypoint = route.getHead()->next;
+    while (waypoint != nullptr) {
+        if (isBudgetExhausted()) {
+            return;
+        }
+        
+        // Replan from here if new obstacles block what is left of the route
+        if (drainSensorQueue() > 0 && isRouteBlocked(waypoint)) {
+            planStats.replans++;
+            LOG_SUMMARY("New obstacle(s) on the route: replanning from (" << currentX << ", " << currentY << ")");
+            if (!isDestinationReachable() || !planGlobalRoute(search, turnSearch)) {
+                return;
+            }
+            waypoint = route.getHead()->next;
+            continue;
+        }
+        
+        if (currentX == waypoint->x && currentY == waypoint->y) {
+            waypoint = waypoint->next;
+            continue;
+        }
+        driveStep(getDirectionFromStep(getSign(waypoint->x - currentX), getSign(waypoint->y - currentY)));
+    }
+    
+    LOG_SUMMARY("Destination reached! Path planning completed successfully.");
+}
+
+// Plan a route from the robot into the waypoint route; false if there is none
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::planGlobalRoute(GridSearch& search, TurnAwareSearch& turnSearch) {
+    bool turnAware = (plannerMode == TURN_AWARE_PLANNER);
+    
+    // A route cached for this exact map, endpoints, moves and mode skips the search
+    // (the searches only take axis moves, so the diagonal flag does not change a route)
+    PathCacheKey key = {currentX, currentY, finalX, finalY, mapWidth, mapHeight, 0,
+                        static_cast<int>(plannerMode), allowedMoves & MOVES_ALL, -1, 0.0, 0.0};
+    if (turnAware) {
+        // Turn-aware routes also depend on the heading and on both costs
+        key.heading = getDirectionIndex(currentDirection);
+        key.turnSeconds = turnCostModel.turnSeconds;
+        key.moveSeconds = turnCostModel.moveSeconds;
+    }
+    CachedPath cached;
+    if (pathCache != nullptr) {
+        key.mapHash = getMapHash();
+    }
+    if (pathCache != nullptr && pathCache->lookup(key, cached)) {
+        LOG_SUMMARY("Route from cache: " << cached.length << " steps, " << cached.waypoints.size() << " waypoints");
+    } else {
+        std::chrono::steady_clock::time_point searchStart = std::chrono::steady_clock::now();
+        bool found = false;
+        if (turnAware) {
+            int headingDx = 0;
+            int headingDy = 0;
+            getDirectionStep(currentDirection, headingDx, headingDy);
+            found = turnSearch.findPath(currentX, currentY, headingDx, headingDy, finalX, finalY);
+        } else {
+            found = search.findPath(currentX, currentY, finalX, finalY);
+        }
+        planStats.idleSeconds += secondsSince(searchStart);
+        long long expansions = turnAware ? turnSearch.getExpansions() : search.getExpansions();
+        if (!found) {
+            LOG_SUMMARY("No route to destination found after " << expansions << " expansions.");
+            return false;
+        }
+        
+        cached.waypoints = turnAware ? turnSearch.getWaypoints() : search.getWaypoints();
+        cached.length = turnAware ? turnSearch.getPathLength() : search.getPathLength();
+        LOG_SUMMARY("Route planned: " << cached.length << " steps, "
+                    << cached.waypoints.size() << " waypoints, "
+                    << expansions << " expansions");
+        if (turnAware) {
+            LOG_SUMMARY("Predicted drive time: " << turnSearch.getPredictedSeconds() << " s with "
+                        << turnSearch.getTurnCount() << " turns");
+        }
+        if (pathCache != nullptr) {
+            pathCache->insert(key, cached);
+        }
+    }
+    
+    // Keep the waypoint route sized to exactly fit the result
+    route = DoublyLinkedList(static_cast<int>(cached.waypoints.size()));
+    buildWaypointList(cached.waypoints, route);
+    
+    return true;
+}
+
+// Check if an obstacle lies on the rest of the route, from the robot through waypoint to the destination
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isRouteBlocked(const Node* waypoint) {
+    int x = currentX;
+    int y = currentY;
+    for (const Node* next = waypoint; next != nullptr; next = next->next) {
+        int stepX = getSign(next->x - x);
+        int stepY = getSign(next->y - y);
+        while (x != next->x || y != next->y) {
+            x += stepX;
+            y += stepY;
+            if (isObstacleDetected(x, y)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Drive along the D* Lite route, repairing it whenever obstacles are marked
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::executeIncrementalPlan() {
+    // Reuse the existing search state if it was built for this destination
+    if (!incrementalPlanner.isInitialized()) {
+        std::chrono::steady_clock::time_point searchStart = std::chrono::steady_clock::now();
+        incrementalPlanner.initialize(currentX, currentY, finalX, finalY);
+        planStats.idleSeconds += secondsSince(searchStart);
+        const RepairStats& initial = incrementalPlanner.getLastRepairStats();
+        LOG_SUMMARY("Initial search expanded " << initial.expanded << " nodes");
+    } else {
+        incrementalPlanner.moveStart(currentX, currentY);
+    }
+    
+    while (!isDestinationReached()) {
+        if (isBudgetExhausted()) {
+            return;
+        }
+        drainSensorQueue();
+        if (!isDestinationReachable()) {
+            return;
+        }
+        
+        // Repair the route if markObstacle reported new obstacles
+        std::chrono::steady_clock::time_point repairStart = std::chrono::steady_clock::now();
+        bool repaired = incrementalPlanner.repair();
+        planStats.idleSeconds += secondsSince(repairStart);
+        if (repaired) {
+            planStats.replans++;
+            const RepairStats& stats = incrementalPlanner.getLastRepairStats();
+            LOG_SUMMARY("Route repaired after " << stats.changedCells << " new obstacle(s): "
+                        << stats.expanded << " expanded, " << stats.updated << " updated");
+        }
+        
+        // Pick the next cell on the current shortest route
+        int nextX = currentX;
+        int nextY = currentY;
+        if (!incrementalPlanner.getNextStep(nextX, nextY)) {
+            LOG_SUMMARY("No route to destination from (" << currentX << ", " << currentY << ").");
+            return;
+        }
+        Direction stepDirection = getDirectionFromStep(nextX - currentX, nextY - currentY);
+        
+        // Check if we need to turn
+        if (currentDirection != stepDirection) {
+            NodeHandle previousNode = getLatestNecessaryNode();
+            
+            // Turn to the new direction
+            turn(stepDirection);
+            
+            // Update path with turning node and handle the turning trigger
+            updatePath(TURNING_NODE);
+            NodeHandle currentNode = path.getTail();
+            if (previousNode != PathList::kNullHandle && previousNode != currentNode) {
+                handleTurningTrigger(currentNode, previousNode);
+            }
+        }
+        
+        // Move one cell and let the search know where the robot is
+        move();
+        incrementalPlanner.moveStart(currentX, currentY);
+        updatePath(REGULAR);
+        
+        // Check if path capacity is reached
+        if (path.isFull()) {
+            handleCapacityTrigger();
+        }
+        
+        // Print current state
+        printState();
+    }
+    
+    LOG_SUMMARY("Destination reached! Path planning completed successfully.");
+}
+
+// Drive along the anytime route, searching for at most planningBudget per cell
+//
+// Each cycle spends its budget improving the route and then drives one cell
+// along the best route found so far, so the robot gets moving on a
+// weighted-A* route while later cycles shorten what is left of it. A cycle
+// that finds no route yet leaves the robot waiting in place. New obstacles
+// invalidate the search costs, so the search starts again from the robot.
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::executeAnytimePlan() {
+    unsigned long long searchedVersion = mapVersion;
+    if (!anytimeSearch.start(currentX, currentY, finalX, finalY)) {
+        LOG_SUMMARY("No route to destination from (" << currentX << ", " << currentY << ").");
+        return;
+    }
+    double lastBound = anytimeSearch.getSuboptimalityBound();
+    
+    while (!isDestinationReached()) {
+        if (isBudgetExhausted()) {
+            return;
+        }
+        drainSensorQueue();
+        if (!isDestinationReachable()) {
+            return;
+        }
+        
+        // Restart the search if markObstacle changed the map under it
+        if (mapVersion != searchedVersion) {
+            searchedVersion = mapVersion;
+            planStats.replans++;
+            LOG_SUMMARY("New obstacle(s): restarting the anytime search from (" << currentX << ", " << currentY << ")");
+            if (!anytimeSearch.start(currentX, currentY, finalX, finalY)) {
+                LOG_SUMMARY("No route to destination from (" << currentX << ", " << currentY << ").");
+                return;
+            }
+            lastBound = anytimeSearch.getSuboptimalityBound();
+        }
+        
+        // Spend this cycle's budget improving the route
+        std::chrono::steady_clock::time_point searchStart = std::chrono::steady_clock::now();
+        bool found = anytimeSearch.improve(planningBudget);
+        planStats.idleSeconds += secondsSince(searchStart);
+        if (anytimeSearch.getSuboptimalityBound() < lastBound) {
+            lastBound = anytimeSearch.getSuboptimalityBound();
+            LOG_STEP("Anytime route of " << anytimeSearch.getPathLength() << " cells, within "
+                     << lastBound << "x of the shortest");
+        }
+        
+        // Wait for another cycle until a route is known
+        int nextX = currentX;
+        int nextY = currentY;
+        if (!found || !anytimeSearch.getNextStep(nextX, nextY)) {
+            if (anytimeSearch.isComplete()) {
+                LOG_SUMMARY("No route to destination from (" << currentX << ", " << currentY << ").");
+                return;
+            }
+            continue;
+        }
+        
+        // Move one cell and let the search know where the robot is
+        driveStep(getDirectionFromStep(nextX - currentX, nextY - currentY));
+        anytimeSearch.moveStart(currentX, currentY);
+    }
+    
+    LOG_SUMMARY("Destination reached after " << anytimeSearch.getRounds() << " anytime round(s); final bound "
+                << anytimeSearch.getSuboptimalityBound() << ".");
+}
+
+// Drive along routes planned by a background worker
+//
+// The worker streams the legs of its route through a queue while this
+// thread drives them. When new obstacles are marked, the robot commits to
+// the next few free cells of its current leg and the worker replans from
+// the end of that commitment, so replanning overlaps the drive instead of
+// stopping it. Legs of superseded routes are discarded by generation.
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::executePipelinedPlan() {
+    PlanPipeline pipeline(obstacles, finalX, finalY, allowedMoves,
+                          plannerMode == JUMP_POINT_PLANNER ? SEARCH_JUMP_POINT : SEARCH_ASTAR,
+                          plannerMode == INCREMENTAL_PLANNER);
+    collectNewObstacles = true;
+    newObstacles.clear();
+    
+    int generation = 0;
+    pipeline.requestPlan(generation, currentX, currentY, newObstacles);
+    
+    // End of the stretch currently being driven
+    int targetX = currentX;
+    int targetY = currentY;
+    bool haveTarget = false;
+    bool routeDone = false;
+    
+    while (!isDestinationReached()) {
+        if (isBudgetExhausted()) {
+            break;
+        }
+        drainSensorQueue();
+        if (!isDestinationReachable()) {
+            break;
+        }
+        
+        // New obstacles: keep driving the free cells just ahead while the worker replans
+        if (!newObstacles.empty()) {
+            int dx = haveTarget ? getSign(targetX - currentX) : 0;
+            int dy = haveTarget ? getSign(targetY - currentY) : 0;
+            int commitX = currentX;
+            int commitY = currentY;
+            for (int i = 0; i < kPipelineCommitCells && haveTarget && (commitX != targetX || commitY != targetY); i++) {
+                if (obstacles.isObstacleDetected(commitX + dx, commitY + dy)) {
+                    break;
+                }
+                commitX += dx;
+                commitY += dy;
+            }
+            
+            generation++;
+            planStats.replans++;
+            LOG_STEP("New obstacle(s): replanning from (" << commitX << ", " << commitY << ")");
+            pipeline.requestPlan(generation, commitX, commitY, newObstacles);
+            newObstacles.clear();
+            targetX = commitX;
+            targetY = commitY;
+            haveTarget = (commitX != currentX || commitY != currentY);
+            routeDone = false;
+        }
+        
+        // Wait for the next leg of the current route
+        if (!haveTarget) {
+            if (routeDone) {
+                LOG_SUMMARY("Route ended at (" << currentX << ", " << currentY << ") before the destination.");
+                break;
+            }
+            
+            // The budgets still apply while waiting, and a finished generation sends nothing more
+            std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+            PlannedLeg leg;
+            bool received = false;
+            bool stalled = false;
+            int emptyPolls = 0;
+            while (!received && !stalled && !isBudgetExhausted()) {
+                bool finished = pipeline.isGenerationFinished(generation);
+                if (!pipeline.pollLeg(leg)) {
+                    if (finished) {
+                        stalled = true;
+                    } else {
+                        waitForLeg(emptyPolls++);
+                    }
+                } else if (leg.generation != generation || leg.fromX != currentX || leg.fromY != currentY) {
+                    planStats.discardedLegs++;
+                } else {
+                    received = true;
+                }
+            }
+            planStats.idleSeconds += secondsSince(waitStart);
+            if (stalled) {
+                LOG_SUMMARY("Route planner sent no leg from (" << currentX << ", " << currentY << ").");
+            }
+            if (!received) {
+                break;
+            }
+            
+            if (leg.failed) {
+                LOG_SUMMARY("No route to destination from (" << currentX << ", " << currentY << ").");
+                break;
+            }
+            targetX = leg.toX;
+            targetY = leg.toY;
+            routeDone = leg.last;
+            haveTarget = (targetX != currentX || targetY != currentY);
+            continue;
+        }
+        
+        driveStep(getDirectionFromStep(getSign(targetX - currentX), getSign(targetY - currentY)));
+        haveTarget = (targetX != currentX || targetY != currentY);
+    }
+    
+    collectNewObstacles = false;
+    LOG_SUMMARY("Pipelined execution: " << planStats.replans << " replans, " << planStats.discardedLegs
+                << " stale legs discarded, " << pipeline.getPlanningSeconds() * 1e3 << " ms planning, "
+                << planStats.idleSeconds * 1e3 << " ms waiting for routes");
+    if (isDestinationReached()) {
+        LOG_SUMMARY("Destination reached! Path planning completed successfully.");
+    }
+}
+
+// Turn if needed, drive one cell and record it
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::driveStep(Direction direction) {
+    // Check if we need to turn
+    if (currentDirection != direction) {
+        NodeHandle previousNode = getLatestNecessaryNode();
+        
+        // Turn to the new direction
+        turn(direction);
+        
+        // Update path with turning node and handle the turning trigger
+        updatePath(TURNING_NODE);
+        NodeHandle currentNode = path.getTail();
+        if (previousNode != PathList::kNullHandle && previousNode != currentNode) {
+            handleTurningTrigger(currentNode, previousNode);
+        }
+    }
+    
+    move();
+    updatePath(REGULAR);
+    
+    // Check if path capacity is reached
+    if (path.isFull()) {
+        handleCapacityTrigger();
+    }
+    
+    // Print current state
+    printState();
 }
 
 // Calibrate the inertial measurement unit (IMU)
-void RobotPathPlanner::calibrateInertial() {
-    std::cout << "Calibrating IMU..." << std::endl;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::calibrateInertial() {
+    LOG_SUMMARY("Calibrating IMU...");
     
-    // This is a simulation of the cali_inertial() function provided in the appendix
-    // In a real implementation, this would call the actual hardware functions
+    // cali_inertial() from the appendix: calibrate, then turn right until
+    // the IMU reads past 166 degrees so the robot ends up facing NORTH
+    if (hardware != nullptr) {
+        hardware->setVelocity(kCalibrationRpm);
+        hardware->calibrateImu();
+        while (hardware->isImuCalibrating()) {}
+        hardware->wait(1.0);
+        hardware->startTurnRight();
+        hardware->wait(0.4);
+        
+        while (hardware->getHeading() < 166.0) {}
+        hardware->stop();
+        hardware->wait(1.0);
+    }
     
-    std::cout << "IMU calibration completed." << std::endl;
+    LOG_SUMMARY("IMU calibration completed.");
 }
 
 // Check if an obstacle is detected
-bool RobotPathPlanner::isObstacleDetected(int x, int y) {
-    // Check if the position is within map bounds
-    if (x < 0 || x >= mapWidth || y < 0 || y >= mapHeight) {
-        return true;  // Treat out-of-bounds as obstacles
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isObstacleDetected(int x, int y) {
+    // Out-of-bounds positions are treated as obstacles by the map
+    return obstacleMap->isObstacleDetected(x, y);
+}
+
+// Mark an obstacle at the specified position
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::markObstacle(int x, int y) {
+    // Out-of-bounds positions are ignored by the map
+    if (obstacleMap->isObstacleDetected(x, y)) {
+        return;
+    }
+    obstacleMap->markObstacle(x, y);
+    if (obstacleMap != &obstacles && obstacles.isAllocated()) {
+        obstacles.markObstacle(x, y);
     }
+    clearance.notifyObstacleAdded(x, y);
+    connectivity.notifyObstacleAdded(x, y);
+    sparseFloodDone = false;
+    mapVersion++;
+    if (mapHashValid) {
+        mapHash ^= getObstacleCellHash(x, y);
+    }
+    recordEvent(TELEMETRY_OBSTACLE_DETECTED, x, y, 0, 0);
+    
+    // Queue the change so the incremental planner repairs only what it affects
+    incrementalPlanner.notifyCellChanged(x, y);
     
-    // Check if there's an obstacle at the position
-    return obstacles[x][y];
+    // A pipelined run hands the change to its worker with the next plan request
+    if (collectNewObstacles) {
+        newObstacles.push_back(GridCell{x, y});
+    }
 }
 
-// Mark an obstacle at the specified position
-void RobotPathPlanner::markObstacle(int x, int y) {
-    // Check if the position is within map bounds
-    if (x >= 0 && x < mapWidth && y >= 0 && y < mapHeight) {
-        obstacles[x][y] = true;
+// Count the free cells ahead in a direction, up to max_cells
+//
+// The first cell only has to be free, since it lies beside the obstacle
+// being left; every later cell must keep kMinDetourClearanceSquared from
+// all obstacles (everything outside the map has none). The detour never
+// passes the destination row or column, which a NORTH/EAST drivetrain
+// could not come back to. With away set, a drivetrain that can drive back
+// may lead away from them, but still never crosses them.
+template <typename PathList>
+int BasicRobotPathPlanner<PathList>::getSafeDetourLength(Direction direction, int max_cells, bool away) {
+    int dx = 0;
+    int dy = 0;
+    getDirectionStep(direction, dx, dy);
+    
+    bool leave = away && isDirectionAllowed(rotateDirection(direction, 180), allowedMoves);
+    
+    int length = 0;
+    for (int i = 1; i <= max_cells; i++) {
+        int x = currentX + dx * i;
+        int y = currentY + dy * i;
+        bool clear = (i == 1) ? !isObstacleDetected(x, y) : getClearanceSquared(x, y) >= kMinDetourClearanceSquared;
+        if (!clear ||
+            (dx > 0 && x > finalX && (!leave || currentX < finalX)) ||
+            (dx < 0 && x < finalX && (!leave || currentX > finalX)) ||
+            (dy > 0 && y > finalY && (!leave || currentY < finalY)) ||
+            (dy < 0 && y < finalY && (!leave || currentY > finalY))) {
+            break;
+        }
+        length = i;
     }
+    return length;
+}
+
+// Get the squared clearance of a cell, capped at kAvoidanceCells squared
+//
+// Space further out than a detour reaches does not separate two detours.
+// Only obstacles strictly inside the cap lie in the box of radius
+// kAvoidanceCells - 1 around the cell, so a sparse map that has not been
+// made dense answers from that box instead of building the clearance map.
+template <typename PathList>
+int BasicRobotPathPlanner<PathList>::getClearanceSquared(int x, int y) {
+    const int cap = kAvoidanceCells * kAvoidanceCells;
+    if (!sparseObstacles || obstacles.isAllocated()) {
+        return std::min(getBuiltClearance().getDistanceSquared(x, y), cap);
+    }
+    
+    // Like the clearance map, everything outside the map counts as an obstacle
+    const int reach = kAvoidanceCells - 1;
+    if (sparseObstacles->isRectangleFree(x - reach, y - reach, x + reach, y + reach)) {
+        return cap;
+    }
+    int nearest = cap;
+    for (int dy = -reach; dy <= reach; dy++) {
+        for (int dx = -reach; dx <= reach; dx++) {
+            if (dx * dx + dy * dy < nearest && isObstacleDetected(x + dx, y + dy)) {
+                nearest = dx * dx + dy * dy;
+            }
+        }
+    }
+    return nearest;
 }
 
 // Determine movement priority based on distance to destination
-Direction RobotPathPlanner::determineMovementPriority() {
+template <typename PathList>
+Direction BasicRobotPathPlanner<PathList>::determineMovementPriority() {
+    INSTRUMENT_SCOPE(TIMER_MOVEMENT_PRIORITY);
+    
     // Calculate distances to destination in x and y directions
     int distX = finalX - currentX;
     int distY = finalY - currentY;
+    int stepX = getSign(distX);
+    int stepY = getSign(distY);
     
-    // If both distances are equal, prioritize x direction (EAST)
-    if (std::abs(distX) == std::abs(distY)) {
-        return EAST;
+    // Take the diagonal when allowed, unless it ends on or cuts the corner of an obstacle
+    if (stepX != 0 && stepY != 0) {
+        Direction diagonal = getDirectionFromStep(stepX, stepY);
+        if (isDirectionAllowed(diagonal, allowedMoves) && !isObstacleDetected(currentX + stepX, currentY + stepY) &&
+            !isObstacleDetected(currentX + stepX, currentY) && !isObstacleDetected(currentX, currentY + stepY)) {
+            return diagonal;
+        }
+    }
+    
+    // A known obstacle on the longer axis hands the step to the other one
+    bool xBlocked = isObstacleDetected(currentX + stepX, currentY);
+    bool yBlocked = isObstacleDetected(currentX, currentY + stepY);
+    if (stepX != 0 && stepY != 0 && xBlocked != yBlocked) {
+        return xBlocked ? getDirectionFromStep(0, stepY) : getDirectionFromStep(stepX, 0);
+    }
+    
+    // If both distances are equal, prioritize the x direction (EAST or WEST)
+    if (std::abs(distX) >= std::abs(distY)) {
+        return (stepX != 0) ? getDirectionFromStep(stepX, 0) : currentDirection;
     }
     
     // Otherwise, prioritize the direction with the greater distance
-    return (std::abs(distX) > std::abs(distY)) ? EAST : NORTH;
+    return getDirectionFromStep(0, stepY);
+}
+
+// Check if the drivetrain can leave (x, y) only back the way it came in
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isDeadEnd(int x, int y, Direction arrival) {
+    const int axisDegrees[3] = {0, 90, -90};
+    for (int turnBy : axisDegrees) {
+        Direction exit = rotateDirection(arrival, turnBy);
+        int dx = 0;
+        int dy = 0;
+        getDirectionStep(exit, dx, dy);
+        if (isDirectionAllowed(exit, allowedMoves) && !isObstacleDetected(x + dx, y + dy)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Pick the direction to leave a detected obstacle in and the detour length
+//
+// A quarter turn whose first cell is blocked or off the map, or whose
+// detour ends in a dead end, is never taken. Of the others, the longer
+// safe detour wins, then the one ending in more open space, then the one
+// closing the distance to the destination. Only when neither side works
+// towards the destination may a detour lead away from it. Backing off is
+// the last resort, taken only when the cell ahead is blocked too; with it
+// free the walk simply carries on past the obstacle.
+template <typename PathList>
+Direction BasicRobotPathPlanner<PathList>::getAvoidanceDirection(int& detour_length) {
+    const int turnDegrees[2] = {90, -90};
+    Direction best = currentDirection;
+    int bestLength = 0;
+    int bestOpen = 0;
+    int bestProgress = 0;
+    bool found = false;
+    
+    for (int pass = 0; pass < 2 && !found; pass++) {
+        bool away = (pass == 1);
+        for (int turnBy : turnDegrees) {
+            Direction candidate = rotateDirection(currentDirection, turnBy);
+            if (!isDirectionAllowed(candidate, allowedMoves)) {
+                continue;
+            }
+            int dx = 0;
+            int dy = 0;
+            getDirectionStep(candidate, dx, dy);
+            int length = getSafeDetourLength(candidate, kAvoidanceCells, away);
+            if (length == 0 || isDeadEnd(currentX + dx * length, currentY + dy * length, candidate)) {
+                continue;
+            }
+            
+            int open = getClearanceSquared(currentX + dx * length, currentY + dy * length);
+            int progress = dx * getSign(finalX - currentX) + dy * getSign(finalY - currentY);
+            bool better = !found || length > bestLength ||
+                          (length == bestLength && (open > bestOpen || (open == bestOpen && progress > bestProgress)));
+            if (better) {
+                best = candidate;
+                bestLength = length;
+                bestOpen = open;
+                bestProgress = progress;
+                found = true;
+            }
+        }
+    }
+    
+    int aheadX = 0;
+    int aheadY = 0;
+    getDirectionStep(currentDirection, aheadX, aheadY);
+    Direction back = rotateDirection(currentDirection, 180);
+    if (!found && isObstacleDetected(currentX + aheadX, currentY + aheadY) && isDirectionAllowed(back, allowedMoves)) {
+        best = back;
+        bestLength = getSafeDetourLength(back, kAvoidanceCells, true);
+    }
+    detour_length = bestLength;
+    return best;
 }
 
 // Turn the robot to a new direction
-void RobotPathPlanner::turn(Direction newDirection) {
-    std::cout << "Turning from " << (currentDirection == NORTH ? "NORTH" : "EAST") 
-              << " to " << (newDirection == NORTH ? "NORTH" : "EAST") << std::endl;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::turn(Direction newDirection) {
+    LOG_STEP("Turning from " << getDirectionName(currentDirection)
+             << " to " << getDirectionName(newDirection));
     
-    // In a real implementation, this would control the robot's motors to turn
-    // and use the IMU to correct the angle as specified in step 9
+    // Turn on the IMU heading, then correct slowly until within tolerance (step 9)
+    if (hardware != nullptr) {
+        double target = static_cast<double>(newDirection);
+        hardware->turnBy(wrapDegrees(target - hardware->getHeading()));
+        hardware->setVelocity(kCorrectionRpm);
+        for (int i = 0; i < kMaxHeadingCorrections; i++) {
+            hardware->wait(kSettleSeconds);
+            double error = wrapDegrees(target - hardware->getHeading());
+            if (std::fabs(error) <= kHeadingToleranceDegrees) {
+                break;
+            }
+            hardware->turnBy(error);
+        }
+        hardware->setVelocity(driveRpm);
+    }
     
     // Update the current direction
     currentDirection = newDirection;
+    planStats.turns++;
+    INSTRUMENT_COUNT(COUNTER_TURNS);
+    recordEvent(TELEMETRY_TURN, currentX, currentY, 0, 0);
 }
 
 // Move the robot in the current direction
-void RobotPathPlanner::move() {
-    // Move 1 unit (2 cm) in the current direction
-    if (currentDirection == NORTH) {
-        currentY++;
-    } else {  // EAST
-        currentX++;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::move() {
+    // Move 1 unit (2 cm) in the current direction, or one diagonal
+    int dx = 0;
+    int dy = 0;
+    getDirectionStep(currentDirection, dx, dy);
+    currentX += dx;
+    currentY += dy;
+    planStats.moves++;
+    INSTRUMENT_COUNT(COUNTER_MOVES);
+    
+    if (hardware != nullptr) {
+        hardware->driveForward(isDiagonal(currentDirection) ? kDiagonalCellCm : kCellSizeCm);
     }
+    recordEvent(TELEMETRY_MOVE, currentX, currentY, 0, 0);
     
-    std::cout << "Moved to position (" << currentX << ", " << currentY << ")" << std::endl;
+    LOG_STEP("Moved to position (" << currentX << ", " << currentY << ")");
 }
 
 // Update the path with a new node
-void RobotPathPlanner::updatePath(NodeType nodeType) {
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::updatePath(NodeType nodeType) {
     // Add a new node to the path
-    path.insert(currentX, currentY, nodeType);
+    if (path.insert(currentX, currentY, nodeType)) {
+        INSTRUMENT_COUNT(COUNTER_NODES_INSERTED);
+    }
+    
+    // Straight REGULAR steps only extend the last segment
+    segmentPath.append(currentX, currentY, nodeType, currentDirection);
+    recordEvent(TELEMETRY_NODE_INSERTED, currentX, currentY, nodeType, 0);
     
-    std::cout << "Added " << (nodeType == REGULAR ? "REGULAR" : 
-                             nodeType == START_LOCATION ? "START_LOCATION" : 
-                             nodeType == TURNING_NODE ? "TURNING_NODE" : "OBJECT_DETECTION") 
-              << " node at (" << currentX << ", " << currentY << ")" << std::endl;
+    LOG_STEP("Added " << getNodeTypeName(nodeType)
+             << " node at (" << currentX << ", " << currentY << ")");
+    
+    writeCheckpointIfDue();
+}
+
+// Find the latest necessary node of the path, counting the lookup
+template <typename PathList>
+typename BasicRobotPathPlanner<PathList>::NodeHandle BasicRobotPathPlanner<PathList>::getLatestNecessaryNode() {
+    INSTRUMENT_COUNT(COUNTER_NECESSARY_LOOKUPS);
+    return path.findLatestNecessaryNode();
 }
 
 // Handle capacity trigger
-void RobotPathPlanner::handleCapacityTrigger() {
-    std::cout << "Path capacity reached. Removing regular nodes..." << std::endl;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::handleCapacityTrigger() {
+    INSTRUMENT_SCOPE(TIMER_CAPACITY_TRIGGER);
+    INSTRUMENT_COUNT(COUNTER_CAPACITY_TRIGGERS);
+    LOG_STEP("Path capacity reached. Removing regular nodes...");
     
     // Remove regular nodes between current position and latest necessary node
-    path.removeRegularNodes();
+    int removed = path.removeRegularNodes();
+    INSTRUMENT_ADD(COUNTER_NODES_REMOVED, removed);
+    planStats.removedNodes += removed;
+    planStats.compactions++;
+    recordEvent(TELEMETRY_COMPACTION, currentX, currentY, COMPACTION_CAPACITY, removed);
     
-    std::cout << "Regular nodes removed. Current path:" << std::endl;
-    path.print();
+    LOG_STEP("Regular nodes removed. Current path:");
+    path.print(LOG_LEVEL_TRACE);
 }
 
 // Handle turning trigger
-void RobotPathPlanner::handleTurningTrigger(Node* currentNode, Node* previousNode) {
-    std::cout << "Turning triggered. Removing regular nodes between necessary nodes..." << std::endl;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::handleTurningTrigger(NodeHandle currentNode, NodeHandle previousNode) {
+    INSTRUMENT_SCOPE(TIMER_TURNING_TRIGGER);
+    INSTRUMENT_COUNT(COUNTER_TURNING_TRIGGERS);
+    LOG_STEP("Turning triggered. Removing regular nodes between necessary nodes...");
     
     // Remove regular nodes between current necessary node and previous necessary node
-    path.removeRegularNodesBetweenNecessary(currentNode, previousNode);
+    int removed = path.removeRegularNodesBetweenNecessary(currentNode, previousNode);
+    INSTRUMENT_ADD(COUNTER_NODES_REMOVED, removed);
+    planStats.removedNodes += removed;
+    planStats.compactions++;
+    recordEvent(TELEMETRY_COMPACTION, currentX, currentY, COMPACTION_TURNING, removed);
+    
+    LOG_STEP("Regular nodes removed. Current path:");
+    path.print(LOG_LEVEL_TRACE);
+}
+
+// Set the planning mode used by executePlanningAlgorithm
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setPlannerMode(PlannerMode mode) {
+    plannerMode = mode;
+}
+
+// Set how executePlanningAlgorithm overlaps planning with driving
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setExecutionMode(ExecutionMode mode) {
+    executionMode = mode;
+}
+
+// Drive the given hardware while planning (nullptr to only plan)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setHardware(RobotHardware* robot_hardware) {
+    hardware = robot_hardware;
+}
+
+// Get the instrumentation counters and timers of the last executePlanningAlgorithm
+template <typename PathList>
+const InstrumentSnapshot& BasicRobotPathPlanner<PathList>::getInstrumentation() const {
+    return runInstrumentation;
+}
+
+// Write the instrumentation as JSON after each executePlanningAlgorithm (nullptr for none)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setInstrumentationOutput(std::ostream* output) {
+    instrumentationOutput = output;
+}
+
+// Take obstacle observations from a sensor thread through the given queue (nullptr for none)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setSensorQueue(ObstacleSensorQueue* queue) {
+    sensorQueue = queue;
+}
+
+// Record path events to the given telemetry stream (nullptr for none)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setTelemetry(TelemetryWriter* writer) {
+    telemetry = writer;
+}
+
+// Reuse global routes through the given cache (nullptr for none)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setPathCache(PathCache* cache) {
+    pathCache = cache;
+}
+
+// Get the number of markObstacle calls that changed the map
+template <typename PathList>
+unsigned long long BasicRobotPathPlanner<PathList>::getMapVersion() const {
+    return mapVersion;
+}
+
+// Get the content hash of the obstacles (computed on first use, then kept up to date)
+template <typename PathList>
+uint64_t BasicRobotPathPlanner<PathList>::getMapHash() {
+    if (!mapHashValid) {
+        mapHash = computeMapHash(getDenseObstacles());
+        mapHashValid = true;
+    }
+    return mapHash;
+}
+
+// Set the move and turn times weighed by TURN_AWARE_PLANNER
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setTurnCostModel(const TurnCostModel& model) {
+    turnCostModel = model;
+}
+
+// Set the MoveSet flags the drivetrain may use
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setAllowedMoves(int allowed_moves) {
+    allowedMoves = allowed_moves;
+    incrementalPlanner.setAllowedMoves(allowed_moves);
+    anytimeSearch.setAllowedMoves(allowed_moves);
+}
+
+// Set the search seconds ANYTIME_PLANNER spends before each cell it drives
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setPlanningBudget(double seconds) {
+    planningBudget = (seconds > 0.0) ? seconds : 0.0;
+}
+
+// Write checkpoints through the given writer every few moves (nullptr for none)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setCheckpointWriter(CheckpointWriter* writer, int every_moves) {
+    checkpointWriter = writer;
+    checkpointInterval = every_moves;
+    lastCheckpointMoves = planStats.moves;
+}
+
+// Write a checkpoint now through the writer set by setCheckpointWriter
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::writeCheckpoint(std::string& error) {
+    if (checkpointWriter == nullptr) {
+        error = "no checkpoint writer set";
+        return false;
+    }
+    
+    CheckpointState state;
+    state.currentX = currentX;
+    state.currentY = currentY;
+    state.heading = static_cast<int32_t>(currentDirection);
+    state.moves = planStats.moves;
+    state.turns = planStats.turns;
+    state.compactions = planStats.compactions;
+    state.removedNodes = planStats.removedNodes;
+    state.replans = planStats.replans;
+    state.discardedLegs = planStats.discardedLegs;
+    state.flags = 0;
+    state.mapVersion = mapVersion;
+    
+    // The node buffer is kept between checkpoints
+    checkpointNodes.clear();
+    for (NodeHandle node = path.getHead(); node != PathList::kNullHandle; node = path.getNext(node)) {
+        CheckpointNode record = {path.getX(node), path.getY(node), static_cast<int32_t>(path.getType(node)), 0};
+        checkpointNodes.push_back(record);
+    }
+    
+    lastCheckpointMoves = planStats.moves;
+    return checkpointWriter->write(state, checkpointNodes, getDenseObstacles(), finalX, finalY, error);
+}
+
+// Write a checkpoint if the interval has passed since the last one
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::writeCheckpointIfDue() {
+    if (checkpointWriter == nullptr || checkpointInterval <= 0 ||
+        planStats.moves - lastCheckpointMoves < checkpointInterval) {
+        return;
+    }
+    
+    std::string error;
+    if (!writeCheckpoint(error)) {
+        LOG_SUMMARY("Checkpoint failed: " << error);
+    }
+}
+
+// Restore the newest checkpoint under base_path
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::restoreCheckpoint(const std::string& base_path, std::string& error) {
+    CheckpointData data;
+    if (!readCheckpoint(base_path, data, error)) {
+        return false;
+    }
+    
+    // Check everything before touching the planner, so a bad checkpoint changes nothing
+    const CheckpointState& state = data.state;
+    const char* problem = nullptr;
+    if (data.header.width != mapWidth || data.header.height != mapHeight ||
+        data.header.destX != finalX || data.header.destY != finalY) {
+        problem = "checkpoint is for a different map or destination";
+    } else if (!obstacles.isInBounds(state.currentX, state.currentY) || state.heading < 0 ||
+               state.heading >= 360 || state.heading % 45 != 0) {
+        problem = "bad robot position or heading";
+    } else if (static_cast<long long>(data.path.size()) > path.getCapacity()) {
+        problem = "path does not fit the path capacity";
+    }
+    for (const CheckpointNode& node : data.path) {
+        if (!obstacles.isInBounds(node.x, node.y) || node.type < REGULAR || node.type > OBJECT_DETECTION) {
+            problem = "bad path node";
+        }
+    }
+    if (problem != nullptr) {
+        error = problem;
+        return false;
+    }
+    
+    // Obstacles are only ever added, so the saved grid is folded into the current one
+    OccupancyGrid saved(mapWidth, mapHeight, data.words.data());
+    if (obstacles.isAllocated()) {
+        obstacles.mergeFrom(saved);
+    }
+    if (sparseObstacles) {
+        sparseObstacles->mergeFrom(saved);
+    }
+    mapVersion = state.mapVersion;
+    mapHashValid = false;
+    if (clearance.isBuilt()) {
+        clearance.rebuild(clearancePool);
+    }
+    if (connectivity.isBuilt()) {
+        connectivity.rebuild();
+    }
+    sparseFloodDone = false;
+    incrementalPlanner.reset();
+    anytimeSearch.reset();
+    
+    // Rebuild the path, taking segment headings from the steps between nodes
+    path.clear();
+    segmentPath.clear();
+    Direction heading = NORTH;
+    for (size_t i = 0; i < data.path.size(); i++) {
+        const CheckpointNode& node = data.path[i];
+        if (i > 0 && isDirectionStep(node.x - data.path[i - 1].x, node.y - data.path[i - 1].y)) {
+            heading = getDirectionFromStep(node.x - data.path[i - 1].x, node.y - data.path[i - 1].y);
+        }
+        path.insert(node.x, node.y, static_cast<NodeType>(node.type));
+        segmentPath.append(node.x, node.y, static_cast<NodeType>(node.type), heading);
+    }
+    
+    currentX = state.currentX;
+    currentY = state.currentY;
+    currentDirection = static_cast<Direction>(state.heading);
+    planStats.moves = state.moves;
+    planStats.turns = state.turns;
+    planStats.compactions = state.compactions;
+    planStats.removedNodes = state.removedNodes;
+    planStats.replans = state.replans;
+    planStats.discardedLegs = state.discardedLegs;
+    lastCheckpointMoves = planStats.moves;
+    
+    LOG_SUMMARY("Restored checkpoint " << data.header.sequence << ": (" << currentX << ", " << currentY
+                << ") facing " << getDirectionName(currentDirection) << ", " << data.path.size()
+                << " path nodes, " << planStats.moves << " moves");
+    return true;
+}
+
+// Set the drivetrain velocity used for moves and turns
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setDriveVelocity(double rpm) {
+    driveRpm = rpm;
+}
+
+// Stop planning after a number of moves (0 for no limit)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setStepLimit(int max_steps) {
+    stepLimit = max_steps;
+}
+
+// Stop planning after a number of seconds of wall time (0 for no limit)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setTimeLimit(double seconds) {
+    timeLimit = seconds;
+}
+
+// Get the outcome of the last executePlanningAlgorithm
+template <typename PathList>
+PlanStatus BasicRobotPathPlanner<PathList>::getPlanStatus() const {
+    return planStatus;
+}
+
+// Get the planning counters
+template <typename PathList>
+const PlannerStats& BasicRobotPathPlanner<PathList>::getStats() const {
+    return planStats;
+}
+
+// Check the step and time budgets, recording and reporting the first one to run out
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isBudgetExhausted() {
+    if (stepLimit > 0 && planStats.moves >= stepLimit) {
+        if (!planStats.stepLimitReached) {
+            planStats.stepLimitReached = true;
+            LOG_SUMMARY("Step limit of " << stepLimit << " moves reached before the destination.");
+        }
+        planStatus = PLAN_STEP_LIMIT;
+        return true;
+    }
+    if (timeLimit > 0.0 && secondsSince(runStart) >= timeLimit) {
+        if (!planStats.timeLimitReached) {
+            planStats.timeLimitReached = true;
+            LOG_SUMMARY("Time limit of " << timeLimit << " s reached before the destination.");
+        }
+        planStatus = PLAN_TIME_LIMIT;
+        return true;
+    }
+    return false;
+}
+
+// Check if the destination can still be reached; sets the status and logs the reason if not
+//
+// The connectivity labels are built on the first check and then kept up
+// to date by markObstacle, so every later check is a constant-time lookup.
+// A destination on a side the drivetrain cannot move towards (behind a
+// NORTH/EAST robot, for example) is also ruled out. The robot may stand on
+// an obstacle it has just detected; the labels are only consulted from
+// free cells. Diagonals never cut corners, so the four-connected labels
+// hold for them too. On a large sparse field the tiled map is tried first,
+// so an open field never fills the dense grid just to label it; a field
+// too large to label at all is assumed reachable when that is undecided,
+// leaving the step and time limits to end a hopeless run. The robot only
+// steps between free neighbours, so it never leaves the component the
+// floods judged; their verdict stands until markObstacle changes the map.
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isDestinationReachable() {
+    if (!obstacles.isInBounds(currentX, currentY) || !obstacles.isInBounds(finalX, finalY)) {
+        LOG_SUMMARY("Position (" << currentX << ", " << currentY << ") or destination (" << finalX << ", "
+                    << finalY << ") is outside the " << mapWidth << "x" << mapHeight << " map.");
+        planStatus = PLAN_OUT_OF_BOUNDS;
+        return false;
+    }
+    bool behindX = (finalX > currentX && (allowedMoves & MOVE_POSITIVE_X) == 0) ||
+                   (finalX < currentX && (allowedMoves & MOVE_NEGATIVE_X) == 0);
+    bool behindY = (finalY > currentY && (allowedMoves & MOVE_POSITIVE_Y) == 0) ||
+                   (finalY < currentY && (allowedMoves & MOVE_NEGATIVE_Y) == 0);
+    if (behindX || behindY) {
+        LOG_SUMMARY("Destination (" << finalX << ", " << finalY << ") is behind the robot at ("
+                    << currentX << ", " << currentY << ") and cannot be reached.");
+        planStatus = PLAN_UNREACHABLE;
+        return false;
+    }
+    if (isObstacleDetected(finalX, finalY)) {
+        LOG_SUMMARY("Destination (" << finalX << ", " << finalY << ") is an obstacle.");
+        planStatus = PLAN_UNREACHABLE;
+        return false;
+    }
+    
+    if (!isObstacleDetected(currentX, currentY)) {
+        bool reachable = true;
+        bool largeSparse = sparseObstacles && !obstacles.isAllocated() &&
+                           static_cast<long long>(mapWidth) * mapHeight > kSparseLabelCells;
+        if (largeSparse && !sparseFloodDone && !connectivity.isBuilt()) {
+            sparseFloodDecided = decideSparseReachability(currentX, currentY, finalX, finalY, sparseFloodReachable) ||
+                                 decideSparseReachability(finalX, finalY, currentX, currentY, sparseFloodReachable);
+            sparseFloodDone = true;
+        }
+        bool decided = largeSparse && sparseFloodDone && sparseFloodDecided;
+        reachable = sparseFloodReachable;
+        if (!decided && largeSparse && static_cast<long long>(mapWidth) * mapHeight > kMaxLabelCells) {
+            return true;
+        }
+        if (!decided && !connectivity.isBuilt()) {
+            getDenseObstacles();
+            connectivity.rebuild();
+        }
+        if (decided ? !reachable : !connectivity.isConnected(currentX, currentY, finalX, finalY)) {
+            LOG_SUMMARY("Destination (" << finalX << ", " << finalY << ") is walled off from ("
+                        << currentX << ", " << currentY << ").");
+            planStatus = PLAN_UNREACHABLE;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check for a free L between two cells, row first or column first
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::hasFreeCornerRoute(int fromX, int fromY, int toX, int toY) {
+    int lowX = std::min(fromX, toX);
+    int highX = std::max(fromX, toX);
+    int lowY = std::min(fromY, toY);
+    int highY = std::max(fromY, toY);
+    return (obstacleMap->isRectangleFree(lowX, fromY, highX, fromY) && obstacleMap->isRectangleFree(toX, lowY, toX, highY)) ||
+           (obstacleMap->isRectangleFree(fromX, lowY, fromX, highY) && obstacleMap->isRectangleFree(lowX, toY, highX, toY));
+}
+
+// Decide on the sparse map alone whether one free cell reaches another; returns false if undecided
+//
+// Floods the free cells around the start breadth first, nearest first. A
+// free L from any flooded cell proves a route; a flood that runs out of
+// cells has seen the start's whole component without the goal. A flood
+// still going after kSparseFloodCells is undecided.
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::decideSparseReachability(int fromX, int fromY, int toX, int toY, bool& reachable) {
+    floodQueue.assign(1, GridCell{fromX, fromY});
+    floodSeen.clear();
+    floodSeen.insert((static_cast<uint64_t>(fromY) << 32) | static_cast<uint32_t>(fromX));
+    for (size_t next = 0; next < floodQueue.size(); next++) {
+        if (next >= kSparseFloodCells) {
+            return false;
+        }
+        GridCell cell = floodQueue[next];
+        if (hasFreeCornerRoute(cell.x, cell.y, toX, toY)) {
+            reachable = true;
+            return true;
+        }
+        for (int i = 0; i < kDirectionCount; i += 2) {
+            int x = cell.x + kDirectionDx[i];
+            int y = cell.y + kDirectionDy[i];
+            if (!isObstacleDetected(x, y) &&
+                floodSeen.insert((static_cast<uint64_t>(y) << 32) | static_cast<uint32_t>(x)).second) {
+                floodQueue.push_back(GridCell{x, y});
+            }
+        }
+    }
+    reachable = false;
+    return true;
+}
+
+// Mark the obstacles the sensor thread has queued; returns the number taken
+//
+// At most one queue's worth is taken per step, so a sensor publishing
+// faster than the planner drains cannot hold up the step.
+template <typename PathList>
+int BasicRobotPathPlanner<PathList>::drainSensorQueue() {
+    if (sensorQueue == nullptr) {
+        return 0;
+    }
+    
+    int taken = 0;
+    ObstacleObservation observation;
+    while (taken < static_cast<int>(kSensorQueueCapacity) && sensorQueue->poll(observation)) {
+        markObstacle(observation.x, observation.y);
+        taken++;
+    }
+    INSTRUMENT_ADD(COUNTER_SENSOR_OBSERVATIONS, taken);
+    return taken;
+}
+
+// Queue a telemetry event stamped with the robot clock
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::recordEvent(TelemetryEventType type, int x, int y, int detail, int value) {
+    if (telemetry == nullptr) {
+        return;
+    }
     
-    std::cout << "Regular nodes removed. Current path:" << std::endl;
-    path.print();
+    // The hardware clock is virtual on the simulator, so its stamps are reproducible
+    TelemetryRecord event;
+    event.timeMicros = (hardware != nullptr) ? static_cast<int64_t>(hardware->getTime() * 1e6)
+                                             : telemetry->getElapsedMicros();
+    event.sequence = 0;
+    event.type = static_cast<uint8_t>(type);
+    event.detail = static_cast<uint8_t>(detail);
+    event.heading = static_cast<int16_t>(currentDirection);
+    event.x = x;
+    event.y = y;
+    event.value = value;
+    event.reserved = 0;
+    telemetry->record(event);
+}
+
+// Get the clearance map, building it the first time it is needed
+template <typename PathList>
+const ClearanceMap& BasicRobotPathPlanner<PathList>::getBuiltClearance() {
+    if (!clearance.isBuilt()) {
+        getDenseObstacles();
+        clearance.rebuild(clearancePool);
+    }
+    return clearance;
+}
+
+// Get the dense obstacle grid, filling it from the sparse backend the first time
+template <typename PathList>
+const OccupancyGrid& BasicRobotPathPlanner<PathList>::getDenseObstacles() {
+    if (!obstacles.isAllocated()) {
+        obstacles.allocate();
+        sparseObstacles->copyTo(obstacles);
+        LOG_SUMMARY("Filled the dense " << mapWidth << "x" << mapHeight << " grid from "
+                    << sparseObstacles->getTileCount() << " sparse tiles.");
+    }
+    return obstacles;
+}
+
+// Get the obstacle storage chosen at construction
+template <typename PathList>
+const ObstacleMap& BasicRobotPathPlanner<PathList>::getObstacleMap() const {
+    return *obstacleMap;
+}
+
+// Get the memory held by the obstacle storage in bytes, including a dense grid filled for MAP_SPARSE
+template <typename PathList>
+long long BasicRobotPathPlanner<PathList>::getMapStorageBytes() const {
+    long long bytes = obstacles.getStorageBytes();
+    if (sparseObstacles) {
+        bytes += sparseObstacles->getStorageBytes();
+    }
+    return bytes;
+}
+
+// Build the clearance map on the given thread pool (nullptr for the calling thread)
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::setClearancePool(ThreadPool* pool) {
+    clearancePool = pool;
+}
+
+// Get the obstacle clearance map (built on first use)
+template <typename PathList>
+const ClearanceMap& BasicRobotPathPlanner<PathList>::getClearanceMap() {
+    return getBuiltClearance();
+}
+
+// Get the incremental planner (repair statistics)
+template <typename PathList>
+const DStarLite& BasicRobotPathPlanner<PathList>::getIncrementalPlanner() const {
+    return incrementalPlanner;
+}
+
+// Get the anytime planner (route length, suboptimality bound and rounds)
+template <typename PathList>
+const AnytimeSearch& BasicRobotPathPlanner<PathList>::getAnytimeSearch() const {
+    return anytimeSearch;
 }
 
 // Get the current path
-DoublyLinkedList& RobotPathPlanner::getPath() {
+template <typename PathList>
+PathList& BasicRobotPathPlanner<PathList>::getPath() {
     return path;
 }
 
+// Get the full driven route as run-length segments
+template <typename PathList>
+const SegmentPath& BasicRobotPathPlanner<PathList>::getSegmentPath() const {
+    return segmentPath;
+}
+
+// Get the waypoint route computed by the global planners
+template <typename PathList>
+DoublyLinkedList& BasicRobotPathPlanner<PathList>::getPlannedRoute() {
+    return route;
+}
+
 // Print the current state
-void RobotPathPlanner::printState() {
-    std::cout << "Current position: (" << currentX << ", " << currentY << ")" << std::endl;
-    std::cout << "Current direction: " << (currentDirection == NORTH ? "NORTH" : "EAST") << std::endl;
-    std::cout << "Path size: " << path.getSize() << "/" << path.getCapacity() << std::endl;
+template <typename PathList>
+void BasicRobotPathPlanner<PathList>::printState() {
+    LOG_STEP("Current position: (" << currentX << ", " << currentY << ")\n"
+             << "Current direction: " << getDirectionName(currentDirection) << "\n"
+             << "Path size: " << path.getSize() << "/" << path.getCapacity());
 }
 
 // Check if destination is reached
-bool RobotPathPlanner::isDestinationReached() {
+template <typename PathList>
+bool BasicRobotPathPlanner<PathList>::isDestinationReached() {
     return (currentX == finalX && currentY == finalY);
 }
+
+// Explicit instantiations
+template class BasicRobotPathPlanner<DoublyLinkedList>;
+template class BasicRobotPathPlanner<FixedPathList<kRobotPathCapacity> >;
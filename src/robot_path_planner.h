@@ -1,16 +1,96 @@
 #ifndef ROBOT_PATH_PLANNER_H
 #define ROBOT_PATH_PLANNER_H
 
+#include "anytime_search.h"
+#include "checkpoint.h"
+#include "clearance_map.h"
+#include "connectivity_index.h"
+#include "direction.h"
 #include "doubly_linked_list.h"
+#include "dstar_lite.h"
+#include "fixed_path_list.h"
+#include "grid_search.h"
+#include "instrumentation.h"
+#include "map_file.h"
+#include "obstacle_sensor_queue.h"
+#include "occupancy_grid.h"
+#include "path_cache.h"
+#include "plan_pipeline.h"
+#include "robot_hardware.h"
+#include "segment_path.h"
+#include "sparse_obstacle_map.h"
+#include "telemetry.h"
+#include "turn_aware_search.h"
+#include <chrono>
+#include <memory>
+#include <unordered_set>
 
-// Direction enumeration
-enum Direction {
-    NORTH = 180,  // 180 degrees (positive y direction)
-    EAST = 270    // 270 degrees (positive x direction)
+// Planner mode enumeration
+enum PlannerMode {
+    GREEDY_PLANNER,         // Step-by-step walker towards the destination
+    ASTAR_PLANNER,          // Global A* route over the obstacle map
+    JUMP_POINT_PLANNER,     // Global Jump Point Search route over the obstacle map
+    INCREMENTAL_PLANNER,    // D* Lite route repaired as obstacles are discovered
+    TURN_AWARE_PLANNER,     // Minimum-time route weighing turns against moves
+    ANYTIME_PLANNER         // ARA* route refined within a search budget per cell driven
 };
 
-class RobotPathPlanner {
+// Execution mode enumeration
+enum ExecutionMode {
+    EXECUTION_SEQUENTIAL,   // Plan, then drive, on the calling thread
+    EXECUTION_PIPELINED     // A worker plans the next legs while the caller drives
+};
+
+// Outcome of executePlanningAlgorithm
+enum PlanStatus {
+    PLAN_SUCCESS,           // Destination reached
+    PLAN_UNREACHABLE,       // No route to the destination is left
+    PLAN_OUT_OF_BOUNDS,     // The start, destination or robot is outside the map
+    PLAN_STEP_LIMIT,        // Step budget used up first
+    PLAN_TIME_LIMIT         // Time budget used up first
+};
+
+// Get the printable name of a plan status
+inline const char* getPlanStatusName(PlanStatus status) {
+    switch (status) {
+        case PLAN_SUCCESS:
+            return "success";
+        case PLAN_UNREACHABLE:
+            return "unreachable";
+        case PLAN_OUT_OF_BOUNDS:
+            return "out of bounds";
+        case PLAN_STEP_LIMIT:
+            return "step limit";
+        case PLAN_TIME_LIMIT:
+            return "time limit";
+    }
+    return "unknown";
+}
+
+// Counters collected while planning
+struct PlannerStats {
+    int moves;              // Cells driven
+    int turns;              // Heading changes
+    int compactions;        // Capacity and turning triggers that ran
+    int removedNodes;       // Nodes removed by those triggers
+    bool stepLimitReached;  // Planning stopped at the step limit
+    bool timeLimitReached;  // Planning stopped at the time limit
+    double idleSeconds;     // Wall time the drivetrain waited for a route
+    int replans;            // Routes recomputed after new obstacles
+    int discardedLegs;      // Pipelined legs dropped because their route was stale
+};
+
+// Robot path planner
+//
+// PathList is the container recording the compacted path. It must provide
+// the DoublyLinkedList interface used here (insert, the compaction triggers,
+// findLatestNecessaryNode, getTail, print) together with a NodeHandle type
+// and its kNullHandle value.
+template <typename PathList>
+class BasicRobotPathPlanner {
 private:
+    typedef typename PathList::NodeHandle NodeHandle;
+    
     // Robot position and orientation
     int currentX;
     int currentY;
@@ -23,40 +103,262 @@ private:
     // Map dimensions and obstacles
     const int mapWidth;
     const int mapHeight;
-    bool** obstacles;  // 2D array to track obstacles
+    OccupancyGrid obstacles;  // Bit-packed grid to track obstacles (filled on first use with MAP_SPARSE)
+    std::unique_ptr<SparseObstacleMap> sparseObstacles;  // Tiled map of MAP_SPARSE (nullptr for MAP_DENSE)
+    ObstacleMap* obstacleMap;  // Backend answering the planner's own obstacle checks
+    ClearanceMap clearance;   // Distance from each cell to the nearest obstacle (steers obstacle avoidance)
+    ThreadPool* clearancePool;  // Pool the clearance map is built on (nullptr for the calling thread)
+    ConnectivityIndex connectivity;  // Component labels of the free cells (built on first check)
+    
+    // Sparse flood verdict on the current map (cleared by markObstacle) and the flood's scratch space
+    bool sparseFloodDone;       // The floods ran since the last map change
+    bool sparseFloodDecided;    // They settled reachability one way or the other
+    bool sparseFloodReachable;
+    std::vector<GridCell> floodQueue;
+    std::unordered_set<uint64_t> floodSeen;
     
     // Path data structure
-    DoublyLinkedList path;
+    PathList path;
+    
+    // Full driven route as run-length segments (never compacted)
+    SegmentPath segmentPath;
+    
+    // Planning and execution modes and the waypoint route of the global planners
+    PlannerMode plannerMode;
+    ExecutionMode executionMode;
+    DoublyLinkedList route;
+    TurnCostModel turnCostModel;    // Costs weighed by TURN_AWARE_PLANNER
+    int allowedMoves;               // MoveSet flags the drivetrain may use
+    
+    // Incremental planner state, kept across markObstacle calls
+    DStarLite incrementalPlanner;
+    
+    // Anytime planner state and the search seconds it gets per cell driven
+    AnytimeSearch anytimeSearch;
+    double planningBudget;
+    
+    // Hardware driven by turn, move and calibrateInertial (nullptr to only plan)
+    RobotHardware* hardware;
+    double driveRpm;
+    
+    // Binary event stream (nullptr for none)
+    TelemetryWriter* telemetry;
+    
+    // Observations from the sensor thread, drained at the start of each step (nullptr for none)
+    ObstacleSensorQueue* sensorQueue;
+    
+    // Routes shared between missions (nullptr for none) and the map identity used as its key
+    PathCache* pathCache;
+    unsigned long long mapVersion;  // Bumped by every markObstacle that changes the map
+    uint64_t mapHash;               // Content hash, valid only when mapHashValid is set
+    bool mapHashValid;
+    
+    // Checkpoints written every checkpointInterval moves (nullptr for none)
+    CheckpointWriter* checkpointWriter;
+    int checkpointInterval;
+    int lastCheckpointMoves;
+    std::vector<CheckpointNode> checkpointNodes;
+    
+    // Obstacles marked since the last pipelined plan request (collected only while pipelining)
+    bool collectNewObstacles;
+    std::vector<GridCell> newObstacles;
+    
+    // Step and wall-time budgets (0 for none), outcome and planning counters
+    int stepLimit;
+    double timeLimit;
+    std::chrono::steady_clock::time_point runStart;
+    PlanStatus planStatus;
+    PlannerStats planStats;
+    
+    // Instrumentation of the last executePlanningAlgorithm and where to dump it
+    InstrumentSnapshot runInstrumentation;
+    std::ostream* instrumentationOutput;
     
     // Helper functions
     bool isObstacleDetected(int x, int y);
     Direction determineMovementPriority();
+    Direction getAvoidanceDirection(int& detour_length);
+    bool isDeadEnd(int x, int y, Direction arrival);
+    int getSafeDetourLength(Direction direction, int max_cells, bool away);
+    int getClearanceSquared(int x, int y);
     void turn(Direction newDirection);
     void move();
     void updatePath(NodeType nodeType);
+    NodeHandle getLatestNecessaryNode();
     void handleCapacityTrigger();
-    void handleTurningTrigger(Node* currentNode, Node* previousNode);
+    void handleTurningTrigger(NodeHandle currentNode, NodeHandle previousNode);
+    void executeGreedyPlan();
+    void executeSearchPlan();
+    bool planGlobalRoute(GridSearch& search, TurnAwareSearch& turnSearch);
+    bool isRouteBlocked(const Node* waypoint);
+    void executeIncrementalPlan();
+    void executeAnytimePlan();
+    void executePipelinedPlan();
+    void driveStep(Direction direction);
+    bool isBudgetExhausted();
+    bool isDestinationReachable();
+    bool hasFreeCornerRoute(int fromX, int fromY, int toX, int toY);
+    bool decideSparseReachability(int fromX, int fromY, int toX, int toY, bool& reachable);
+    int drainSensorQueue();
+    void recordEvent(TelemetryEventType type, int x, int y, int detail, int value);
+    const ClearanceMap& getBuiltClearance();
+    const OccupancyGrid& getDenseObstacles();
+    void writeCheckpointIfDue();
+    
+    // Constructor over existing obstacle storage (nullptr to allocate it) or a sparse backend
+    BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height,
+                          uint64_t* obstacle_words, MapBackend backend);
     
 public:
     // Mark an obstacle at the specified position
     void markObstacle(int x, int y);
     // Constructor
-    RobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height);
+    BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height);
+    
+    // Constructor choosing the obstacle storage
+    //
+    // MAP_SPARSE suits large, mostly empty fields: construction allocates no
+    // cells and the greedy walker runs on the tiled map alone. The global
+    // planners and the clearance and connectivity maps need per-cell data,
+    // so their first use fills a dense grid that is then kept in step.
+    BasicRobotPathPlanner(int startX, int startY, int destX, int destY, int width, int height, MapBackend backend);
+    
+    // Constructor using a mapped map file as the obstacle grid, without copying it
+    //
+    // Start, destination and size come from the file header. The file must
+    // stay open for the lifetime of the planner.
+    explicit BasicRobotPathPlanner(const MappedMapFile& map_file);
     
     // Destructor
-    ~RobotPathPlanner();
+    ~BasicRobotPathPlanner();
     
     // Initialize the robot
     void initialize();
     
     // Execute the path planning algorithm
-    void executePlanningAlgorithm();
+    //
+    // Returns as soon as the destination is reached, is found to be
+    // unreachable or a budget runs out; the status says which.
+    PlanStatus executePlanningAlgorithm();
+    
+    // Continue a mission restored by restoreCheckpoint instead of calling initialize
+    //
+    // The restored path already holds its start node. The IMU is calibrated
+    // again only when asked, which leaves the robot facing NORTH.
+    void resume(bool recalibrate = false);
     
     // Calibrate the inertial measurement unit (IMU)
     void calibrateInertial();
     
+    // Set the planning mode used by executePlanningAlgorithm
+    void setPlannerMode(PlannerMode mode);
+    
+    // Set how executePlanningAlgorithm overlaps planning with driving
+    //
+    // The greedy, turn-aware and anytime planners always run sequentially.
+    void setExecutionMode(ExecutionMode mode);
+    
+    // Set the move and turn times weighed by TURN_AWARE_PLANNER
+    void setTurnCostModel(const TurnCostModel& model);
+    
+    // Set the search seconds ANYTIME_PLANNER spends before each cell it drives
+    //
+    // The robot drives along the best route found within the budget while
+    // later cycles keep shortening it; 0 searches to the optimum every cycle.
+    void setPlanningBudget(double seconds);
+    
+    // Set the MoveSet flags the drivetrain may use (MOVES_NORTH_EAST by default)
+    //
+    // The global planners search the allowed axis moves; MOVE_DIAGONALS is
+    // only taken by the greedy walker.
+    void setAllowedMoves(int allowed_moves);
+    
     // Get the current path
-    DoublyLinkedList& getPath();
+    PathList& getPath();
+    
+    // Get the full driven route as run-length segments
+    const SegmentPath& getSegmentPath() const;
+    
+    // Get the waypoint route computed by the global planners
+    DoublyLinkedList& getPlannedRoute();
+    
+    // Get the obstacle storage chosen at construction
+    const ObstacleMap& getObstacleMap() const;
+    
+    // Get the memory held by the obstacle storage in bytes, including a dense grid filled for MAP_SPARSE
+    long long getMapStorageBytes() const;
+    
+    // Build the clearance map on the given thread pool (nullptr for the calling thread)
+    //
+    // The map is built on the first obstacle avoidance and again after a
+    // checkpoint restore; the pool must be idle then, as the build waits for it.
+    void setClearancePool(ThreadPool* pool);
+    
+    // Get the obstacle clearance map (built on first use)
+    const ClearanceMap& getClearanceMap();
+    
+    // Get the incremental planner (repair statistics)
+    const DStarLite& getIncrementalPlanner() const;
+    
+    // Get the anytime planner (route length, suboptimality bound and rounds)
+    const AnytimeSearch& getAnytimeSearch() const;
+    
+    // Drive the given hardware while planning (nullptr to only plan)
+    void setHardware(RobotHardware* robot_hardware);
+    
+    // Take obstacle observations from a sensor thread through the given queue (nullptr for none)
+    void setSensorQueue(ObstacleSensorQueue* queue);
+    
+    // Record path events to the given telemetry stream (nullptr for none)
+    void setTelemetry(TelemetryWriter* writer);
+    
+    // Reuse global routes through the given cache (nullptr for none)
+    //
+    // A* and JPS consult the cache when run sequentially, and the turn-aware
+    // planner always does; turn-aware entries are also keyed by the heading
+    // and the turn and move costs. The greedy walker, D* Lite, the anytime
+    // planner and pipelined A* and JPS plan against the live map instead.
+    void setPathCache(PathCache* cache);
+    
+    // Get the number of markObstacle calls that changed the map
+    unsigned long long getMapVersion() const;
+    
+    // Get the content hash of the obstacles (computed on first use, then kept up to date)
+    uint64_t getMapHash();
+    
+    // Write checkpoints through the given writer every few moves (nullptr for none)
+    void setCheckpointWriter(CheckpointWriter* writer, int every_moves);
+    
+    // Write a checkpoint now through the writer set by setCheckpointWriter
+    bool writeCheckpoint(std::string& error);
+    
+    // Restore the newest checkpoint under base_path
+    //
+    // The checkpoint must be for this map size and destination. Its obstacles
+    // are added to the grid and the path, position, heading and counters are
+    // replaced. Derived maps are rebuilt on their next use.
+    bool restoreCheckpoint(const std::string& base_path, std::string& error);
+    
+    // Set the drivetrain velocity used for moves and turns
+    void setDriveVelocity(double rpm);
+    
+    // Stop planning after a number of moves (0 for no limit)
+    void setStepLimit(int max_steps);
+    
+    // Stop planning after a number of seconds of wall time (0 for no limit)
+    void setTimeLimit(double seconds);
+    
+    // Get the outcome of the last executePlanningAlgorithm
+    PlanStatus getPlanStatus() const;
+    
+    // Get the planning counters
+    const PlannerStats& getStats() const;
+    
+    // Get the instrumentation counters and timers of the last executePlanningAlgorithm
+    const InstrumentSnapshot& getInstrumentation() const;
+    
+    // Write the instrumentation as JSON after each executePlanningAlgorithm (nullptr for none)
+    void setInstrumentationOutput(std::ostream* output);
     
     // Print the current state
     void printState();
@@ -65,4 +367,17 @@ public:
     bool isDestinationReached();
 };
 
+// Path capacity used on the robot
+const int kRobotPathCapacity = 10;
+
+// Planner over the pointer-based list (capacity chosen at run time)
+typedef BasicRobotPathPlanner<DoublyLinkedList> RobotPathPlanner;
+
+// Planner over the inline fixed-capacity list
+typedef BasicRobotPathPlanner<FixedPathList<kRobotPathCapacity> > FixedRobotPathPlanner;
+
+// Both planners are compiled once in robot_path_planner.cpp
+extern template class BasicRobotPathPlanner<DoublyLinkedList>;
+extern template class BasicRobotPathPlanner<FixedPathList<kRobotPathCapacity> >;
+
 #endif // ROBOT_PATH_PLANNER_H
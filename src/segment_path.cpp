@@ -0,0 +1,120 @@
+#include "segment_path.h"
+
+// Constructor
+SegmentPath::SegmentPath() : nodeCount(0) {}
+
+// Get the cell after the last node of the path
+bool SegmentPath::nextCell(Direction heading, int& x, int& y) const {
+    if (segments.empty()) {
+        return false;
+    }
+
+    const PathSegment& last = segments.back();
+    int dx = 0;
+    int dy = 0;
+    getDirectionStep(heading, dx, dy);
+    x = last.x + dx * (last.length + 1);
+    y = last.y + dy * (last.length + 1);
+    return true;
+}
+
+// Append a node reached while facing heading
+void SegmentPath::append(int x, int y, NodeType type, Direction heading) {
+    nodeCount++;
+
+    // A REGULAR step straight on from the last node extends the last record
+    if (type == REGULAR && !segments.empty()) {
+        PathSegment& last = segments.back();
+        if (last.length == 0 || last.heading == heading) {
+            int nextX = 0;
+            int nextY = 0;
+            nextCell(heading, nextX, nextY);
+            if (nextX == x && nextY == y) {
+                last.heading = heading;
+                last.length++;
+                return;
+            }
+        }
+    }
+
+    PathSegment segment = {x, y, heading, 0, type};
+    segments.push_back(segment);
+}
+
+// Remove all records
+void SegmentPath::clear() {
+    segments.clear();
+    nodeCount = 0;
+}
+
+// Reserve room for a number of records
+void SegmentPath::reserve(int segment_count) {
+    segments.reserve(segment_count);
+}
+
+// Rebuild the records from a node list
+void SegmentPath::fromList(const DoublyLinkedList& list, Direction initialHeading) {
+    clear();
+    Direction heading = initialHeading;
+
+    for (Node* node = list.getHead(); node != nullptr; node = node->next) {
+        // Take the heading from the step between consecutive nodes when it is one cell
+        Node* previous = node->prev;
+        if (previous != nullptr) {
+            int dx = node->x - previous->x;
+            int dy = node->y - previous->y;
+            if (isDirectionStep(dx, dy)) {
+                heading = getDirectionFromStep(dx, dy);
+            }
+        }
+
+        append(node->x, node->y, node->type, heading);
+    }
+}
+
+// Expand the records into a node list (false if it does not fit)
+bool SegmentPath::toList(DoublyLinkedList& out) const {
+    out.clear();
+
+    for (const PathSegment& segment : segments) {
+        if (!out.insert(segment.x, segment.y, segment.type)) {
+            return false;
+        }
+
+        int dx = 0;
+        int dy = 0;
+        getDirectionStep(segment.heading, dx, dy);
+        for (int i = 1; i <= segment.length; i++) {
+            if (!out.insert(segment.x + dx * i, segment.y + dy * i, REGULAR)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Get the records
+const std::vector<PathSegment>& SegmentPath::getSegments() const {
+    return segments;
+}
+
+// Get the number of records
+int SegmentPath::getSegmentCount() const {
+    return static_cast<int>(segments.size());
+}
+
+// Get the number of nodes represented
+long long SegmentPath::getNodeCount() const {
+    return nodeCount;
+}
+
+// Get the memory used by the records in bytes
+long long SegmentPath::getMemoryBytes() const {
+    return static_cast<long long>(segments.capacity()) * static_cast<long long>(sizeof(PathSegment));
+}
+
+// Check if the path is empty
+bool SegmentPath::isEmpty() const {
+    return segments.empty();
+}
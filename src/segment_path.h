@@ -0,0 +1,68 @@
+#ifndef SEGMENT_PATH_H
+#define SEGMENT_PATH_H
+
+#include "direction.h"
+#include "doubly_linked_list.h"
+#include <vector>
+
+// One straight run of the path
+//
+// The record stands for its start node followed by length REGULAR cells,
+// each one step further along heading.
+struct PathSegment {
+    int x;              // X coordinate of the start node (East)
+    int y;              // Y coordinate of the start node (North)
+    Direction heading;  // Direction of the run
+    int length;         // Number of REGULAR cells after the start node
+    NodeType type;      // Type of the start node
+};
+
+// Run-length encoded path
+//
+// Straight runs of REGULAR cells extend the last record in place, so a
+// straight drive of any length costs one record. Conversion to and from
+// DoublyLinkedList is lossless.
+class SegmentPath {
+private:
+    std::vector<PathSegment> segments;  // Records in path order
+    long long nodeCount;                // Nodes represented by all records
+
+    // Get the cell after the last node of the path
+    bool nextCell(Direction heading, int& x, int& y) const;
+
+public:
+    // Constructor
+    SegmentPath();
+
+    // Append a node reached while facing heading
+    void append(int x, int y, NodeType type, Direction heading);
+
+    // Remove all records
+    void clear();
+
+    // Reserve room for a number of records
+    void reserve(int segment_count);
+
+    // Rebuild the records from a node list
+    void fromList(const DoublyLinkedList& list, Direction initialHeading = NORTH);
+
+    // Expand the records into a node list (false if it does not fit)
+    bool toList(DoublyLinkedList& out) const;
+
+    // Get the records
+    const std::vector<PathSegment>& getSegments() const;
+
+    // Get the number of records
+    int getSegmentCount() const;
+
+    // Get the number of nodes represented
+    long long getNodeCount() const;
+
+    // Get the memory used by the records in bytes
+    long long getMemoryBytes() const;
+
+    // Check if the path is empty
+    bool isEmpty() const;
+};
+
+#endif // SEGMENT_PATH_H
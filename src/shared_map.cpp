@@ -0,0 +1,115 @@
+#include "shared_map.h"
+
+// Constructor (an empty field; SharedMap::buildDistanceField fills it)
+DistanceField::DistanceField() : destX(0), destY(0), width(0) {}
+
+// Get the steps from (x, y) to the destination (kUnreachable if none)
+int DistanceField::getDistance(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width) {
+        return kUnreachable;
+    }
+    size_t cell = static_cast<size_t>(y) * width + x;
+    return (cell < steps.size()) ? steps[cell] : kUnreachable;
+}
+
+// Get the destination X coordinate
+int DistanceField::getDestX() const {
+    return destX;
+}
+
+// Get the destination Y coordinate
+int DistanceField::getDestY() const {
+    return destY;
+}
+
+// Get the memory used by the field in bytes
+long long DistanceField::getMemoryBytes() const {
+    return static_cast<long long>(steps.capacity()) * static_cast<long long>(sizeof(int));
+}
+
+// Constructor (copies the obstacles and runs the preprocessing)
+SharedMap::SharedMap(const OccupancyGrid& source, int allowed_moves) :
+    grid(source), allowedMoves(allowed_moves), connectivity(grid) {}
+
+// Get the obstacles
+const OccupancyGrid& SharedMap::getGrid() const {
+    return grid;
+}
+
+// Get the allowed moves
+int SharedMap::getAllowedMoves() const {
+    return allowedMoves;
+}
+
+// Get the component label of (x, y) (-1 on obstacles and outside the map)
+int SharedMap::getComponent(int x, int y) const {
+    return connectivity.getComponent(x, y);
+}
+
+// Get the number of components
+int SharedMap::getComponentCount() const {
+    return connectivity.getComponentCount();
+}
+
+// Check if a route from start to destination can exist (false means it cannot)
+bool SharedMap::mayConnect(int startX, int startY, int destX, int destY) const {
+    if (!connectivity.isConnected(startX, startY, destX, destY)) {
+        return false;
+    }
+
+    // A drivetrain without reverse moves cannot get back to a lower coordinate
+    if ((destX > startX && !(allowedMoves & MOVE_POSITIVE_X)) ||
+        (destX < startX && !(allowedMoves & MOVE_NEGATIVE_X)) ||
+        (destY > startY && !(allowedMoves & MOVE_POSITIVE_Y)) ||
+        (destY < startY && !(allowedMoves & MOVE_NEGATIVE_Y))) {
+        return false;
+    }
+
+    return true;
+}
+
+// Build the distance field of a destination
+void SharedMap::buildDistanceField(int destX, int destY, DistanceField& field) const {
+    int width = grid.getWidth();
+    field.destX = destX;
+    field.destY = destY;
+    field.width = width;
+    field.steps.assign(static_cast<size_t>(width) * grid.getHeight(), DistanceField::kUnreachable);
+    if (grid.isObstacleDetected(destX, destY)) {
+        return;
+    }
+
+    // Breadth-first search backwards: a cell reaches "cell" by stepping along a move
+    std::vector<int> frontier;
+    frontier.reserve(static_cast<size_t>(width) * 4);
+    int dest = destY * width + destX;
+    field.steps[dest] = 0;
+    frontier.push_back(dest);
+
+    for (size_t head = 0; head < frontier.size(); head++) {
+        int cell = frontier[head];
+        int cellX = cell % width;
+        int cellY = cell / width;
+        int nextSteps = field.steps[cell] + 1;
+        for (int i = 0; i < kAxisMoveCount; i++) {
+            if (!(allowedMoves & kAxisMoves[i].flag)) {
+                continue;
+            }
+            int fromX = cellX - kAxisMoves[i].dx;
+            int fromY = cellY - kAxisMoves[i].dy;
+            if (grid.isObstacleDetected(fromX, fromY)) {
+                continue;
+            }
+            int from = fromY * width + fromX;
+            if (field.steps[from] == DistanceField::kUnreachable) {
+                field.steps[from] = nextSteps;
+                frontier.push_back(from);
+            }
+        }
+    }
+}
+
+// Get the memory used by the obstacles and labels in bytes
+long long SharedMap::getMemoryBytes() const {
+    return grid.getStorageBytes() + connectivity.getMemoryBytes();
+}
@@ -0,0 +1,81 @@
+#ifndef SHARED_MAP_H
+#define SHARED_MAP_H
+
+#include "connectivity_index.h"
+#include "grid_search.h"
+#include "occupancy_grid.h"
+#include <vector>
+
+// Step counts from every cell to one destination
+//
+// Built by a reverse breadth-first search over the allowed moves, so a
+// lookup answers "how many steps from here" for any start in O(1).
+class DistanceField {
+private:
+    int destX;                  // Destination the field was built for
+    int destY;
+    int width;                  // Width of the map (row stride of steps)
+    std::vector<int> steps;     // Steps to the destination, kUnreachable if none
+
+public:
+    static constexpr int kUnreachable = -1;
+
+    // Constructor (an empty field; SharedMap::buildDistanceField fills it)
+    DistanceField();
+
+    // Get the steps from (x, y) to the destination (kUnreachable if none)
+    int getDistance(int x, int y) const;
+
+    // Get the destination X coordinate
+    int getDestX() const;
+
+    // Get the destination Y coordinate
+    int getDestY() const;
+
+    // Get the memory used by the field in bytes
+    long long getMemoryBytes() const;
+
+    friend class SharedMap;
+};
+
+// Immutable, preprocessed map shared by many query contexts
+//
+// Holds one copy of the obstacles together with connected-component
+// labels, so any number of threads can read it without locking. Queries
+// between cells of different components are rejected without a search.
+class SharedMap {
+private:
+    OccupancyGrid grid;                 // Obstacles (never modified after construction)
+    int allowedMoves;                   // MoveSet flags usable by the robot
+    ConnectivityIndex connectivity;     // Component labels of grid
+
+public:
+    // Constructor (copies the obstacles and runs the preprocessing)
+    SharedMap(const OccupancyGrid& source, int allowed_moves = MOVES_ALL);
+
+    // Get the obstacles
+    const OccupancyGrid& getGrid() const;
+
+    // Get the allowed moves
+    int getAllowedMoves() const;
+
+    // Get the component label of (x, y) (-1 on obstacles and outside the map)
+    int getComponent(int x, int y) const;
+
+    // Get the number of components
+    int getComponentCount() const;
+
+    // Check if a route from start to destination can exist (false means it cannot)
+    bool mayConnect(int startX, int startY, int destX, int destY) const;
+
+    // Build the distance field of a destination
+    void buildDistanceField(int destX, int destY, DistanceField& field) const;
+
+    // Get the memory used by the obstacles and labels in bytes
+    long long getMemoryBytes() const;
+
+    SharedMap(const SharedMap&) = delete;
+    SharedMap& operator=(const SharedMap&) = delete;
+};
+
+#endif // SHARED_MAP_H
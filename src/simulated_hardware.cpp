@@ -0,0 +1,215 @@
+#include "simulated_hardware.h"
+#include "logger.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+const double kPi = 3.14159265358979323846;
+}
+
+// Default robot: 4 inch wheels, 29 cm track, 10 ms sensor loop
+SimulationConfig getDefaultSimulationConfig() {
+    SimulationConfig config;
+    config.wheelDiameterCm = 10.16;
+    config.trackWidthCm = 29.0;
+    config.rampSeconds = 0.15;
+    config.calibrationSeconds = 2.0;
+    config.imuDriftDegPerSecond = 0.005;
+    config.uncalibratedDriftFactor = 20.0;
+    config.settleSeconds = 0.12;
+    config.overshootSeconds = 0.25;
+    config.sensorLatencySeconds = 0.02;
+    config.pollSeconds = 0.01;
+    config.realTimeScale = 0.0;
+    return config;
+}
+
+// Constructor
+SimulatedHardware::SimulatedHardware(const SimulationConfig& simulation_config) :
+    config(simulation_config), clock(0.0), nextSequence(0), velocityRpm(0.0),
+    calibrating(false), calibrated(false), calibrationTime(0.0), headingOffset(0.0),
+    lastStopTime(0.0), lastStopRate(0.0), distanceCm(0.0), sensorReads(0) {
+
+    HeadingSegment initial = {0.0, 0.0, 0.0};
+    trajectory.push_back(initial);
+}
+
+// Queue an event at an absolute time
+void SimulatedHardware::schedule(double time, EventType type) {
+    Event event = {time, nextSequence++, type};
+    events.push(event);
+}
+
+// Move the clock forward, applying every event due on the way
+void SimulatedHardware::advanceTo(double time) {
+    // Optionally take (scaled) real time, so other threads can work while the robot moves
+    if (config.realTimeScale > 0.0 && time > clock) {
+        std::this_thread::sleep_for(std::chrono::duration<double>((time - clock) * config.realTimeScale));
+    }
+
+    while (!events.empty() && events.top().time <= time) {
+        Event event = events.top();
+        events.pop();
+        if (event.time > clock) {
+            clock = event.time;
+        }
+        apply(event);
+    }
+    if (time > clock) {
+        clock = time;
+    }
+
+    // Drop heading segments no read can reach any more
+    double oldest = clock - config.sensorLatencySeconds;
+    while (trajectory.size() > 1 && trajectory[1].start <= oldest) {
+        trajectory.erase(trajectory.begin());
+    }
+}
+
+// Apply one event
+void SimulatedHardware::apply(const Event& event) {
+    switch (event.type) {
+        case EVENT_CALIBRATION_DONE:
+            // The IMU zeroes its heading where the robot stands
+            calibrating = false;
+            calibrated = true;
+            calibrationTime = clock;
+            headingOffset = getTrueHeading(clock);
+            LOG_TRACE("[sim " << clock << " s] IMU calibration done");
+            break;
+        case EVENT_MOTION_DONE:
+            stop();
+            break;
+    }
+}
+
+// Start a new heading segment at the current time
+void SimulatedHardware::setTurnRate(double rate) {
+    HeadingSegment segment = {clock, getTrueHeading(clock), rate};
+    trajectory.push_back(segment);
+}
+
+// Get the true heading at a time (not before the last retained segment)
+double SimulatedHardware::getTrueHeading(double time) const {
+    size_t index = trajectory.size() - 1;
+    while (index > 0 && trajectory[index].start > time) {
+        index--;
+    }
+    const HeadingSegment& segment = trajectory[index];
+    double elapsed = time - segment.start;
+    if (elapsed < 0.0) {
+        elapsed = 0.0;
+    }
+    double heading = segment.heading + segment.rate * elapsed;
+
+    // After a stop the robot keeps sliding and settles past the stop heading
+    if (index == trajectory.size() - 1 && segment.rate == 0.0 && lastStopRate != 0.0) {
+        double overshoot = lastStopRate * config.overshootSeconds;
+        heading += overshoot * (1.0 - std::exp(-elapsed / config.settleSeconds));
+    }
+    return heading;
+}
+
+// Get the wheel surface speed in centimeters per second
+double SimulatedHardware::getWheelSpeed() const {
+    return velocityRpm / 60.0 * kPi * config.wheelDiameterCm;
+}
+
+// Get the time since start-up in seconds
+double SimulatedHardware::getTime() const {
+    return clock;
+}
+
+// Sleep for a number of seconds
+void SimulatedHardware::wait(double seconds) {
+    if (seconds > 0.0) {
+        advanceTo(clock + seconds);
+    }
+}
+
+// Set the drivetrain motor velocity in RPM
+void SimulatedHardware::setVelocity(double rpm) {
+    velocityRpm = rpm;
+    LOG_TRACE("[sim " << clock << " s] velocity set to " << rpm << " rpm");
+}
+
+// Drive straight ahead for a distance in centimeters (blocking)
+void SimulatedHardware::driveForward(double centimeters) {
+    double speed = getWheelSpeed();
+    if (speed <= 0.0 || centimeters <= 0.0) {
+        return;
+    }
+    advanceTo(clock + config.rampSeconds + centimeters / speed);
+    distanceCm += centimeters;
+}
+
+// Turn in place by a number of degrees, positive to the right (blocking)
+void SimulatedHardware::turnBy(double degrees) {
+    double rate = getWheelSpeed() * 2.0 / config.trackWidthCm * 180.0 / kPi;
+    if (rate <= 0.0 || degrees == 0.0) {
+        return;
+    }
+
+    // Half the ramp to spin up, the turn itself, then the brake
+    advanceTo(clock + config.rampSeconds / 2.0);
+    setTurnRate(degrees > 0.0 ? rate : -rate);
+    schedule(clock + std::fabs(degrees) / rate, EVENT_MOTION_DONE);
+    advanceTo(clock + std::fabs(degrees) / rate);
+    advanceTo(clock + config.rampSeconds / 2.0);
+}
+
+// Start turning right until stop is called
+void SimulatedHardware::startTurnRight() {
+    setTurnRate(getWheelSpeed() * 2.0 / config.trackWidthCm * 180.0 / kPi);
+}
+
+// Stop the drivetrain (brake)
+void SimulatedHardware::stop() {
+    double rate = trajectory.back().rate;
+    if (rate == 0.0) {
+        return;
+    }
+    setTurnRate(0.0);
+    lastStopTime = clock;
+    lastStopRate = rate;
+}
+
+// Start calibrating the inertial sensor
+void SimulatedHardware::calibrateImu() {
+    calibrating = true;
+    schedule(clock + config.calibrationSeconds, EVENT_CALIBRATION_DONE);
+}
+
+// Check if the inertial sensor is still calibrating
+bool SimulatedHardware::isImuCalibrating() {
+    advanceTo(clock + config.pollSeconds);
+    sensorReads++;
+    return calibrating;
+}
+
+// Read the inertial sensor heading in degrees
+double SimulatedHardware::getHeading() {
+    advanceTo(clock + config.pollSeconds);
+    sensorReads++;
+
+    // The reading describes the robot one latency period ago
+    double sampleTime = clock - config.sensorLatencySeconds;
+    double drift = config.imuDriftDegPerSecond * (sampleTime - calibrationTime);
+    if (!calibrated) {
+        drift *= config.uncalibratedDriftFactor;
+    }
+
+    double heading = std::fmod(getTrueHeading(sampleTime) - headingOffset + drift, 360.0);
+    return (heading < 0.0) ? heading + 360.0 : heading;
+}
+
+// Get the total distance driven in centimeters
+double SimulatedHardware::getDistanceDriven() const {
+    return distanceCm;
+}
+
+// Get the number of sensor reads
+long long SimulatedHardware::getSensorReads() const {
+    return sensorReads;
+}
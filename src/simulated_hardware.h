@@ -0,0 +1,118 @@
+#ifndef SIMULATED_HARDWARE_H
+#define SIMULATED_HARDWARE_H
+
+#include "robot_hardware.h"
+#include <queue>
+#include <vector>
+
+// Physical parameters of the simulated robot
+struct SimulationConfig {
+    double wheelDiameterCm;         // Drive wheel diameter
+    double trackWidthCm;            // Distance between the left and right wheels
+    double rampSeconds;             // Extra time to accelerate and brake per motion
+    double calibrationSeconds;      // IMU calibration duration
+    double imuDriftDegPerSecond;    // Heading drift of a calibrated IMU
+    double uncalibratedDriftFactor; // Drift multiplier before calibration finishes
+    double settleSeconds;           // Time constant of the heading wobble after a stop
+    double overshootSeconds;        // Heading overshoot after a stop, in seconds of turning
+    double sensorLatencySeconds;    // Age of the heading returned by a read
+    double pollSeconds;             // Loop period charged to every sensor read
+    double realTimeScale;           // Wall seconds slept per simulated second (0 to never sleep)
+};
+
+// Default robot: 4 inch wheels, 29 cm track, 10 ms sensor loop
+SimulationConfig getDefaultSimulationConfig();
+
+// Discrete-event simulator of the lab robot
+//
+// Time is virtual: blocking motions and waits jump the clock straight to
+// the next event instead of sleeping, and every sensor read advances it by
+// one poll period, so busy-wait loops like cali_inertial terminate. The
+// heading is piecewise linear in time, with drift, post-stop settling and
+// sensor latency layered on top when it is read. A non-zero realTimeScale
+// also sleeps for the scaled length of every jump, so work on other
+// threads can overlap the robot's motion as it would on the real robot.
+class SimulatedHardware : public RobotHardware {
+private:
+    // Scheduled state change
+    enum EventType {
+        EVENT_CALIBRATION_DONE,     // IMU calibration finishes
+        EVENT_MOTION_DONE           // Timed turn reaches its target
+    };
+
+    // Entry in the event queue
+    struct Event {
+        double time;
+        long long sequence;         // Tie breaker keeping same-time events in order
+        EventType type;
+
+        bool operator>(const Event& other) const {
+            return time > other.time || (time == other.time && sequence > other.sequence);
+        }
+    };
+
+    // Piece of the heading trajectory with a constant turn rate
+    struct HeadingSegment {
+        double start;               // Virtual time the segment begins
+        double heading;             // True heading at start
+        double rate;                // Degrees per second (positive to the right)
+    };
+
+    SimulationConfig config;
+    double clock;                   // Virtual time in seconds
+    long long nextSequence;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events;
+    std::vector<HeadingSegment> trajectory;
+
+    double velocityRpm;             // Commanded motor velocity
+    bool calibrating;               // IMU calibration running
+    bool calibrated;                // IMU calibration has completed at least once
+    double calibrationTime;         // Time the last calibration completed
+    double headingOffset;           // Subtracted from the true heading (IMU zero)
+    double lastStopTime;            // Time of the last stop (for settling)
+    double lastStopRate;            // Turn rate at the last stop
+    double distanceCm;              // Total distance driven
+    long long sensorReads;          // Number of sensor reads
+
+    // Queue an event at an absolute time
+    void schedule(double time, EventType type);
+
+    // Move the clock forward, applying every event due on the way
+    void advanceTo(double time);
+
+    // Apply one event
+    void apply(const Event& event);
+
+    // Start a new heading segment at the current time
+    void setTurnRate(double rate);
+
+    // Get the true heading at a time (not before the last retained segment)
+    double getTrueHeading(double time) const;
+
+    // Get the wheel surface speed in centimeters per second
+    double getWheelSpeed() const;
+
+public:
+    // Constructor
+    explicit SimulatedHardware(const SimulationConfig& simulation_config = getDefaultSimulationConfig());
+
+    // RobotHardware interface
+    double getTime() const override;
+    void wait(double seconds) override;
+    void setVelocity(double rpm) override;
+    void driveForward(double centimeters) override;
+    void turnBy(double degrees) override;
+    void startTurnRight() override;
+    void stop() override;
+    void calibrateImu() override;
+    bool isImuCalibrating() override;
+    double getHeading() override;
+
+    // Get the total distance driven in centimeters
+    double getDistanceDriven() const;
+
+    // Get the number of sensor reads
+    long long getSensorReads() const;
+};
+
+#endif // SIMULATED_HARDWARE_H
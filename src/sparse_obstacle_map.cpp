@@ -0,0 +1,237 @@
+#include "sparse_obstacle_map.h"
+#include <algorithm>
+#include <bitset>
+
+namespace {
+// Get the mask selecting bits [from, to] of a single word
+uint64_t getRangeMask(int from, int to) {
+    uint64_t upper = (to >= 63) ? ~uint64_t(0) : ((uint64_t(1) << (to + 1)) - 1);
+    uint64_t lower = (uint64_t(1) << from) - 1;
+    return upper & ~lower;
+}
+}
+
+// Constructor (allocates no tiles)
+SparseObstacleMap::SparseObstacleMap(int map_width, int map_height) :
+    width(map_width > 0 ? map_width : 0), height(map_height > 0 ? map_height : 0), rootSpan(1) {
+
+    // The root block is the smallest power-of-two square of tiles covering the map
+    int tilesX = (width + kTileSize - 1) >> kTileShift;
+    int tilesY = (height + kTileSize - 1) >> kTileShift;
+    while (rootSpan < tilesX || rootSpan < tilesY) {
+        rootSpan *= 2;
+    }
+    addNode();
+}
+
+// Get the tile holding a cell, or nullptr if none is allocated
+const SparseObstacleMap::Tile* SparseObstacleMap::findTile(int x, int y) const {
+    std::unordered_map<uint64_t, int>::const_iterator found = tileIndex.find(tileKey(x >> kTileShift, y >> kTileShift));
+    return (found == tileIndex.end()) ? nullptr : &tiles[found->second];
+}
+
+// Append an empty quadtree node and get its index
+int SparseObstacleMap::addNode() {
+    QuadNode node;
+    node.count = 0;
+    for (int i = 0; i < 4; i++) {
+        node.children[i] = -1;
+    }
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+// Get the map width
+int SparseObstacleMap::getWidth() const {
+    return width;
+}
+
+// Get the map height
+int SparseObstacleMap::getHeight() const {
+    return height;
+}
+
+// Check if an obstacle is detected (out-of-bounds cells count as obstacles)
+bool SparseObstacleMap::isObstacleDetected(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return true;
+    }
+    const Tile* tile = findTile(x, y);
+    return tile != nullptr && (tile->rows[y & (kTileSize - 1)] & (uint64_t(1) << (x & 63))) != 0;
+}
+
+// Mark an obstacle at the specified position (ignored if out of bounds)
+void SparseObstacleMap::markObstacle(int x, int y) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    int tileX = x >> kTileShift;
+    int tileY = y >> kTileShift;
+    int row = y & (kTileSize - 1);
+    uint64_t mask = uint64_t(1) << (x & 63);
+
+    // Allocate the tile on its first obstacle; a cell already set changes no count
+    int tile = 0;
+    uint64_t key = tileKey(tileX, tileY);
+    std::unordered_map<uint64_t, int>::const_iterator found = tileIndex.find(key);
+    if (found == tileIndex.end()) {
+        tile = static_cast<int>(tiles.size());
+        tiles.push_back(Tile());
+        tileIndex[key] = tile;
+    } else {
+        tile = found->second;
+        if (tiles[tile].rows[row] & mask) {
+            return;
+        }
+    }
+    tiles[tile].rows[row] |= mask;
+
+    // Count the obstacle in every block on the way down to the tile's leaf
+    int node = 0;
+    int blockX = 0;
+    int blockY = 0;
+    int span = rootSpan;
+    nodes[node].count++;
+    while (span > 1) {
+        int half = span / 2;
+        int quadrant = 0;
+        if (tileX >= blockX + half) {
+            quadrant |= 1;
+            blockX += half;
+        }
+        if (tileY >= blockY + half) {
+            quadrant |= 2;
+            blockY += half;
+        }
+        int child = nodes[node].children[quadrant];
+        if (child < 0) {
+            child = addNode();
+            nodes[node].children[quadrant] = child;
+        }
+        node = child;
+        nodes[node].count++;
+        span = half;
+    }
+    nodes[node].children[0] = tile;
+}
+
+// Check a quadtree block against a rectangle of cells
+bool SparseObstacleMap::isBlockFree(int node, int blockX, int blockY, int span, int fromX, int fromY, int toX,
+                                    int toY) const {
+    if (node < 0 || nodes[node].count == 0) {
+        return true;
+    }
+
+    // Cells of the block that lie inside the map
+    long long cellX0 = static_cast<long long>(blockX) << kTileShift;
+    long long cellY0 = static_cast<long long>(blockY) << kTileShift;
+    long long cellX1 = std::min((static_cast<long long>(blockX) + span) << kTileShift, static_cast<long long>(width)) - 1;
+    long long cellY1 = std::min((static_cast<long long>(blockY) + span) << kTileShift, static_cast<long long>(height)) - 1;
+    if (toX < cellX0 || fromX > cellX1 || toY < cellY0 || fromY > cellY1) {
+        return true;
+    }
+
+    // A block holding obstacles and lying wholly inside the rectangle blocks it
+    if (fromX <= cellX0 && toX >= cellX1 && fromY <= cellY0 && toY >= cellY1) {
+        return false;
+    }
+
+    if (span == 1) {
+        const Tile& tile = tiles[nodes[node].children[0]];
+        int x0 = static_cast<int>(std::max(static_cast<long long>(fromX), cellX0) - cellX0);
+        int x1 = static_cast<int>(std::min(static_cast<long long>(toX), cellX1) - cellX0);
+        int y0 = static_cast<int>(std::max(static_cast<long long>(fromY), cellY0) - cellY0);
+        int y1 = static_cast<int>(std::min(static_cast<long long>(toY), cellY1) - cellY0);
+        uint64_t mask = getRangeMask(x0, x1);
+        for (int y = y0; y <= y1; y++) {
+            if (tile.rows[y] & mask) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int half = span / 2;
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        if (!isBlockFree(nodes[node].children[quadrant], blockX + (quadrant & 1) * half,
+                         blockY + (quadrant >> 1) * half, half, fromX, fromY, toX, toY)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check if the rectangle [fromX, toX] x [fromY, toY] is free (blocked if any part is outside)
+bool SparseObstacleMap::isRectangleFree(int fromX, int fromY, int toX, int toY) const {
+    if (fromX < 0 || fromY < 0 || toX >= width || toY >= height) {
+        return false;
+    }
+    if (fromX > toX || fromY > toY) {
+        return true;
+    }
+    return isBlockFree(0, 0, 0, rootSpan, fromX, fromY, toX, toY);
+}
+
+// Count all obstacles in the map
+long long SparseObstacleMap::countObstacles() const {
+    return nodes[0].count;
+}
+
+// Get the memory held by tiles, quadtree and index in bytes (the index estimate is approximate)
+long long SparseObstacleMap::getStorageBytes() const {
+    // Each index entry is a heap node holding the pair and a next pointer
+    long long indexBytes = static_cast<long long>(tileIndex.bucket_count()) * sizeof(void*) +
+                           static_cast<long long>(tileIndex.size()) *
+                               (sizeof(std::pair<const uint64_t, int>) + sizeof(void*));
+    return static_cast<long long>(tiles.capacity()) * sizeof(Tile) +
+           static_cast<long long>(nodes.capacity()) * sizeof(QuadNode) + indexBytes;
+}
+
+// Get the number of allocated tiles
+int SparseObstacleMap::getTileCount() const {
+    return static_cast<int>(tiles.size());
+}
+
+// Mark every obstacle of this map in a dense grid of the same size
+bool SparseObstacleMap::copyTo(OccupancyGrid& grid) const {
+    if (grid.getWidth() != width || grid.getHeight() != height) {
+        return false;
+    }
+
+    std::unordered_map<uint64_t, int>::const_iterator it;
+    for (it = tileIndex.begin(); it != tileIndex.end(); ++it) {
+        int originX = static_cast<int>(it->first & 0xFFFFFFFFu) << kTileShift;
+        int originY = static_cast<int>(it->first >> 32) << kTileShift;
+        const Tile& tile = tiles[it->second];
+        for (int row = 0; row < kTileSize; row++) {
+            uint64_t bits = tile.rows[row];
+            while (bits != 0) {
+                int x = originX + static_cast<int>(std::bitset<64>((bits & (~bits + 1)) - 1).count());
+                grid.markObstacle(x, originY + row);
+                bits &= bits - 1;
+            }
+        }
+    }
+    return true;
+}
+
+// Merge the obstacles of a dense grid of the same size into this map
+bool SparseObstacleMap::mergeFrom(const OccupancyGrid& grid) {
+    if (grid.getWidth() != width || grid.getHeight() != height) {
+        return false;
+    }
+
+    const uint64_t* words = grid.getWords();
+    int wordsPerRow = grid.getWordsPerRow();
+    for (int y = 0; y < height; y++) {
+        const uint64_t* row = words + static_cast<size_t>(y) * wordsPerRow;
+        for (int word = 0; word < wordsPerRow; word++) {
+            uint64_t bits = row[word];
+            while (bits != 0) {
+                markObstacle(word * 64 + static_cast<int>(std::bitset<64>((bits & (~bits + 1)) - 1).count()), y);
+                bits &= bits - 1;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+#ifndef SPARSE_OBSTACLE_MAP_H
+#define SPARSE_OBSTACLE_MAP_H
+
+#include "obstacle_map.h"
+#include "occupancy_grid.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Tiled obstacle map for large, mostly empty fields
+//
+// The field is cut into 64 x 64 tiles, bit-packed one word per tile row.
+// A tile is only allocated by the first obstacle marked in it, so
+// construction is constant time and memory grows with the number of
+// occupied tiles rather than with the field area. A hash index finds the
+// tile of a cell; a quadtree over the tiles keeps obstacle counts so a
+// rectangle query skips every empty block in one step.
+class SparseObstacleMap final : public ObstacleMap {
+private:
+    static const int kTileShift = 6;
+    static const int kTileSize = 1 << kTileShift;   // Cells per tile side (one word per tile row)
+
+    // One allocated tile; bit x of rows[y] is the cell (x, y) within the tile
+    struct Tile {
+        uint64_t rows[kTileSize];
+    };
+
+    // Quadtree node over a square block of tiles
+    struct QuadNode {
+        long long count;    // Obstacles inside the block
+        int children[4];    // Child nodes by quadrant (-1 until needed); a leaf holds its tile in children[0]
+    };
+
+    int width;
+    int height;
+    int rootSpan;                                   // Tiles per side of the root block (a power of two)
+    std::vector<Tile> tiles;
+    std::unordered_map<uint64_t, int> tileIndex;    // (tileY << 32 | tileX) -> index into tiles
+    std::vector<QuadNode> nodes;                    // nodes[0] is the root
+
+    // Get the hash index key of a tile
+    static uint64_t tileKey(int tileX, int tileY) {
+        return (static_cast<uint64_t>(tileY) << 32) | static_cast<uint32_t>(tileX);
+    }
+
+    // Get the tile holding a cell, or nullptr if none is allocated
+    const Tile* findTile(int x, int y) const;
+
+    // Append an empty quadtree node and get its index
+    int addNode();
+
+    // Check a quadtree block against a rectangle of cells
+    bool isBlockFree(int node, int blockX, int blockY, int span, int fromX, int fromY, int toX, int toY) const;
+
+public:
+    // Constructor (allocates no tiles)
+    SparseObstacleMap(int map_width, int map_height);
+
+    // Get the map width
+    int getWidth() const override;
+
+    // Get the map height
+    int getHeight() const override;
+
+    // Check if an obstacle is detected (out-of-bounds cells count as obstacles)
+    bool isObstacleDetected(int x, int y) const override;
+
+    // Mark an obstacle at the specified position (ignored if out of bounds)
+    void markObstacle(int x, int y) override;
+
+    // Check if the rectangle [fromX, toX] x [fromY, toY] is free (blocked if any part is outside)
+    bool isRectangleFree(int fromX, int fromY, int toX, int toY) const override;
+
+    // Count all obstacles in the map
+    long long countObstacles() const override;
+
+    // Get the memory held by tiles, quadtree and index in bytes (the index estimate is approximate)
+    long long getStorageBytes() const override;
+
+    // Get the number of allocated tiles
+    int getTileCount() const;
+
+    // Mark every obstacle of this map in a dense grid of the same size
+    bool copyTo(OccupancyGrid& grid) const;
+
+    // Merge the obstacles of a dense grid of the same size into this map
+    bool mergeFrom(const OccupancyGrid& grid);
+};
+
+#endif // SPARSE_OBSTACLE_MAP_H
@@ -0,0 +1,65 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free single-producer single-consumer queue
+//
+// Exactly one thread may push and exactly one other thread may pop. Each
+// side owns one index and only reads the other's, so neither side ever
+// waits: tryPush fails when the queue is full and tryPop when it is empty.
+// The indices sit on separate cache lines so the two threads do not
+// invalidate each other's line on every operation.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+private:
+    std::array<T, Capacity> items;
+    alignas(64) std::atomic<size_t> head;   // Next position to pop (consumer)
+    alignas(64) std::atomic<size_t> tail;   // Next position to push (producer)
+
+public:
+    // Constructor
+    SpscQueue() : items(), head(0), tail(0) {}
+
+    // Append an item (producer only); returns false if the queue is full
+    bool tryPush(const T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Take the oldest item (consumer only); returns false if the queue is empty
+    bool tryPop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[position & (Capacity - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Check if the queue is empty (exact only on the consumer side)
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    // Get the capacity of the queue
+    static constexpr size_t getCapacity() {
+        return Capacity;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+};
+
+#endif // SPSC_QUEUE_H
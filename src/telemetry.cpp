@@ -0,0 +1,211 @@
+#include "telemetry.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+const size_t kFileBufferBytes = 64 * 1024;  // stdio buffer of the telemetry file
+
+// Get the steady clock in microseconds
+int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+// Constructor
+TelemetryWriter::TelemetryWriter() :
+    queue(new RecordQueue()), file(nullptr), running(false), nextSequence(0), dropped(0), written(0),
+    openMicros(0) {}
+
+// Destructor (writes the remaining events and closes the file)
+TelemetryWriter::~TelemetryWriter() {
+    close();
+}
+
+// Create the file and start the writer thread
+bool TelemetryWriter::open(const std::string& path, int path_capacity, std::string& error) {
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IOFBF, kFileBufferBytes);
+
+    TelemetryFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kTelemetryMagic, sizeof(header.magic));
+    header.version = kTelemetryVersion;
+    header.recordBytes = sizeof(TelemetryRecord);
+    header.pathCapacity = path_capacity;
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    nextSequence = 0;
+    dropped.store(0);
+    written.store(0);
+    openMicros = nowMicros();
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&TelemetryWriter::writerLoop, this);
+    return true;
+}
+
+// Write the remaining events and close the file
+void TelemetryWriter::close() {
+    if (file == nullptr) {
+        return;
+    }
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+    std::fclose(file);
+    file = nullptr;
+}
+
+// Check if a file is open
+bool TelemetryWriter::isOpen() const {
+    return file != nullptr;
+}
+
+// Queue an event without blocking; the sequence is filled in here
+void TelemetryWriter::record(TelemetryRecord event) {
+    event.sequence = nextSequence++;
+    if (!queue->tryPush(event)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Write every queued record; returns the number written
+int TelemetryWriter::drain() {
+    int count = 0;
+    TelemetryRecord event;
+    while (queue->tryPop(event)) {
+        std::fwrite(&event, sizeof(event), 1, file);
+        count++;
+    }
+    return count;
+}
+
+// Writer thread body
+void TelemetryWriter::writerLoop() {
+    while (true) {
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        int count = drain();
+        if (count > 0) {
+            written.fetch_add(count, std::memory_order_relaxed);
+            continue;
+        }
+
+        // The producer has stopped once running is cleared, so an empty queue is final
+        if (stopping) {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    std::fflush(file);
+}
+
+// Get the wall time since open in microseconds
+int64_t TelemetryWriter::getElapsedMicros() const {
+    return nowMicros() - openMicros;
+}
+
+// Get the number of events queued so far
+long long TelemetryWriter::getRecordedCount() const {
+    return static_cast<long long>(nextSequence) - dropped.load(std::memory_order_relaxed);
+}
+
+// Get the number of events written to the file
+long long TelemetryWriter::getWrittenCount() const {
+    return written.load(std::memory_order_relaxed);
+}
+
+// Get the number of events dropped because the queue was full
+long long TelemetryWriter::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// Get the name of a telemetry event type
+const char* getTelemetryEventName(int type) {
+    switch (type) {
+        case TELEMETRY_MOVE:
+            return "MOVE";
+        case TELEMETRY_TURN:
+            return "TURN";
+        case TELEMETRY_NODE_INSERTED:
+            return "NODE_INSERTED";
+        case TELEMETRY_COMPACTION:
+            return "COMPACTION";
+        case TELEMETRY_OBSTACLE_DETECTED:
+            return "OBSTACLE_DETECTED";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+// Read a whole telemetry file
+bool readTelemetryFile(const std::string& path, TelemetryFileHeader& header,
+                       std::vector<TelemetryRecord>& records, std::string& error) {
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (in == nullptr) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+
+    bool valid = std::fread(&header, sizeof(header), 1, in) == 1 &&
+                 std::memcmp(header.magic, kTelemetryMagic, sizeof(header.magic)) == 0;
+    if (!valid) {
+        error = "'" + path + "' is not a telemetry file";
+    } else if (header.version != kTelemetryVersion || header.recordBytes != sizeof(TelemetryRecord)) {
+        error = "'" + path + "' has an unsupported telemetry version";
+        valid = false;
+    }
+
+    // A truncated trailing record (the writer was killed mid-write) is ignored
+    records.clear();
+    TelemetryRecord event;
+    while (valid && std::fread(&event, sizeof(event), 1, in) == 1) {
+        records.push_back(event);
+    }
+    std::fclose(in);
+    return valid;
+}
+
+// Rebuild the path list as it was after the first event_count events
+bool replayTelemetry(const TelemetryFileHeader& header, const std::vector<TelemetryRecord>& records,
+                     size_t event_count, DoublyLinkedList& path, std::string& error) {
+    path = DoublyLinkedList(header.pathCapacity);
+    if (event_count > records.size()) {
+        event_count = records.size();
+    }
+
+    for (size_t i = 0; i < event_count; i++) {
+        const TelemetryRecord& event = records[i];
+        if (event.type == TELEMETRY_NODE_INSERTED) {
+            path.insert(event.x, event.y, static_cast<NodeType>(event.detail));
+        } else if (event.type == TELEMETRY_COMPACTION) {
+            int removed = 0;
+            if (event.detail == COMPACTION_CAPACITY) {
+                removed = path.removeRegularNodes();
+            } else {
+                // The previous necessary node is the last one before the new tail
+                Node* current = path.getTail();
+                Node* previous = (current != nullptr) ? current->prev : nullptr;
+                while (previous != nullptr && previous->type == REGULAR && previous->prev != nullptr) {
+                    previous = previous->prev;
+                }
+                removed = path.removeRegularNodesBetweenNecessary(current, previous);
+            }
+
+            if (removed != event.value) {
+                error = "compaction at event " + std::to_string(event.sequence) + " removed " +
+                        std::to_string(removed) + " nodes, recorded " + std::to_string(event.value);
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,137 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "doubly_linked_list.h"
+#include "spsc_queue.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Telemetry event types
+enum TelemetryEventType {
+    TELEMETRY_MOVE = 1,             // Robot moved one cell to (x, y)
+    TELEMETRY_TURN = 2,             // Robot turned to heading at (x, y)
+    TELEMETRY_NODE_INSERTED = 3,    // Path node of type detail appended at (x, y)
+    TELEMETRY_COMPACTION = 4,       // Trigger detail removed value nodes
+    TELEMETRY_OBSTACLE_DETECTED = 5 // Obstacle marked at (x, y)
+};
+
+// Compaction trigger recorded in the detail field of TELEMETRY_COMPACTION
+enum TelemetryCompaction {
+    COMPACTION_CAPACITY = 0,        // removeRegularNodes
+    COMPACTION_TURNING = 1          // removeRegularNodesBetweenNecessary(tail, previous necessary node)
+};
+
+// One fixed-size event record (32 bytes, little-endian on disk)
+struct TelemetryRecord {
+    int64_t timeMicros;     // Robot clock (virtual on the simulator) or wall time since open
+    uint32_t sequence;      // Event index, assigned by the writer
+    uint8_t type;           // TelemetryEventType
+    uint8_t detail;         // NodeType or TelemetryCompaction
+    int16_t heading;        // Heading in degrees after the event
+    int32_t x;              // Robot or obstacle position
+    int32_t y;
+    int32_t value;          // Nodes removed by a compaction (0 otherwise)
+    int32_t reserved;       // 0
+};
+
+static_assert(sizeof(TelemetryRecord) == 32, "TelemetryRecord must stay 32 bytes");
+
+const char kTelemetryMagic[8] = {'R', 'P', 'T', 'E', 'L', 'E', 'M', '1'};
+const uint32_t kTelemetryVersion = 1;
+
+// Telemetry file header (24 bytes), followed by the records
+struct TelemetryFileHeader {
+    char magic[8];          // kTelemetryMagic
+    uint32_t version;       // kTelemetryVersion
+    uint32_t recordBytes;   // sizeof(TelemetryRecord)
+    int32_t pathCapacity;   // Capacity of the recorded path list
+    uint32_t reserved;      // 0
+};
+
+static_assert(sizeof(TelemetryFileHeader) == 24, "TelemetryFileHeader must stay 24 bytes");
+
+// Number of records the writer can hold before it starts dropping
+const size_t kTelemetryQueueRecords = 4096;
+
+// Append-only binary event stream
+//
+// record() copies the event into a lock-free single-producer queue and
+// returns immediately; a background thread drains the queue into a
+// buffered file. The planning loop never waits on the disk: if the writer
+// falls a whole queue behind, new events are dropped and counted instead.
+// Each writer takes events from one planner thread only.
+class TelemetryWriter {
+private:
+    typedef SpscQueue<TelemetryRecord, kTelemetryQueueRecords> RecordQueue;
+
+    std::unique_ptr<RecordQueue> queue; // Events waiting for the writer thread
+    std::FILE* file;                    // Destination (nullptr when closed)
+    std::thread writer;                 // Background writer thread
+    std::atomic<bool> running;          // Cleared to stop the writer
+    uint32_t nextSequence;              // Sequence of the next event (producer side)
+    std::atomic<long long> dropped;     // Events lost to a full queue
+    std::atomic<long long> written;     // Events written to the file
+    int64_t openMicros;                 // Wall clock at open
+
+    // Writer thread body
+    void writerLoop();
+
+    // Write every queued record; returns the number written
+    int drain();
+
+public:
+    // Constructor
+    TelemetryWriter();
+
+    // Destructor (writes the remaining events and closes the file)
+    ~TelemetryWriter();
+
+    // Create the file and start the writer thread
+    bool open(const std::string& path, int path_capacity, std::string& error);
+
+    // Write the remaining events and close the file
+    void close();
+
+    // Check if a file is open
+    bool isOpen() const;
+
+    // Queue an event without blocking; the sequence is filled in here
+    void record(TelemetryRecord event);
+
+    // Get the wall time since open in microseconds
+    int64_t getElapsedMicros() const;
+
+    // Get the number of events queued so far
+    long long getRecordedCount() const;
+
+    // Get the number of events written to the file
+    long long getWrittenCount() const;
+
+    // Get the number of events dropped because the queue was full
+    long long getDroppedCount() const;
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+};
+
+// Get the name of a telemetry event type
+const char* getTelemetryEventName(int type);
+
+// Read a whole telemetry file
+bool readTelemetryFile(const std::string& path, TelemetryFileHeader& header,
+                       std::vector<TelemetryRecord>& records, std::string& error);
+
+// Rebuild the path list as it was after the first event_count events
+//
+// Node insertions and compactions are applied in order to a fresh list of
+// the recorded capacity. Fails if a compaction removes a different number
+// of nodes than was recorded.
+bool replayTelemetry(const TelemetryFileHeader& header, const std::vector<TelemetryRecord>& records,
+                     size_t event_count, DoublyLinkedList& path, std::string& error);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,127 @@
+#include "thread_pool.h"
+
+// Index of the pool worker running on this thread (-1 outside the pool)
+static thread_local int currentWorker = -1;
+static thread_local const ThreadPool* currentPool = nullptr;
+
+// Constructor
+ThreadPool::ThreadPool(int thread_count) : queued(0), pending(0), nextQueue(0), stopping(false) {
+    if (thread_count <= 0) {
+        thread_count = static_cast<int>(std::thread::hardware_concurrency());
+        if (thread_count <= 0) {
+            thread_count = 1;
+        }
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+    for (int i = 0; i < thread_count; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+// Destructor (finishes queued tasks, then joins the workers)
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Queue a task; tasks submitted from a worker go to its own deque
+void ThreadPool::submit(std::function<void()> task) {
+    int target = currentWorker;
+    if (currentPool != this || target < 0) {
+        target = static_cast<int>(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    }
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    // Publish under the state mutex so a worker about to sleep cannot miss it
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    workAvailable.notify_one();
+}
+
+// Take a task from the own deque or steal one (false if none found)
+bool ThreadPool::takeTask(int index, std::function<void()>& task) {
+    // Newest own task first (still warm in cache)
+    {
+        WorkQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest task of the next busy worker
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; offset++) {
+        WorkQueue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Worker thread body
+void ThreadPool::workerLoop(int index) {
+    currentWorker = index;
+    currentPool = this;
+
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(index, task)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+
+            // The last task to finish wakes up wait()
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        // Sleep until something is queued or the pool shuts down
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_relaxed) > 0;
+        });
+        if (stopping && queued.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+// Block until every submitted task has finished
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] {
+        return pending.load(std::memory_order_acquire) == 0;
+    });
+}
+
+// Get the number of worker threads
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size());
+}
@@ -0,0 +1,62 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool
+//
+// Every worker owns a task deque. A worker takes its own newest task first
+// and, when its deque runs dry, steals the oldest task of another worker,
+// so uneven task costs balance out without a single shared queue.
+class ThreadPool {
+private:
+    // Task deque owned by one worker
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()> > tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue> > queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> queued;            // Tasks sitting in a deque
+    std::atomic<int> pending;           // Tasks submitted but not finished
+    std::atomic<unsigned> nextQueue;    // Round-robin target for outside submits
+    bool stopping;                      // Set under stateMutex to stop the workers
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    // Worker thread body
+    void workerLoop(int index);
+
+    // Take a task from the own deque or steal one (false if none found)
+    bool takeTask(int index, std::function<void()>& task);
+
+public:
+    // Constructor (0 threads means one per hardware thread)
+    explicit ThreadPool(int thread_count = 0);
+
+    // Destructor (finishes queued tasks, then joins the workers)
+    ~ThreadPool();
+
+    // Queue a task; tasks submitted from a worker go to its own deque
+    void submit(std::function<void()> task);
+
+    // Block until every submitted task has finished
+    void wait();
+
+    // Get the number of worker threads
+    int getThreadCount() const;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+#endif // THREAD_POOL_H
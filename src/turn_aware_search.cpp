@@ -0,0 +1,245 @@
+#include "turn_aware_search.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Headings are the axis moves, indexed as in kAxisMoves
+static const int kHeadingCount = kAxisMoveCount;
+static const int kNoHeading = -1;
+
+// Get the number of 90 degree turns between two headings
+static int turnsBetween(int from, int to) {
+    if (from == kNoHeading) {
+        return 0;
+    }
+    Direction fromDirection = getDirectionFromStep(kAxisMoves[from].dx, kAxisMoves[from].dy);
+    Direction toDirection = getDirectionFromStep(kAxisMoves[to].dx, kAxisMoves[to].dy);
+    return std::abs(getTurnDegrees(fromDirection, toDirection)) / 90;
+}
+
+// Convert seconds to the integer cost unit (microseconds)
+static int64_t toCost(double seconds) {
+    return std::max<int64_t>(0, static_cast<int64_t>(std::llround(seconds * 1e6)));
+}
+
+// Get the cost model of the default simulated robot at 10 RPM
+//
+// Measured on SimulatedHardware: a 2 cm move takes 0.53 s, and a turn with
+// the planner's settle waits and IMU corrections takes about 6 s.
+TurnCostModel getDefaultTurnCostModel() {
+    TurnCostModel model;
+    model.moveSeconds = 0.53;
+    model.turnSeconds = 6.0;
+    return model;
+}
+
+// Constructor
+TurnAwareSearch::TurnAwareSearch(const OccupancyGrid& map, int allowed_moves, const TurnCostModel& cost_model) :
+    grid(map), allowedMoves(allowed_moves), moveCost(1), turnCost(0), searchStamp(0),
+    expansions(0), pathLength(-1), turnCount(0), predictedSeconds(0.0), goalX(0), goalY(0) {
+    setCostModel(cost_model);
+}
+
+// Set the cost model
+void TurnAwareSearch::setCostModel(const TurnCostModel& cost_model) {
+    // A zero move cost would leave nothing for the heuristic to count
+    moveCost = std::max<int64_t>(1, toCost(cost_model.moveSeconds));
+    turnCost = toCost(cost_model.turnSeconds);
+}
+
+// Set the allowed moves
+void TurnAwareSearch::setAllowedMoves(int allowed_moves) {
+    allowedMoves = allowed_moves;
+}
+
+// Heuristic cost from (x, y) facing heading to the destination
+int64_t TurnAwareSearch::heuristic(int x, int y, int heading) const {
+    int dx = goalX - x;
+    int dy = goalY - y;
+
+    // Every axis with distance left needs one run; facing along one of them saves a turn
+    int runs = (dx != 0 ? 1 : 0) + (dy != 0 ? 1 : 0);
+    bool aligned = (heading != kNoHeading) &&
+                   ((dx != 0 && kAxisMoves[heading].dx == (dx > 0 ? 1 : -1)) ||
+                    (dy != 0 && kAxisMoves[heading].dy == (dy > 0 ? 1 : -1)));
+    int turns = (runs == 0) ? 0 : (aligned ? runs - 1 : runs);
+
+    return static_cast<int64_t>(std::abs(dx) + std::abs(dy)) * moveCost + turns * turnCost;
+}
+
+// Search for a route from start, facing along (headingDx, headingDy), to destination
+bool TurnAwareSearch::findPath(int startX, int startY, int headingDx, int headingDy, int destX, int destY) {
+    goalX = destX;
+    goalY = destY;
+    waypoints.clear();
+    pathLength = -1;
+    turnCount = 0;
+    predictedSeconds = 0.0;
+    expansions = 0;
+
+    // Both endpoints must be free cells on the map
+    if (grid.isObstacleDetected(startX, startY) || grid.isObstacleDetected(destX, destY)) {
+        return false;
+    }
+
+    // Size the per-state arrays on first use or when the map changes size
+    size_t stateCount = static_cast<size_t>(grid.getWidth()) * grid.getHeight() * kHeadingCount;
+    if (stamp.size() != stateCount) {
+        gScore.assign(stateCount, 0);
+        parent.assign(stateCount, -1);
+        stamp.assign(stateCount, 0);
+        searchStamp = 0;
+    }
+    searchStamp++;
+    if (searchStamp == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        searchStamp = 1;
+    }
+    openSet.reset(static_cast<int>(stateCount));
+
+    int startHeading = kNoHeading;
+    for (int i = 0; i < kHeadingCount; i++) {
+        if (kAxisMoves[i].dx == headingDx && kAxisMoves[i].dy == headingDy) {
+            startHeading = i;
+        }
+    }
+    if (startX == destX && startY == destY) {
+        GridCell start = {startX, startY};
+        waypoints.push_back(start);
+        pathLength = 0;
+        return true;
+    }
+
+    // Open the moves out of the start cell; a turn before the first move is charged as usual
+    int width = grid.getWidth();
+    for (int i = 0; i < kHeadingCount; i++) {
+        int nextX = startX + kAxisMoves[i].dx;
+        int nextY = startY + kAxisMoves[i].dy;
+        if ((allowedMoves & kAxisMoves[i].flag) == 0 || grid.isObstacleDetected(nextX, nextY)) {
+            continue;
+        }
+        int64_t g = moveCost + turnsBetween(startHeading, i) * turnCost;
+        relax((nextY * width + nextX) * kHeadingCount + i, nextX, nextY, i, g, -1);
+    }
+
+    while (!openSet.isEmpty()) {
+        int state = openSet.pop();
+        int heading = state % kHeadingCount;
+        int cell = state / kHeadingCount;
+        int x = cell % width;
+        int y = cell / width;
+        int64_t g = gScore[state];
+        expansions++;
+
+        // The first time the destination is popped its cost is minimal
+        if (x == goalX && y == goalY) {
+            predictedSeconds = static_cast<double>(g) / 1e6;
+
+            // Count the turns, including one before the first move
+            int firstHeading = heading;
+            for (int s = state; s >= 0; s = parent[s]) {
+                int previous = parent[s];
+                if (previous >= 0) {
+                    turnCount += turnsBetween(previous % kHeadingCount, s % kHeadingCount);
+                } else {
+                    firstHeading = s % kHeadingCount;
+                }
+            }
+            turnCount += turnsBetween(startHeading, firstHeading);
+
+            buildWaypoints(state);
+            GridCell start = {startX, startY};
+            waypoints.insert(waypoints.begin(), start);
+            pathLength = 0;
+            for (int s = state; s >= 0; s = parent[s]) {
+                pathLength++;
+            }
+            return true;
+        }
+
+        for (int i = 0; i < kHeadingCount; i++) {
+            if ((allowedMoves & kAxisMoves[i].flag) == 0) {
+                continue;
+            }
+            int nextX = x + kAxisMoves[i].dx;
+            int nextY = y + kAxisMoves[i].dy;
+            if (grid.isObstacleDetected(nextX, nextY)) {
+                continue;
+            }
+            int64_t nextG = g + moveCost + turnsBetween(heading, i) * turnCost;
+            relax((nextY * width + nextX) * kHeadingCount + i, nextX, nextY, i, nextG, state);
+        }
+    }
+
+    return false;
+}
+
+// Reach a state with cost g from parentState, opening it if it improved
+void TurnAwareSearch::relax(int state, int x, int y, int heading, int64_t g, int parentState) {
+    if (stamp[state] == searchStamp && g >= gScore[state]) {
+        return;
+    }
+
+    stamp[state] = searchStamp;
+    gScore[state] = g;
+    parent[state] = parentState;
+
+    // Order by f, breaking ties towards the destination
+    int64_t h = heuristic(x, y, heading);
+    int64_t remaining = std::min<int64_t>(std::abs(goalX - x) + std::abs(goalY - y), 0xFFFF);
+    openSet.push(state, ((g + h) << 16) | remaining);
+}
+
+// Rebuild the waypoint list from the parent links (without the start cell)
+void TurnAwareSearch::buildWaypoints(int goalState) {
+    int width = grid.getWidth();
+    int goalCell = goalState / kHeadingCount;
+    GridCell goal = {goalCell % width, goalCell / width};
+    waypoints.push_back(goal);
+
+    // Walk back from the destination; a heading change turns on the cell of the earlier state
+    for (int state = goalState; parent[state] >= 0; state = parent[state]) {
+        int previous = parent[state];
+        if (previous % kHeadingCount != state % kHeadingCount) {
+            int cell = previous / kHeadingCount;
+            GridCell point = {cell % width, cell / width};
+            waypoints.push_back(point);
+        }
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+}
+
+// Get the waypoints of the last route (start, turning cells, destination)
+const std::vector<GridCell>& TurnAwareSearch::getWaypoints() const {
+    return waypoints;
+}
+
+// Get the number of waypoints of the last route
+int TurnAwareSearch::getWaypointCount() const {
+    return static_cast<int>(waypoints.size());
+}
+
+// Write the last route into a list as START_LOCATION/TURNING_NODE waypoints
+bool TurnAwareSearch::buildPath(DoublyLinkedList& out) const {
+    return buildWaypointList(waypoints, out);
+}
+
+// Get the number of cells on the last route (-1 if none was found)
+int TurnAwareSearch::getPathLength() const {
+    return pathLength;
+}
+
+// Get the number of 90 degree turns on the last route
+int TurnAwareSearch::getTurnCount() const {
+    return turnCount;
+}
+
+// Get the predicted time of the last route in seconds
+double TurnAwareSearch::getPredictedSeconds() const {
+    return predictedSeconds;
+}
+
+// Get the number of states expanded by the last search
+long long TurnAwareSearch::getExpansions() const {
+    return expansions;
+}
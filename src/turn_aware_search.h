@@ -0,0 +1,97 @@
+#ifndef TURN_AWARE_SEARCH_H
+#define TURN_AWARE_SEARCH_H
+
+#include "doubly_linked_list.h"
+#include "grid_search.h"
+#include "indexed_min_heap.h"
+#include "occupancy_grid.h"
+#include <cstdint>
+#include <vector>
+
+// Predicted time of the robot's motions
+struct TurnCostModel {
+    double moveSeconds;     // Drive one cell
+    double turnSeconds;     // Turn 90 degrees, including the IMU settle and corrections
+};
+
+// Get the cost model of the default simulated robot at 10 RPM
+TurnCostModel getDefaultTurnCostModel();
+
+// Minimum-time route search over (cell, heading) states
+//
+// Every state is a cell together with the heading the robot arrived in.
+// Moving on costs moveSeconds, and changing heading on the way costs
+// turnSeconds per 90 degrees, so the search trades extra cells against
+// turns and returns the route with the smallest predicted mission time.
+// A* runs with a heuristic of the remaining cells plus the fewest turns
+// that still have to happen. The result has the same waypoint format as
+// GridSearch.
+class TurnAwareSearch {
+private:
+    const OccupancyGrid& grid;      // Map being searched
+    int allowedMoves;               // MoveSet flags usable by the robot
+    int64_t moveCost;               // Costs in microseconds
+    int64_t turnCost;
+
+    // Per-state search state, valid only where stamp matches searchStamp
+    std::vector<int64_t> gScore;    // Cost from the start
+    std::vector<int> parent;        // Previous state on the route
+    std::vector<uint32_t> stamp;    // Search in which the state was reached
+    uint32_t searchStamp;           // Current search number
+
+    IndexedMinHeap<int64_t> openSet;    // States keyed by f and then h
+    std::vector<GridCell> waypoints;    // Start, turning cells and destination
+
+    long long expansions;           // States popped from the open set
+    int pathLength;                 // Cells on the last route, -1 if none
+    int turnCount;                  // Turns on the last route, including the first
+    double predictedSeconds;        // Predicted time of the last route
+    int goalX;                      // Destination of the current search
+    int goalY;
+
+    // Heuristic cost from (x, y) facing heading to the destination
+    int64_t heuristic(int x, int y, int heading) const;
+
+    // Reach a state with cost g from parentState, opening it if it improved
+    void relax(int state, int x, int y, int heading, int64_t g, int parentState);
+
+    // Rebuild the waypoint list from the parent links
+    void buildWaypoints(int goalState);
+
+public:
+    // Constructor
+    TurnAwareSearch(const OccupancyGrid& map, int allowed_moves = MOVES_ALL,
+                    const TurnCostModel& cost_model = getDefaultTurnCostModel());
+
+    // Set the cost model
+    void setCostModel(const TurnCostModel& cost_model);
+
+    // Set the allowed moves
+    void setAllowedMoves(int allowed_moves);
+
+    // Search for a route from start, facing along (headingDx, headingDy), to destination
+    bool findPath(int startX, int startY, int headingDx, int headingDy, int destX, int destY);
+
+    // Get the waypoints of the last route (start, turning cells, destination)
+    const std::vector<GridCell>& getWaypoints() const;
+
+    // Get the number of waypoints of the last route
+    int getWaypointCount() const;
+
+    // Write the last route into a list as START_LOCATION/TURNING_NODE waypoints
+    bool buildPath(DoublyLinkedList& out) const;
+
+    // Get the number of cells on the last route (-1 if none was found)
+    int getPathLength() const;
+
+    // Get the number of 90 degree turns on the last route
+    int getTurnCount() const;
+
+    // Get the predicted time of the last route in seconds
+    double getPredictedSeconds() const;
+
+    // Get the number of states expanded by the last search
+    long long getExpansions() const;
+};
+
+#endif // TURN_AWARE_SEARCH_H
@@ -0,0 +1,229 @@
+// Checkpoint round trips and recovery from damaged slots.
+//
+// A planner writes checkpoints as it drives, and a second planner restores
+// the newest one and finishes the mission. Then each slot is damaged on
+// disk in turn: a bad record or grid byte, a header whose checksum no
+// longer holds, and a truncated file. readCheckpoint and restoreCheckpoint
+// must fall back to the other slot while it is intact, and report both
+// slots' problems once neither is.
+
+#include "../src/logger.h"
+#include "../src/robot_path_planner.h"
+#include "test_util.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kBasePath = "checkpoint_test_run";
+const int kWidth = 40;
+const int kHeight = 30;
+const int kDestX = 33;
+const int kDestY = 24;
+
+// Read a whole file
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Replace a file with the given bytes
+void writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Flip the bits of one byte of a file
+void flipByte(const std::string& path, size_t offset) {
+    std::vector<char> bytes = readFile(path);
+    bytes[offset] = static_cast<char>(~bytes[offset]);
+    writeFile(path, bytes);
+}
+
+// Cut a file down to its first length bytes
+void truncateFile(const std::string& path, size_t length) {
+    std::vector<char> bytes = readFile(path);
+    bytes.resize(length);
+    writeFile(path, bytes);
+}
+
+// Get the sequence number stored in a slot's header
+uint64_t readSequence(const std::string& path) {
+    std::vector<char> bytes = readFile(path);
+    CheckpointHeader header = {};
+    if (bytes.size() >= sizeof(header)) {
+        std::copy(bytes.begin(), bytes.begin() + sizeof(header), reinterpret_cast<char*>(&header));
+    }
+    return header.sequence;
+}
+
+// Check if an error message contains the given text
+bool mentions(const std::string& error, const std::string& text) {
+    return error.find(text) != std::string::npos;
+}
+
+// Set up the mission every planner of the test shares
+void setUpMission(RobotPathPlanner& planner) {
+    planner.setPlannerMode(GREEDY_PLANNER);
+    for (int i = 8; i < 20; i++) {
+        planner.markObstacle(i, 12);
+        planner.markObstacle(25, i);
+    }
+}
+
+// Check that a restored planner holds exactly the state of a checkpoint
+void checkRestoredState(RobotPathPlanner& planner, const CheckpointData& data) {
+    const PlannerStats& stats = planner.getStats();
+    TEST_CHECK(stats.moves == data.state.moves, "restored %d moves, checkpoint has %d", stats.moves, data.state.moves);
+    TEST_CHECK(stats.turns == data.state.turns, "restored %d turns, checkpoint has %d", stats.turns, data.state.turns);
+    TEST_CHECK(planner.getMapVersion() == data.state.mapVersion, "restored map version %llu, checkpoint has %llu",
+               planner.getMapVersion(), static_cast<unsigned long long>(data.state.mapVersion));
+
+    DoublyLinkedList& path = planner.getPath();
+    TEST_CHECK(path.getSize() == static_cast<int>(data.path.size()), "restored %d path nodes, checkpoint has %d",
+               path.getSize(), static_cast<int>(data.path.size()));
+    size_t index = 0;
+    for (Node* node = path.getHead(); node != nullptr && index < data.path.size(); node = node->next, index++) {
+        const CheckpointNode& saved = data.path[index];
+        TEST_CHECK(node->x == saved.x && node->y == saved.y && node->type == saved.type,
+                   "path node %d is (%d, %d) type %d, checkpoint has (%d, %d) type %d", static_cast<int>(index),
+                   node->x, node->y, node->type, saved.x, saved.y, saved.type);
+    }
+
+    std::vector<uint64_t> words = data.words;
+    OccupancyGrid saved(kWidth, kHeight, words.data());
+    const ObstacleMap& map = planner.getObstacleMap();
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            TEST_CHECK(map.isObstacleDetected(x, y) == saved.isObstacleDetected(x, y),
+                       "restored obstacle at (%d, %d) differs from the checkpoint", x, y);
+        }
+    }
+}
+
+// Restore a fresh planner from the base path and get its move count (-1 if the restore failed)
+int restoreMoves(std::string& error) {
+    RobotPathPlanner planner(0, 0, kDestX, kDestY, kWidth, kHeight);
+    if (!planner.restoreCheckpoint(kBasePath, error)) {
+        TEST_CHECK(planner.getStats().moves == 0, "a failed restore changed the planner");
+        return -1;
+    }
+    return planner.getStats().moves;
+}
+
+// Read the base path and get the checkpoint's move count (-1 if neither slot was usable)
+int readMoves(std::string& error) {
+    CheckpointData data;
+    return readCheckpoint(kBasePath, data, error) ? data.state.moves : -1;
+}
+
+}  // namespace
+
+int main() {
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    std::string slots[2] = {getCheckpointSlotPath(kBasePath, 0), getCheckpointSlotPath(kBasePath, 1)};
+    std::remove(slots[0].c_str());
+    std::remove(slots[1].c_str());
+    std::string error;
+
+    // Nothing written yet
+    TEST_CHECK(readMoves(error) == -1, "read a checkpoint that was never written");
+    TEST_CHECK(mentions(error, std::string("no checkpoint at '") + slots[0] + "'"), "missing slot error: %s",
+               error.c_str());
+
+    // Drive the mission, checkpointing every 7 moves, so both slots hold one
+    RobotPathPlanner original(0, 0, kDestX, kDestY, kWidth, kHeight);
+    setUpMission(original);
+    CheckpointWriter writer(kBasePath, false);
+    original.setCheckpointWriter(&writer, 7);
+    original.initialize();
+    PlanStatus status = original.executePlanningAlgorithm();
+    TEST_CHECK(status == PLAN_SUCCESS, "original mission ended with %s", getPlanStatusName(status));
+    TEST_CHECK(writer.getWriteCount() >= 2, "only %lld checkpoints written", writer.getWriteCount());
+    int newer = (readSequence(slots[1]) > readSequence(slots[0])) ? 1 : 0;
+    int older = 1 - newer;
+    std::vector<char> newerBytes = readFile(slots[newer]);
+    std::vector<char> olderBytes = readFile(slots[older]);
+
+    // Round trip: the newest checkpoint is restored whole and the mission finishes from it
+    CheckpointData newest;
+    TEST_CHECK(readCheckpoint(kBasePath, newest, error), "read failed: %s", error.c_str());
+    TEST_CHECK(newest.header.sequence == writer.getSequence(), "read sequence %llu, last written %llu",
+               static_cast<unsigned long long>(newest.header.sequence),
+               static_cast<unsigned long long>(writer.getSequence()));
+    TEST_CHECK(newest.header.destX == kDestX && newest.header.destY == kDestY, "checkpoint destination (%d, %d)",
+               newest.header.destX, newest.header.destY);
+    RobotPathPlanner restored(0, 0, kDestX, kDestY, kWidth, kHeight);
+    restored.setPlannerMode(GREEDY_PLANNER);
+    TEST_CHECK(restored.restoreCheckpoint(kBasePath, error), "restore failed: %s", error.c_str());
+    checkRestoredState(restored, newest);
+    restored.resume();
+    status = restored.executePlanningAlgorithm();
+    TEST_CHECK(status == PLAN_SUCCESS, "restored mission ended with %s", getPlanStatusName(status));
+    TEST_CHECK(restored.getStats().moves == original.getStats().moves, "restored mission took %d moves, original %d",
+               restored.getStats().moves, original.getStats().moves);
+
+    // The older checkpoint, as restoring from it should yield
+    writeFile(slots[newer], std::vector<char>());
+    CheckpointData previous;
+    TEST_CHECK(readCheckpoint(kBasePath, previous, error), "reading the older slot failed: %s", error.c_str());
+    int newestMoves = newest.state.moves;
+    int previousMoves = previous.state.moves;
+    TEST_CHECK(previousMoves < newestMoves, "older slot has %d moves, newer %d", previousMoves, newestMoves);
+
+    // Damage to either slot, each with the other intact: a state record byte, the
+    // last grid byte, a header field under the checksum, or the file cut short
+    struct Damage {
+        const char* name;
+        size_t offset;          // Byte flipped, or the length kept when truncating
+        bool truncate;
+        const char* problem;    // Error text following the quoted slot path
+    };
+    const Damage damages[] = {
+        {"state record", sizeof(CheckpointHeader) + 4, false, ": state checksum mismatch"},
+        {"grid payload", 0, false, ": grid checksum mismatch"},
+        {"header sequence", offsetof(CheckpointHeader, sequence), false, ": header checksum mismatch"},
+        {"header checksum", offsetof(CheckpointHeader, headerChecksum), false, ": header checksum mismatch"},
+        {"truncated header", 20, true, " is too short for a checkpoint header"},
+        {"truncated payload", sizeof(CheckpointHeader) + 8, true, ": file size does not match the header"},
+    };
+    for (const Damage& damage : damages) {
+        for (int slot = 0; slot < 2; slot++) {
+            writeFile(slots[newer], newerBytes);
+            writeFile(slots[older], olderBytes);
+            size_t offset = (damage.offset == 0) ? readFile(slots[slot]).size() - 1 : damage.offset;
+            if (damage.truncate) {
+                truncateFile(slots[slot], offset);
+            } else {
+                flipByte(slots[slot], offset);
+            }
+            int expected = (slot == newer) ? previousMoves : newestMoves;
+            int moves = readMoves(error);
+            TEST_CHECK(moves == expected, "%s of slot %d: read %d moves, expected %d (%s)", damage.name, slot, moves,
+                       expected, error.c_str());
+            moves = restoreMoves(error);
+            TEST_CHECK(moves == expected, "%s of slot %d: restored %d moves, expected %d (%s)", damage.name, slot,
+                       moves, expected, error.c_str());
+
+            // With the other slot damaged too, both problems are reported
+            flipByte(slots[1 - slot], sizeof(CheckpointHeader) + 4);
+            TEST_CHECK(readMoves(error) == -1, "%s of slot %d: read with both slots damaged", damage.name, slot);
+            std::string expectedProblem = "'" + slots[slot] + "'" + damage.problem;
+            TEST_CHECK(mentions(error, expectedProblem), "%s of slot %d: error '%s' lacks '%s'", damage.name, slot,
+                       error.c_str(), expectedProblem.c_str());
+            TEST_CHECK(mentions(error, "'" + slots[1 - slot] + "': state checksum mismatch") && mentions(error, "; "),
+                       "%s of slot %d: error '%s' lacks the other slot", damage.name, slot, error.c_str());
+            TEST_CHECK(restoreMoves(error) == -1, "%s of slot %d: restored with both slots damaged", damage.name,
+                       slot);
+            TEST_CHECK(mentions(error, expectedProblem), "%s of slot %d: restore error '%s'", damage.name, slot,
+                       error.c_str());
+        }
+    }
+
+    std::remove(slots[0].c_str());
+    std::remove(slots[1].c_str());
+    return testResult("checkpoint_test");
+}
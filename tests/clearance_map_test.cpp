@@ -0,0 +1,58 @@
+// Incremental ClearanceMap updates against a full rebuild.
+//
+// Obstacles are added one at a time, each folded in with
+// notifyObstacleAdded, and after every addition the whole map must match a
+// ClearanceMap built from scratch. Small maps cover many obstacle layouts;
+// large, nearly empty maps give the new obstacle wide and oddly shaped
+// regions to claim, where a spread that only follows improved cells misses
+// some of them.
+
+#include "../src/clearance_map.h"
+#include "test_util.h"
+
+// Compare every cell of an incrementally updated map with a fresh build
+static bool matchesRebuild(const OccupancyGrid& grid, const ClearanceMap& incremental) {
+    ClearanceMap fresh(grid);
+    for (int y = 0; y < grid.getHeight(); y++) {
+        for (int x = 0; x < grid.getWidth(); x++) {
+            if (incremental.getDistanceSquared(x, y) != fresh.getDistanceSquared(x, y)) {
+                TEST_CHECK(false, "%dx%d map, cell (%d, %d): incremental %d, rebuild %d", grid.getWidth(),
+                           grid.getHeight(), x, y, incremental.getDistanceSquared(x, y),
+                           fresh.getDistanceSquared(x, y));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Add obstacles one by one and check the map after each
+static void runCase(TestRandom& random, int width, int height, int obstacles) {
+    OccupancyGrid grid(width, height);
+    ClearanceMap clearance(grid);
+    for (int i = 0; i < obstacles; i++) {
+        int x = random.nextInt(width);
+        int y = random.nextInt(height);
+        grid.markObstacle(x, y);
+        clearance.notifyObstacleAdded(x, y);
+        if (!matchesRebuild(grid, clearance)) {
+            return;
+        }
+    }
+}
+
+int main() {
+    TestRandom random(12);
+
+    // Many small maps with a handful of obstacles
+    for (int i = 0; i < 3000; i++) {
+        runCase(random, random.nextRange(20, 140), random.nextRange(20, 140), random.nextRange(1, 12));
+    }
+
+    // Large maps with sparse obstacles
+    for (int i = 0; i < 6; i++) {
+        runCase(random, random.nextRange(600, 1200), random.nextRange(600, 1200), 16);
+    }
+
+    return testResult("clearance_map_test");
+}
@@ -0,0 +1,144 @@
+// Incremental ConnectivityIndex updates against a full rebuild.
+//
+// Obstacles are added one at a time and folded in with notifyObstacleAdded.
+// After every addition, the labels must split the free cells exactly as a
+// freshly built index does (label numbers may differ). The reported split
+// must match a rise in the number of components. Walls drawn cell by cell
+// cut maps into several components, one closing cell at a time; dense
+// random fills leave many small pockets to be cut off and swallowed.
+
+#include "../src/connectivity_index.h"
+#include "test_util.h"
+#include <unordered_map>
+
+// Count the distinct labels of the free cells
+static int countComponents(const ConnectivityIndex& index, int width, int height) {
+    std::unordered_map<int, int> seen;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int component = index.getComponent(x, y);
+            if (component != -1) {
+                seen[component] = 1;
+            }
+        }
+    }
+    return static_cast<int>(seen.size());
+}
+
+// Check that two indexes group the cells the same way
+static bool matchesRebuild(const OccupancyGrid& grid, const ConnectivityIndex& incremental,
+                           const ConnectivityIndex& fresh) {
+    std::unordered_map<int, int> toFresh;
+    std::unordered_map<int, int> toIncremental;
+    for (int y = 0; y < grid.getHeight(); y++) {
+        for (int x = 0; x < grid.getWidth(); x++) {
+            int a = incremental.getComponent(x, y);
+            int b = fresh.getComponent(x, y);
+            bool same = (a == -1) == (b == -1);
+            if (same && a != -1) {
+                // Each label must map to exactly one label of the other index
+                same = toFresh.emplace(a, b).first->second == b && toIncremental.emplace(b, a).first->second == a;
+            }
+            if (!same) {
+                TEST_CHECK(false, "%dx%d map, cell (%d, %d): incremental label %d, rebuild label %d",
+                           grid.getWidth(), grid.getHeight(), x, y, a, b);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Mark one obstacle, fold it in and compare with a rebuild; returns false on a mismatch
+static bool addObstacle(OccupancyGrid& grid, ConnectivityIndex& index, int x, int y, int& components) {
+    if (grid.isObstacleDetected(x, y)) {
+        return true;
+    }
+    grid.markObstacle(x, y);
+    bool split = index.notifyObstacleAdded(x, y);
+    ConnectivityIndex fresh(grid);
+    int freshComponents = countComponents(fresh, grid.getWidth(), grid.getHeight());
+    TEST_CHECK(split == (freshComponents > components), "%dx%d map, obstacle (%d, %d): split %d, components %d -> %d",
+               grid.getWidth(), grid.getHeight(), x, y, split ? 1 : 0, components, freshComponents);
+    components = freshComponents;
+    return matchesRebuild(grid, index, fresh);
+}
+
+// Scatter random obstacles, filling about fill_percent of the map
+static void runRandomCase(TestRandom& random, int width, int height, int fill_percent) {
+    OccupancyGrid grid(width, height);
+    ConnectivityIndex index(grid);
+    int components = 1;
+    int obstacles = width * height * fill_percent / 100;
+    for (int i = 0; i < obstacles; i++) {
+        if (!addObstacle(grid, index, random.nextInt(width), random.nextInt(height), components)) {
+            return;
+        }
+    }
+}
+
+// Draw full-length inner walls cell by cell; the last cell of each closes off a new component
+static void runWallCase(TestRandom& random, int width, int height, int walls) {
+    OccupancyGrid grid(width, height);
+    ConnectivityIndex index(grid);
+    int components = 1;
+    for (int wall = 0; wall < walls; wall++) {
+        bool vertical = random.nextInt(2) == 0;
+        int line = vertical ? random.nextRange(1, width - 2) : random.nextRange(1, height - 2);
+        int length = vertical ? height : width;
+
+        // Start anywhere along the line and wrap round, so the closing cell varies
+        int start = random.nextInt(length);
+        for (int i = 0; i < length; i++) {
+            int along = (start + i) % length;
+            int x = vertical ? line : along;
+            int y = vertical ? along : line;
+            if (!addObstacle(grid, index, x, y, components)) {
+                return;
+            }
+        }
+    }
+    TEST_CHECK(components >= 2, "%dx%d map with %d walls ends with %d components", width, height, walls, components);
+}
+
+int main() {
+    TestRandom random(20);
+
+    // An index that is not built yet ignores obstacles until its first build
+    OccupancyGrid idleGrid(8, 8);
+    ConnectivityIndex idle(idleGrid, false);
+    idleGrid.markObstacle(3, 3);
+    TEST_CHECK(!idle.notifyObstacleAdded(3, 3), "an unbuilt index reported a split");
+    TEST_CHECK(!idle.isBuilt(), "notifyObstacleAdded built the index");
+
+    // A ring closed cell by cell cuts off its inside exactly once
+    OccupancyGrid ringGrid(9, 9);
+    ConnectivityIndex ring(ringGrid);
+    int ringComponents = 1;
+    for (int i = 2; i <= 6; i++) {
+        addObstacle(ringGrid, ring, i, 2, ringComponents);
+        addObstacle(ringGrid, ring, i, 6, ringComponents);
+        addObstacle(ringGrid, ring, 2, i, ringComponents);
+        addObstacle(ringGrid, ring, 6, i, ringComponents);
+    }
+    TEST_CHECK(ringComponents == 2, "closed ring leaves %d components", ringComponents);
+    TEST_CHECK(!ring.isConnected(4, 4, 0, 0), "the inside of the ring still reaches the corner");
+    TEST_CHECK(ring.isConnected(4, 4, 3, 5), "the inside of the ring is split");
+
+    // Walls that split maps into several components
+    for (int i = 0; i < 300; i++) {
+        runWallCase(random, random.nextRange(4, 40), random.nextRange(4, 40), random.nextRange(1, 5));
+    }
+
+    // Random fills, from sparse to dense enough to leave many small pockets
+    for (int i = 0; i < 300; i++) {
+        runRandomCase(random, random.nextRange(4, 40), random.nextRange(4, 40), random.nextRange(5, 60));
+    }
+
+    // Larger maps with a few walls
+    for (int i = 0; i < 4; i++) {
+        runWallCase(random, random.nextRange(100, 160), random.nextRange(100, 160), 3);
+    }
+
+    return testResult("connectivity_index_test");
+}
@@ -0,0 +1,63 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdint>
+#include <cstdio>
+
+// Failed checks so far; a test's main returns it through testResult()
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+// Record a failed check unless the condition holds (the first few are printed)
+#define TEST_CHECK(condition, ...)                                              \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            if (testFailures()++ < 20) {                                        \
+                std::printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); \
+                std::printf(__VA_ARGS__);                                       \
+                std::printf("\n");                                              \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+// Print the outcome of a test and get its exit code
+inline int testResult(const char* name) {
+    if (testFailures() == 0) {
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+    std::printf("%s: %d checks failed\n", name, testFailures());
+    return 1;
+}
+
+// Small xorshift generator so test inputs are reproducible
+class TestRandom {
+private:
+    uint64_t state;
+
+public:
+    // Constructor
+    explicit TestRandom(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    // Get the next raw 64-bit value
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Get a value in [0, bound)
+    int nextInt(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+
+    // Get a value in [low, high]
+    int nextRange(int low, int high) {
+        return low + nextInt(high - low + 1);
+    }
+};
+
+#endif // TEST_UTIL_H
@@ -0,0 +1,247 @@
+// Batch simulation of many planner scenarios on a work-stealing thread pool.
+//
+// Usage:
+//   batch_runner SCENARIO_FILE [options]
+//   batch_runner --generate COUNT [--seed N] [--size WxH] [--obstacles N]
+//
+// Options:
+//   --mode MODE                     Planner mode: greedy (default), astar, jps, dstar
+//                                   or turns
+//   --threads N                     Worker threads (one per hardware thread by default)
+//   --format csv|json               Result format (csv by default)
+//   --step-limit N                  Moves before a run counts as a timeout
+//                                   (4 * (width + height) by default)
+//   --time-limit S                  Wall seconds before a run counts as a timeout
+//                                   (none by default; not deterministic)
+//   --output FILE                   Write results to FILE instead of stdout
+//   --simulate                      Drive the simulated robot and add the mission time
+//   --rpm N                         Drivetrain velocity when simulating (10 by default)
+//   --timing                        Add per-scenario wall time (not deterministic)
+//   --instrumentation FILE          Write counters and timers of all workers as JSON
+//   --cache N                       Share up to N planned routes between scenarios
+//                                   (astar, jps and turns only)
+//   --turn-seconds S                Predicted time of one turn for the turns planner
+//                                   (moves take 0.53 s; 6 s by default)
+//   --moves ne|all|all8             Drivetrain moves: NORTH and EAST only (default),
+//                                   all four axis directions, or those plus diagonals
+//                                   (diagonals are taken by the greedy planner only)
+//   --sparse                        Keep obstacles in the tiled sparse map instead of
+//                                   a dense grid
+//
+// Planner output is switched off, results are written in scenario order and
+// simulated missions run on a virtual clock, so without --timing the output
+// is identical for any thread count.
+
+#include "../src/batch_simulation.h"
+#include "../src/instrumentation.h"
+#include "../src/logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Print the usage text
+static void printUsage() {
+    std::fprintf(stderr,
+                 "usage: batch_runner SCENARIO_FILE [--mode greedy|astar|jps|dstar|turns] [--threads N]\n"
+                 "                    [--format csv|json] [--step-limit N] [--time-limit S] [--output FILE]\n"
+                 "                    [--simulate] [--rpm N] [--timing] [--instrumentation FILE]\n"
+                 "                    [--cache N] [--turn-seconds S] [--moves ne|all|all8]\n"
+                 "                    [--sparse]\n"
+                 "       batch_runner --generate COUNT [--seed N] [--size WxH] [--obstacles N]\n");
+}
+
+// Parse a planner mode name; returns false if unknown
+static bool parsePlannerMode(const std::string& name, PlannerMode& mode) {
+    if (name == "greedy") {
+        mode = GREEDY_PLANNER;
+    } else if (name == "astar") {
+        mode = ASTAR_PLANNER;
+    } else if (name == "jps") {
+        mode = JUMP_POINT_PLANNER;
+    } else if (name == "dstar") {
+        mode = INCREMENTAL_PLANNER;
+    } else if (name == "turns") {
+        mode = TURN_AWARE_PLANNER;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Parse a drivetrain move set name; returns false if unknown
+static bool parseMoveSet(const std::string& name, int& moves) {
+    if (name == "ne") {
+        moves = MOVES_NORTH_EAST;
+    } else if (name == "all") {
+        moves = MOVES_ALL;
+    } else if (name == "all8") {
+        moves = MOVES_ALL_DIAGONAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string scenarioFile;
+    std::string outputFile;
+    std::string instrumentationFile;
+    std::string format = "csv";
+    BatchOptions options = getDefaultBatchOptions();
+    int threads = 0;
+    bool timing = false;
+    int generateCount = -1;
+    unsigned long long seed = 1;
+    int width = 20;
+    int height = 20;
+    int obstacleCount = 8;
+    int cacheEntries = 0;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--mode" && hasValue) {
+            if (!parsePlannerMode(argv[++i], options.mode)) {
+                std::fprintf(stderr, "unknown mode '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else if (arg == "--step-limit" && hasValue) {
+            options.stepLimit = std::atoi(argv[++i]);
+        } else if (arg == "--time-limit" && hasValue) {
+            options.timeLimit = std::atof(argv[++i]);
+        } else if (arg == "--output" && hasValue) {
+            outputFile = argv[++i];
+        } else if (arg == "--simulate") {
+            options.simulate = true;
+        } else if (arg == "--rpm" && hasValue) {
+            options.driveRpm = std::atof(argv[++i]);
+        } else if (arg == "--timing") {
+            timing = true;
+        } else if (arg == "--instrumentation" && hasValue) {
+            instrumentationFile = argv[++i];
+        } else if (arg == "--turn-seconds" && hasValue) {
+            options.turnCost.turnSeconds = std::atof(argv[++i]);
+        } else if (arg == "--moves" && hasValue) {
+            if (!parseMoveSet(argv[++i], options.allowedMoves)) {
+                std::fprintf(stderr, "unknown move set '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--sparse") {
+            options.mapBackend = MAP_SPARSE;
+        } else if (arg == "--cache" && hasValue) {
+            cacheEntries = std::atoi(argv[++i]);
+        } else if (arg == "--generate" && hasValue) {
+            generateCount = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                std::fprintf(stderr, "bad size '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--obstacles" && hasValue) {
+            obstacleCount = std::atoi(argv[++i]);
+        } else if (arg[0] != '-' && scenarioFile.empty()) {
+            scenarioFile = arg;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Scenario generation mode
+    if (generateCount >= 0) {
+        if (width < 2 || height < 2) {
+            std::fprintf(stderr, "map size must be at least 2x2\n");
+            return 1;
+        }
+        writeScenarios(std::cout, generateScenarios(generateCount, seed, width, height, obstacleCount));
+        return 0;
+    }
+
+    if (scenarioFile.empty() || (format != "csv" && format != "json")) {
+        printUsage();
+        return 1;
+    }
+
+    // Load the scenarios
+    std::ifstream in(scenarioFile);
+    if (!in) {
+        std::fprintf(stderr, "cannot open '%s'\n", scenarioFile.c_str());
+        return 1;
+    }
+    std::vector<Scenario> scenarios;
+    std::string error;
+    if (!parseScenarios(in, scenarios, error)) {
+        std::fprintf(stderr, "%s: %s\n", scenarioFile.c_str(), error.c_str());
+        return 1;
+    }
+
+    // Per-instance printing would serialize the workers on the log ring
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+    // Cached routes are identical to planned ones, so the results do not change
+    std::unique_ptr<PathCache> cache;
+    if (cacheEntries > 0) {
+        cache.reset(new PathCache(cacheEntries));
+        options.pathCache = cache.get();
+    }
+
+    // Run the batch
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ThreadPool pool(threads);
+    std::vector<ScenarioResult> results = runScenarios(scenarios, options, pool);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Write the results
+    std::ofstream file;
+    if (!outputFile.empty()) {
+        file.open(outputFile);
+        if (!file) {
+            std::fprintf(stderr, "cannot write '%s'\n", outputFile.c_str());
+            return 1;
+        }
+    }
+    std::ostream& out = outputFile.empty() ? std::cout : file;
+    if (format == "json") {
+        writeResultsJson(out, results, options.simulate, timing);
+    } else {
+        writeResultsCsv(out, results, options.simulate, timing);
+    }
+
+    // Counters of every worker thread (wall times, so not deterministic)
+    if (!instrumentationFile.empty()) {
+        std::ofstream instrumentation(instrumentationFile);
+        if (!instrumentation) {
+            std::fprintf(stderr, "cannot write '%s'\n", instrumentationFile.c_str());
+            return 1;
+        }
+        writeInstrumentationJson(instrumentation, Instrumentation::getSnapshot());
+    }
+
+    // The summary goes to stderr so it never mixes with the results
+    BatchSummary summary = summarizeResults(results);
+    std::fprintf(stderr, "%d scenarios: %d success, %d timeout, %d failed (%d threads, %.3f s)\n",
+                 summary.scenarios, summary.succeeded, summary.timedOut, summary.failed,
+                 pool.getThreadCount(), seconds);
+    if (options.simulate) {
+        std::fprintf(stderr, "simulated mission time: %.1f s in total\n", summary.missionSeconds);
+    }
+    if (cache) {
+        PathCacheStats stats = cache->getStats();
+        std::fprintf(stderr, "path cache: %lld hits, %lld misses, %lld evictions, %d of %d entries\n",
+                     stats.hits, stats.misses, stats.evictions, stats.entries, stats.capacity);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Conversion between ASCII-art maps and the binary map file format.
+//
+// Usage:
+//   map_convert text2bin INPUT.txt OUTPUT.map
+//   map_convert bin2text INPUT.map OUTPUT.txt
+//   map_convert info INPUT.map
+//   map_convert generate WIDTH HEIGHT PERCENT SEED OUTPUT.map
+//
+// ASCII maps use one line per row, northmost row first: '#' or 'X' is an
+// obstacle, 'S' the start, 'D' the destination and anything else free.
+// generate scatters PERCENT% random obstacles and keeps the start (0, 0)
+// and the destination (WIDTH-1, HEIGHT-1) free.
+
+#include "../src/map_file.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Print the usage text
+static void printUsage() {
+    std::fprintf(stderr,
+                 "usage: map_convert text2bin INPUT.txt OUTPUT.map\n"
+                 "       map_convert bin2text INPUT.map OUTPUT.txt\n"
+                 "       map_convert info INPUT.map\n"
+                 "       map_convert generate WIDTH HEIGHT PERCENT SEED OUTPUT.map\n");
+}
+
+// Convert an ASCII-art map to a binary map file
+static int textToBinary(const char* input, const char* output) {
+    std::ifstream in(input);
+    if (!in) {
+        std::fprintf(stderr, "cannot open '%s'\n", input);
+        return 1;
+    }
+
+    std::unique_ptr<OccupancyGrid> grid;
+    GridCell start;
+    GridCell dest;
+    std::string error;
+    if (!readAsciiMap(in, grid, start, dest, error) || !writeMapFile(output, *grid, start, dest, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+// Convert a binary map file to an ASCII-art map
+static int binaryToText(const char* input, const char* output) {
+    MappedMapFile file;
+    std::string error;
+    if (!file.open(input, error, true)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::ofstream out(output);
+    if (!out) {
+        std::fprintf(stderr, "cannot create '%s'\n", output);
+        return 1;
+    }
+
+    const MapFileHeader& header = file.getHeader();
+    OccupancyGrid grid(header.width, header.height, file.getWords());
+    writeAsciiMap(out, grid, GridCell{header.startX, header.startY}, GridCell{header.destX, header.destY});
+    return out ? 0 : 1;
+}
+
+// Print the header of a binary map file
+static int printInfo(const char* input) {
+    MappedMapFile file;
+    std::string error;
+    if (!file.open(input, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    const MapFileHeader& header = file.getHeader();
+    OccupancyGrid grid(header.width, header.height, file.getWords());
+    std::printf("version      %u\n", header.version);
+    std::printf("size         %d x %d\n", header.width, header.height);
+    std::printf("start        (%d, %d)\n", header.startX, header.startY);
+    std::printf("destination  (%d, %d)\n", header.destX, header.destY);
+    std::printf("payload      %llu bytes\n", static_cast<unsigned long long>(header.payloadBytes));
+    std::printf("obstacles    %lld\n", grid.countObstacles());
+    std::printf("checksum     %016llx (%s)\n", static_cast<unsigned long long>(header.checksum),
+                file.verifyChecksum() ? "ok" : "MISMATCH");
+    return file.verifyChecksum() ? 0 : 1;
+}
+
+// Write a random field as a binary map file
+static int generateMap(int width, int height, int percent, unsigned long long seed, const char* output) {
+    if (width <= 0 || height <= 0 || percent < 0 || percent > 100) {
+        std::fprintf(stderr, "bad size or obstacle percentage\n");
+        return 1;
+    }
+
+    // splitmix64, so a seed always gives the same field
+    uint64_t state = seed;
+    OccupancyGrid grid(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            if (static_cast<int>(z % 100) < percent) {
+                grid.markObstacle(x, y);
+            }
+        }
+    }
+
+    GridCell start = {0, 0};
+    GridCell dest = {width - 1, height - 1};
+    grid.clearObstacle(start.x, start.y);
+    grid.clearObstacle(dest.x, dest.y);
+
+    std::string error;
+    if (!writeMapFile(output, grid, start, dest, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string command = (argc > 1) ? argv[1] : "";
+    if (command == "text2bin" && argc == 4) {
+        return textToBinary(argv[2], argv[3]);
+    } else if (command == "bin2text" && argc == 4) {
+        return binaryToText(argv[2], argv[3]);
+    } else if (command == "info" && argc == 3) {
+        return printInfo(argv[2]);
+    } else if (command == "generate" && argc == 7) {
+        return generateMap(std::atoi(argv[2]), std::atoi(argv[3]), std::atoi(argv[4]),
+                           std::strtoull(argv[5], nullptr, 10), argv[6]);
+    }
+
+    printUsage();
+    return 1;
+}